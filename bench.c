@@ -0,0 +1,649 @@
+/*
+ * Benchmarks of the forkciphers and the ForkAE modes.
+ *
+ *   bench.x [-o csv|json] [-n samples] [-w warmup] [-t ms] [-g GHz] [-m match]
+ *
+ * Every case is one call of a library function: a key schedule
+ * computation, a batch of blocks through the scalar or the parallel
+ * kernel (both legs, one leg, or for decryption the inverse with or
+ * without the left leg), or one message through a mode. The number of
+ * calls per sample is doubled until a sample takes at least the sample
+ * time (default 5 ms); then warm-up samples are discarded and the median
+ * of the remaining samples is reported, as time and cycles per call,
+ * per block and per byte.
+ *
+ * Cycles are read from the time stamp counter on x86, which counts at a
+ * fixed reference frequency; with -g they are derived from the time at
+ * the given core frequency instead (e.g. with frequency scaling disabled).
+ * Without either the cycle columns are empty.
+ *
+ * -m keeps only the cases whose variant or operation contains the given
+ * string. Results are written to stdout, one row or object per case.
+ */
+
+#define _GNU_SOURCE
+#include "forkskinny64-parallel.h"
+#include "forkskinny128-parallel.h"
+#include "forkae-paef.h"
+#include "forkae-saef.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#define BENCH_MAX_BLOCKS 1024
+#define BENCH_MAX_MESSAGE 65536
+
+#define BENCH_DEFAULT_SAMPLES 11
+#define BENCH_DEFAULT_WARMUP 2
+#define BENCH_DEFAULT_TIME 5
+#define BENCH_MAX_SAMPLES 1001
+
+static const size_t bench_batches[] = {1, 4, 16, 64, 256, BENCH_MAX_BLOCKS};
+static const size_t bench_messages[] = {16, 64, 256, 1024, 4096, 16384, BENCH_MAX_MESSAGE};
+
+#if defined(__x86_64__) || defined(__i386__)
+#define BENCH_HAVE_TSC 1
+static uint64_t bench_tsc(void)
+{
+    uint32_t lo, hi;
+    __asm__ __volatile__ ("rdtsc" : "=a" (lo), "=d" (hi));
+    return ((uint64_t)hi << 32) | lo;
+}
+#else
+#define BENCH_HAVE_TSC 0
+static uint64_t bench_tsc(void)
+{
+    return 0;
+}
+#endif
+
+/* Keys and buffers shared by all cases */
+static ForkSkinny64Key_t bench_tks1_64;
+static ForkSkinny64Key_t bench_tks2_64;
+static ForkSkinny128Key_t bench_ks1_128;
+static ForkSkinny128Key_t bench_ks2_128_256;
+static ForkSkinny128Key_t bench_ks2_128_384;
+static ForkSkinny128Key_t bench_ks3_128_384;
+static ForkAE64192Key_t bench_key_64_192;
+static ForkAE128256Key_t bench_key_128_256;
+static ForkAE128384Key_t bench_key_128_384;
+static uint8_t bench_k[FORKAE_128_384_KEY_SIZE];
+static uint8_t bench_nonce[16];
+static uint8_t *bench_tk1;
+static uint8_t *bench_input;
+static uint8_t *bench_left;
+static uint8_t *bench_right;
+static uint8_t *bench_message;
+static uint8_t *bench_ciphertext[4];
+
+/* Entry points of a forkcipher, bound to the keys above */
+typedef struct
+{
+    const char *name;
+    size_t block_size;
+    void (*encrypt)(uint8_t *left, uint8_t *right, const uint8_t *input);
+    void (*decrypt)(uint8_t *left, uint8_t *right, const uint8_t *input);
+    void (*encrypt_parallel)(uint8_t *left, uint8_t *right, const uint8_t *input, size_t count);
+    void (*decrypt_parallel)(uint8_t *left, uint8_t *right, const uint8_t *input, size_t count);
+
+} BenchCipher_t;
+
+static void bench_encrypt_64_192(uint8_t *left, uint8_t *right, const uint8_t *input)
+{
+    forkskinny_c_64_192_encrypt(&bench_tks1_64, &bench_tks2_64, left, right, input);
+}
+
+static void bench_decrypt_64_192(uint8_t *left, uint8_t *right, const uint8_t *input)
+{
+    forkskinny_c_64_192_decrypt(&bench_tks1_64, &bench_tks2_64, left, right, input);
+}
+
+static void bench_encrypt_parallel_64_192(uint8_t *left, uint8_t *right, const uint8_t *input, size_t count)
+{
+    forkskinny_c_64_192_encrypt_parallel(bench_tk1, &bench_tks2_64, left, right, input, count);
+}
+
+static void bench_decrypt_parallel_64_192(uint8_t *left, uint8_t *right, const uint8_t *input, size_t count)
+{
+    forkskinny_c_64_192_decrypt_parallel(bench_tk1, &bench_tks2_64, left, right, input, count);
+}
+
+static void bench_encrypt_128_256(uint8_t *left, uint8_t *right, const uint8_t *input)
+{
+    forkskinny_c_128_256_encrypt(&bench_ks1_128, &bench_ks2_128_256, left, right, input);
+}
+
+static void bench_decrypt_128_256(uint8_t *left, uint8_t *right, const uint8_t *input)
+{
+    forkskinny_c_128_256_decrypt(&bench_ks1_128, &bench_ks2_128_256, left, right, input);
+}
+
+static void bench_encrypt_parallel_128_256(uint8_t *left, uint8_t *right, const uint8_t *input, size_t count)
+{
+    forkskinny_c_128_256_encrypt_parallel(bench_tk1, &bench_ks2_128_256, left, right, input, count);
+}
+
+static void bench_decrypt_parallel_128_256(uint8_t *left, uint8_t *right, const uint8_t *input, size_t count)
+{
+    forkskinny_c_128_256_decrypt_parallel(bench_tk1, &bench_ks2_128_256, left, right, input, count);
+}
+
+static void bench_encrypt_128_384(uint8_t *left, uint8_t *right, const uint8_t *input)
+{
+    forkskinny_c_128_384_encrypt(&bench_ks1_128, &bench_ks2_128_384, &bench_ks3_128_384, left, right, input);
+}
+
+static void bench_decrypt_128_384(uint8_t *left, uint8_t *right, const uint8_t *input)
+{
+    forkskinny_c_128_384_decrypt(&bench_ks1_128, &bench_ks2_128_384, &bench_ks3_128_384, left, right, input);
+}
+
+static void bench_encrypt_parallel_128_384(uint8_t *left, uint8_t *right, const uint8_t *input, size_t count)
+{
+    forkskinny_c_128_384_encrypt_parallel(bench_tk1, &bench_ks2_128_384, &bench_ks3_128_384, left, right, input, count);
+}
+
+static void bench_decrypt_parallel_128_384(uint8_t *left, uint8_t *right, const uint8_t *input, size_t count)
+{
+    forkskinny_c_128_384_decrypt_parallel(bench_tk1, &bench_ks2_128_384, &bench_ks3_128_384, left, right, input, count);
+}
+
+static const BenchCipher_t bench_ciphers[] = {
+    {"forkskinny-64-192", FORKSKINNY64_BLOCK_SIZE,
+     bench_encrypt_64_192, bench_decrypt_64_192,
+     bench_encrypt_parallel_64_192, bench_decrypt_parallel_64_192},
+    {"forkskinny-128-256", FORKSKINNY128_BLOCK_SIZE,
+     bench_encrypt_128_256, bench_decrypt_128_256,
+     bench_encrypt_parallel_128_256, bench_decrypt_parallel_128_256},
+    {"forkskinny-128-384", FORKSKINNY128_BLOCK_SIZE,
+     bench_encrypt_128_384, bench_decrypt_128_384,
+     bench_encrypt_parallel_128_384, bench_decrypt_parallel_128_384},
+};
+
+/* Key schedule computations, each for all rounds of the variant */
+typedef struct
+{
+    const char *variant;
+    const char *operation;
+    void (*init)(void);
+
+} BenchInit_t;
+
+static void bench_init_tk1_64_192(void)
+{
+    forkskinny_c_64_192_init_tk1(&bench_tks1_64, bench_nonce, FORKSKINNY64_MAX_ROUNDS);
+}
+
+static void bench_init_tk2_tk3_64_192(void)
+{
+    forkskinny_c_64_192_init_tk2_tk3(&bench_tks2_64, bench_k, FORKSKINNY64_MAX_ROUNDS);
+}
+
+static void bench_init_tk1_128_256(void)
+{
+    forkskinny_c_128_256_init_tk1(&bench_ks1_128, bench_nonce,
+        FORKSKINNY_128_256_ROUNDS_BEFORE + 2 * FORKSKINNY_128_256_ROUNDS_AFTER);
+}
+
+static void bench_init_tk2_128_256(void)
+{
+    forkskinny_c_128_256_init_tk2(&bench_ks2_128_256, bench_k,
+        FORKSKINNY_128_256_ROUNDS_BEFORE + 2 * FORKSKINNY_128_256_ROUNDS_AFTER);
+}
+
+static void bench_init_tk1_128_384(void)
+{
+    forkskinny_c_128_384_init_tk1(&bench_ks1_128, bench_nonce, FORKSKINNY128_MAX_ROUNDS);
+}
+
+static void bench_init_tk2_128_384(void)
+{
+    forkskinny_c_128_384_init_tk2(&bench_ks2_128_384, bench_k, FORKSKINNY128_MAX_ROUNDS);
+}
+
+static void bench_init_tk3_128_384(void)
+{
+    forkskinny_c_128_384_init_tk3(&bench_ks3_128_384, bench_k + 16, FORKSKINNY128_MAX_ROUNDS);
+}
+
+static const BenchInit_t bench_inits[] = {
+    {"forkskinny-64-192", "init-tk1", bench_init_tk1_64_192},
+    {"forkskinny-64-192", "init-tk2-tk3", bench_init_tk2_tk3_64_192},
+    {"forkskinny-128-256", "init-tk1", bench_init_tk1_128_256},
+    {"forkskinny-128-256", "init-tk2", bench_init_tk2_128_256},
+    {"forkskinny-128-384", "init-tk1", bench_init_tk1_128_384},
+    {"forkskinny-128-384", "init-tk2", bench_init_tk2_128_384},
+    {"forkskinny-128-384", "init-tk3", bench_init_tk3_128_384},
+};
+
+/* Encryption and decryption of one message with a mode; the message and
+   its ciphertext (in bench_ciphertext[index]) are prepared beforehand */
+typedef struct
+{
+    const char *variant;
+    size_t block_size;
+    size_t max_message;
+    void (*encrypt)(uint8_t *c, const uint8_t *m, size_t mlen);
+    int (*decrypt)(uint8_t *m, const uint8_t *c, size_t clen);
+
+} BenchMode_t;
+
+static void bench_paef_64_192_encrypt(uint8_t *c, const uint8_t *m, size_t mlen)
+{
+    size_t clen;
+    forkae_c_paef_64_192_encrypt(&bench_key_64_192, c, &clen, m, mlen, 0, 0, bench_nonce);
+}
+
+static int bench_paef_64_192_decrypt(uint8_t *m, const uint8_t *c, size_t clen)
+{
+    size_t mlen;
+    return forkae_c_paef_64_192_decrypt(&bench_key_64_192, m, &mlen, c, clen, 0, 0, bench_nonce);
+}
+
+static void bench_paef_128_384_encrypt(uint8_t *c, const uint8_t *m, size_t mlen)
+{
+    size_t clen;
+    forkae_c_paef_128_384_encrypt(&bench_key_128_384, c, &clen, m, mlen, 0, 0, bench_nonce);
+}
+
+static int bench_paef_128_384_decrypt(uint8_t *m, const uint8_t *c, size_t clen)
+{
+    size_t mlen;
+    return forkae_c_paef_128_384_decrypt(&bench_key_128_384, m, &mlen, c, clen, 0, 0, bench_nonce);
+}
+
+static void bench_saef_128_256_encrypt(uint8_t *c, const uint8_t *m, size_t mlen)
+{
+    size_t clen;
+    forkae_c_saef_128_256_encrypt(&bench_key_128_256, c, &clen, m, mlen, 0, 0, bench_nonce);
+}
+
+static int bench_saef_128_256_decrypt(uint8_t *m, const uint8_t *c, size_t clen)
+{
+    size_t mlen;
+    return forkae_c_saef_128_256_decrypt(&bench_key_128_256, m, &mlen, c, clen, 0, 0, bench_nonce);
+}
+
+static void bench_saef_128_384_encrypt(uint8_t *c, const uint8_t *m, size_t mlen)
+{
+    size_t clen;
+    forkae_c_saef_128_384_encrypt(&bench_key_128_384, c, &clen, m, mlen, 0, 0, bench_nonce);
+}
+
+static int bench_saef_128_384_decrypt(uint8_t *m, const uint8_t *c, size_t clen)
+{
+    size_t mlen;
+    return forkae_c_saef_128_384_decrypt(&bench_key_128_384, m, &mlen, c, clen, 0, 0, bench_nonce);
+}
+
+static const BenchMode_t bench_modes[] = {
+    {"paef-forkskinny-64-192", FORKSKINNY64_BLOCK_SIZE,
+     FORKAE_PAEF_64_192_MAX_BLOCKS * FORKSKINNY64_BLOCK_SIZE,
+     bench_paef_64_192_encrypt, bench_paef_64_192_decrypt},
+    {"paef-forkskinny-128-384", FORKSKINNY128_BLOCK_SIZE, BENCH_MAX_MESSAGE,
+     bench_paef_128_384_encrypt, bench_paef_128_384_decrypt},
+    {"saef-forkskinny-128-256", FORKSKINNY128_BLOCK_SIZE, BENCH_MAX_MESSAGE,
+     bench_saef_128_256_encrypt, bench_saef_128_256_decrypt},
+    {"saef-forkskinny-128-384", FORKSKINNY128_BLOCK_SIZE, BENCH_MAX_MESSAGE,
+     bench_saef_128_384_encrypt, bench_saef_128_384_decrypt},
+};
+
+#define BENCH_KIND_INIT     0
+#define BENCH_KIND_SCALAR   1
+#define BENCH_KIND_PARALLEL 2
+#define BENCH_KIND_MODE     3
+
+/* One case: what is called, and the work done by one call */
+typedef struct
+{
+    int kind;
+    const char *variant;
+    const char *operation;
+    const char *legs;
+    const char *kernel;
+    size_t blocks;
+    size_t bytes;
+    const BenchCipher_t *cipher;
+    const BenchInit_t *init;
+    const BenchMode_t *mode;
+    int decrypt;
+    int left;
+    int right;
+    unsigned index;
+
+} BenchCase_t;
+
+typedef struct
+{
+    int json;
+    unsigned samples;
+    unsigned warmup;
+    double sample_time;
+    double ghz;
+    const char *match;
+    unsigned rows;
+
+} BenchOptions_t;
+
+static void bench_run(const BenchCase_t *bc, uint64_t iterations)
+{
+    uint8_t *left = bc->left ? bench_left : 0;
+    uint8_t *right = bc->right ? bench_right : 0;
+    uint64_t posn;
+
+    switch (bc->kind) {
+    case BENCH_KIND_INIT:
+        for (posn = 0; posn < iterations; ++posn)
+            bc->init->init();
+        break;
+    case BENCH_KIND_SCALAR:
+        for (posn = 0; posn < iterations; ++posn) {
+            if (bc->decrypt)
+                bc->cipher->decrypt(left, right, bench_input);
+            else
+                bc->cipher->encrypt(left, right, bench_input);
+        }
+        break;
+    case BENCH_KIND_PARALLEL:
+        for (posn = 0; posn < iterations; ++posn) {
+            if (bc->decrypt)
+                bc->cipher->decrypt_parallel(left, right, bench_input, bc->blocks);
+            else
+                bc->cipher->encrypt_parallel(left, right, bench_input, bc->blocks);
+        }
+        break;
+    default:
+        for (posn = 0; posn < iterations; ++posn) {
+            if (bc->decrypt)
+                bc->mode->decrypt(bench_left, bench_ciphertext[bc->index],
+                                  bc->bytes + bc->mode->block_size);
+            else
+                bc->mode->encrypt(bench_left, bench_message, bc->bytes);
+        }
+        break;
+    }
+}
+
+static double bench_now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static int bench_compare(const void *a, const void *b)
+{
+    double x = *(const double *)a;
+    double y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+static double bench_median(double *values, unsigned count)
+{
+    qsort(values, count, sizeof(double), bench_compare);
+    if (count & 1)
+        return values[count / 2];
+    return (values[count / 2 - 1] + values[count / 2]) / 2;
+}
+
+/* Prints a value, or an empty field or null if it is not available */
+static void bench_value(const BenchOptions_t *options, const char *name, double value, int available)
+{
+    if (options->json) {
+        if (available)
+            printf(", \"%s\": %.4f", name, value);
+        else
+            printf(", \"%s\": null", name);
+    } else {
+        if (available)
+            printf(",%.4f", value);
+        else
+            printf(",");
+    }
+}
+
+static void bench_measure(const BenchCase_t *bc, BenchOptions_t *options)
+{
+    static double times[BENCH_MAX_SAMPLES];
+    static double cycles[BENCH_MAX_SAMPLES];
+    uint64_t iterations = 1;
+    uint64_t tsc;
+    unsigned sample;
+    double start, elapsed, ns, cycles_per_call;
+    int have_cycles = BENCH_HAVE_TSC || options->ghz > 0;
+
+    if (options->match && !strstr(bc->variant, options->match) &&
+            !strstr(bc->operation, options->match))
+        return;
+
+    /* Calibrate the number of calls per sample; this also warms up */
+    for (;;) {
+        start = bench_now();
+        bench_run(bc, iterations);
+        elapsed = bench_now() - start;
+        if (elapsed >= options->sample_time || iterations >= ((uint64_t)1 << 40))
+            break;
+        iterations *= 2;
+    }
+
+    for (sample = 0; sample < options->warmup + options->samples; ++sample) {
+        tsc = bench_tsc();
+        start = bench_now();
+        bench_run(bc, iterations);
+        elapsed = bench_now() - start;
+        tsc = bench_tsc() - tsc;
+        if (sample < options->warmup)
+            continue;
+        times[sample - options->warmup] = elapsed * 1e9 / (double)iterations;
+        cycles[sample - options->warmup] = (double)tsc / (double)iterations;
+    }
+    ns = bench_median(times, options->samples);
+    if (options->ghz > 0)
+        cycles_per_call = ns * options->ghz;
+    else
+        cycles_per_call = bench_median(cycles, options->samples);
+
+    if (options->json) {
+        printf("%s  {\"variant\": \"%s\", \"operation\": \"%s\", "
+               "\"legs\": \"%s\", \"kernel\": \"%s\", \"blocks\": %lu, "
+               "\"bytes\": %lu, \"samples\": %u, \"iterations\": %llu",
+               options->rows ? ",\n" : "", bc->variant, bc->operation,
+               bc->legs, bc->kernel, (unsigned long)bc->blocks,
+               (unsigned long)bc->bytes, options->samples,
+               (unsigned long long)iterations);
+    } else {
+        printf("%s,%s,%s,%s,%lu,%lu,%u,%llu", bc->variant, bc->operation,
+               bc->legs, bc->kernel, (unsigned long)bc->blocks,
+               (unsigned long)bc->bytes, options->samples,
+               (unsigned long long)iterations);
+    }
+    bench_value(options, "ns_per_call", ns, 1);
+    bench_value(options, "cycles_per_call", cycles_per_call, have_cycles);
+    bench_value(options, "ns_per_block", ns / (double)bc->blocks, bc->blocks != 0);
+    bench_value(options, "cycles_per_byte", cycles_per_call / (double)bc->bytes,
+                have_cycles && bc->bytes != 0);
+    printf(options->json ? "}" : "\n");
+    fflush(stdout);
+    ++(options->rows);
+}
+
+/* Leg selections of the kernels: name, left leg, right leg */
+static const struct
+{
+    int decrypt;
+    const char *legs;
+    int left;
+    int right;
+}
+bench_legs[] = {
+    {0, "both", 1, 1},
+    {0, "left", 1, 0},
+    {0, "right", 0, 1},
+    {1, "both", 1, 1},
+    {1, "inverse", 0, 1},
+    {1, "left", 1, 0},
+};
+
+static uint8_t *bench_alloc(size_t len)
+{
+    uint8_t *data = (uint8_t *)malloc(len);
+    size_t posn;
+    if (!data) {
+        fprintf(stderr, "bench: out of memory\n");
+        exit(1);
+    }
+    for (posn = 0; posn < len; ++posn)
+        data[posn] = (uint8_t)(posn * 17 + 3);
+    return data;
+}
+
+static void bench_setup(void)
+{
+    unsigned posn;
+
+    for (posn = 0; posn < sizeof(bench_k); ++posn)
+        bench_k[posn] = (uint8_t)(posn * 29 + 1);
+    for (posn = 0; posn < sizeof(bench_nonce); ++posn)
+        bench_nonce[posn] = (uint8_t)(posn * 13 + 7);
+    for (posn = 0; posn < sizeof(bench_inits) / sizeof(bench_inits[0]); ++posn)
+        bench_inits[posn].init();
+    forkae_c_64_192_init_key(&bench_key_64_192, bench_k);
+    forkae_c_128_256_init_key(&bench_key_128_256, bench_k);
+    forkae_c_128_384_init_key(&bench_key_128_384, bench_k);
+
+    bench_tk1 = bench_alloc(BENCH_MAX_BLOCKS * FORKSKINNY128_BLOCK_SIZE);
+    bench_input = bench_alloc(BENCH_MAX_BLOCKS * FORKSKINNY128_BLOCK_SIZE);
+    bench_left = bench_alloc(BENCH_MAX_MESSAGE + FORKSKINNY128_BLOCK_SIZE);
+    bench_right = bench_alloc(BENCH_MAX_BLOCKS * FORKSKINNY128_BLOCK_SIZE);
+    bench_message = bench_alloc(BENCH_MAX_MESSAGE);
+    for (posn = 0; posn < sizeof(bench_modes) / sizeof(bench_modes[0]); ++posn)
+        bench_ciphertext[posn] = bench_alloc(BENCH_MAX_MESSAGE + FORKSKINNY128_BLOCK_SIZE);
+}
+
+static void bench_usage(void)
+{
+    fprintf(stderr, "usage: bench.x [-o csv|json] [-n samples] [-w warmup] "
+                    "[-t ms] [-g GHz] [-m match]\n");
+    exit(2);
+}
+
+int main(int argc, char *argv[])
+{
+    BenchOptions_t options;
+    BenchCase_t bc;
+    unsigned cipher, legs, batch, init, mode, message;
+    int opt;
+
+    options.json = 0;
+    options.samples = BENCH_DEFAULT_SAMPLES;
+    options.warmup = BENCH_DEFAULT_WARMUP;
+    options.sample_time = BENCH_DEFAULT_TIME * 1e-3;
+    options.ghz = 0;
+    options.match = 0;
+    options.rows = 0;
+    while ((opt = getopt(argc, argv, "o:n:w:t:g:m:")) != -1) {
+        switch (opt) {
+        case 'o':
+            if (strcmp(optarg, "json") == 0)
+                options.json = 1;
+            else if (strcmp(optarg, "csv") != 0)
+                bench_usage();
+            break;
+        case 'n': options.samples = (unsigned)atoi(optarg); break;
+        case 'w': options.warmup = (unsigned)atoi(optarg); break;
+        case 't': options.sample_time = atof(optarg) * 1e-3; break;
+        case 'g': options.ghz = atof(optarg); break;
+        case 'm': options.match = optarg; break;
+        default: bench_usage();
+        }
+    }
+    if (optind != argc || options.samples < 1 ||
+            options.warmup + options.samples > BENCH_MAX_SAMPLES ||
+            options.sample_time <= 0 || options.ghz < 0)
+        bench_usage();
+
+    bench_setup();
+    if (options.json)
+        printf("[\n");
+    else
+        printf("variant,operation,legs,kernel,blocks,bytes,samples,"
+               "iterations,ns_per_call,cycles_per_call,ns_per_block,"
+               "cycles_per_byte\n");
+
+    /* Key schedules */
+    memset(&bc, 0, sizeof(bc));
+    bc.kind = BENCH_KIND_INIT;
+    bc.legs = "-";
+    bc.kernel = "scalar";
+    for (init = 0; init < sizeof(bench_inits) / sizeof(bench_inits[0]); ++init) {
+        bc.variant = bench_inits[init].variant;
+        bc.operation = bench_inits[init].operation;
+        bc.init = &bench_inits[init];
+        bench_measure(&bc, &options);
+    }
+
+    /* Forkciphers: one block with a pre-computed TK1 schedule, and
+       batches through the parallel kernels */
+    for (cipher = 0; cipher < sizeof(bench_ciphers) / sizeof(bench_ciphers[0]); ++cipher) {
+        for (legs = 0; legs < sizeof(bench_legs) / sizeof(bench_legs[0]); ++legs) {
+            memset(&bc, 0, sizeof(bc));
+            bc.variant = bench_ciphers[cipher].name;
+            bc.cipher = &bench_ciphers[cipher];
+            bc.decrypt = bench_legs[legs].decrypt;
+            bc.operation = bc.decrypt ? "decrypt" : "encrypt";
+            bc.legs = bench_legs[legs].legs;
+            bc.left = bench_legs[legs].left;
+            bc.right = bench_legs[legs].right;
+
+            bc.kind = BENCH_KIND_SCALAR;
+            bc.kernel = "scalar";
+            bc.blocks = 1;
+            bc.bytes = bc.cipher->block_size;
+            bench_measure(&bc, &options);
+
+            bc.kind = BENCH_KIND_PARALLEL;
+            bc.kernel = "parallel";
+            for (batch = 0; batch < sizeof(bench_batches) / sizeof(bench_batches[0]); ++batch) {
+                bc.blocks = bench_batches[batch];
+                bc.bytes = bc.blocks * bc.cipher->block_size;
+                bench_measure(&bc, &options);
+            }
+        }
+    }
+
+    /* Modes: messages without associated data; the blocks are those of
+       the message */
+    for (mode = 0; mode < sizeof(bench_modes) / sizeof(bench_modes[0]); ++mode) {
+        const BenchMode_t *m = &bench_modes[mode];
+        memset(&bc, 0, sizeof(bc));
+        bc.kind = BENCH_KIND_MODE;
+        bc.variant = m->variant;
+        bc.legs = "-";
+        bc.kernel = "mode";
+        bc.mode = m;
+        bc.index = mode;
+        for (message = 0; message < sizeof(bench_messages) / sizeof(bench_messages[0]); ++message) {
+            bc.bytes = bench_messages[message];
+            if (bc.bytes > m->max_message)
+                continue;
+            bc.blocks = bc.bytes / m->block_size;
+            m->encrypt(bench_ciphertext[mode], bench_message, bc.bytes);
+            if (m->decrypt(bench_left, bench_ciphertext[mode], bc.bytes + m->block_size)) {
+                fprintf(stderr, "bench: %s does not decrypt\n", m->variant);
+                return 1;
+            }
+            bc.decrypt = 0;
+            bc.operation = "encrypt";
+            bench_measure(&bc, &options);
+            bc.decrypt = 1;
+            bc.operation = "decrypt";
+            bench_measure(&bc, &options);
+        }
+    }
+
+    if (options.json)
+        printf("\n]\n");
+    return 0;
+}
@@ -0,0 +1,1215 @@
+/*
+ * Differential tests of the forkcipher kernels against the scalar code,
+ * and of the PAEF modes against the single-message functions.
+ *
+ *   check.x [-n cases] [-s seed] [-v]
+ *
+ * The scalar functions forkskinny_c_*_encrypt and forkskinny_c_*_decrypt
+ * are the reference. They are first checked against known answers for
+ * all three variants. Then every batch kernel (*_parallel, *_multikey and
+ * *_reduced) is compared with them block by block:
+ *
+ * - in both directions, for each choice of legs;
+ * - for every batch size from 0 to CHECK_SWEEP_BLOCKS, which covers the
+ *   tails of every number of SIMD lanes;
+ * - with buffers misaligned by 0 to 15 bytes, and in place;
+ * - then for random cases (default 1000) of up to CHECK_MAX_BLOCKS
+ *   blocks with random tweakeys and inputs.
+ *
+ * The reduced kernels with other than the full number of rounds have no
+ * scalar counterpart. Each block of a batch is then compared with the
+ * same block run alone, and decryption must invert encryption.
+ *
+ * The modes are then checked against forkae_c_paef_128_384_encrypt: the
+ * midstate of the associated data, scatter/gather lists, the thread pool,
+ * the *_many batches and the job manager must give the same ciphertexts
+ * and messages, for every message length up to a few blocks, random
+ * lengths and messages of several pool chunks. PAEF-64-192 batches are
+ * compared with the single-message code, and RPAEF must round-trip.
+ * Streaming SAEF, with chunks of random sizes each processed in place,
+ * must give the output of the one-shot functions. Every
+ * decryption function must reject a ciphertext with one changed bit in an
+ * earlier block, the last block or the tag, and leave no plaintext.
+ *
+ * Besides the outputs, the bytes around the output buffers must be left
+ * alone, and the inputs must be unchanged unless they are also an
+ * output. Every failing case is printed (with -v every case), and the
+ * exit status is 1 if any case failed.
+ *
+ * Built with FORKSKINNY_FUZZ defined (make fuzz.x, with clang), the file
+ * provides the libFuzzer entry point instead of main: the first bytes of
+ * the fuzzer input select the case, the rest seed its tweakeys and
+ * inputs, and a mismatch aborts.
+ */
+
+#include "forkskinny64-parallel.h"
+#include "forkskinny128-parallel.h"
+#include "forkae-paef.h"
+#include "forkae-pool.h"
+#include "forkae-saef.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#define CHECK_MAX_BLOCKS 300
+#define CHECK_SWEEP_BLOCKS 33
+#define CHECK_KAT_BLOCKS 37
+#define CHECK_GUARD 32
+#define CHECK_GUARD_BYTE 0xA5
+#define CHECK_DEFAULT_CASES 1000
+
+#define CHECK_PARALLEL 0
+#define CHECK_MULTIKEY 1
+#define CHECK_REDUCED 2
+#define CHECK_KERNELS 3
+
+#define CHECK_ENCRYPT 0
+#define CHECK_DECRYPT 1
+
+#define CHECK_LEFT 1
+#define CHECK_RIGHT 2
+#define CHECK_BOTH (CHECK_LEFT | CHECK_RIGHT)
+
+static const char *const check_kernels[CHECK_KERNELS] = {"parallel", "multikey", "reduced"};
+
+/* Key schedules of the current case; one per block for the multikey kernels */
+static ForkSkinny64Key_t check_tks2_64[CHECK_MAX_BLOCKS];
+static ForkSkinny128Key_t check_ks2_128[CHECK_MAX_BLOCKS];
+static ForkSkinny128Key_t check_ks3_128[CHECK_MAX_BLOCKS];
+static const ForkSkinny128Key_t *check_ks2_list[CHECK_MAX_BLOCKS];
+static const ForkSkinny128Key_t *check_ks3_list[CHECK_MAX_BLOCKS];
+
+static int check_verbose;
+
+/* Entry points of a forkcipher, bound to the key schedules above */
+typedef struct
+{
+    const char *name;
+    size_t block_size;
+    size_t key_size;
+    unsigned rounds_before;
+    unsigned rounds_after;
+    unsigned max_rounds;
+    int multikey;
+
+    /** Expands the key (all tweakey parts but TK1) into the given slot */
+    void (*set_key)(size_t slot, const uint8_t *key);
+
+    /** Runs the scalar code on one block under the key of the given slot */
+    void (*scalar)(unsigned direction, size_t slot, const uint8_t *tk1, uint8_t *left, uint8_t *right, const uint8_t *input);
+
+    /** Runs a batch kernel; the parallel and reduced kernels use slot 0, the multikey kernels slots 0 to count - 1 */
+    int (*kernel)(unsigned kernel, unsigned direction, unsigned before, unsigned after, const uint8_t *tk1, uint8_t *left, uint8_t *right, const uint8_t *input, size_t count);
+
+} CheckCipher_t;
+
+static void check_set_key_64_192(size_t slot, const uint8_t *key)
+{
+    forkskinny_c_64_192_init_tk2_tk3(&check_tks2_64[slot], key, FORKSKINNY64_MAX_ROUNDS);
+}
+
+static void check_scalar_64_192(unsigned direction, size_t slot, const uint8_t *tk1, uint8_t *left, uint8_t *right, const uint8_t *input)
+{
+    ForkSkinny64Key_t tks1;
+    forkskinny_c_64_192_init_tk1(&tks1, tk1, FORKSKINNY64_MAX_ROUNDS);
+    if (direction == CHECK_ENCRYPT)
+        forkskinny_c_64_192_encrypt(&tks1, &check_tks2_64[slot], left, right, input);
+    else
+        forkskinny_c_64_192_decrypt(&tks1, &check_tks2_64[slot], left, right, input);
+}
+
+static int check_kernel_64_192(unsigned kernel, unsigned direction, unsigned before, unsigned after, const uint8_t *tk1, uint8_t *left, uint8_t *right, const uint8_t *input, size_t count)
+{
+    if (kernel == CHECK_REDUCED) {
+        if (direction == CHECK_ENCRYPT)
+            return forkskinny_c_64_192_encrypt_reduced(tk1, &check_tks2_64[0], before, after, left, right, input, count);
+        return forkskinny_c_64_192_decrypt_reduced(tk1, &check_tks2_64[0], before, after, left, right, input, count);
+    }
+    if (kernel != CHECK_PARALLEL)
+        return -1;
+    if (direction == CHECK_ENCRYPT)
+        forkskinny_c_64_192_encrypt_parallel(tk1, &check_tks2_64[0], left, right, input, count);
+    else
+        forkskinny_c_64_192_decrypt_parallel(tk1, &check_tks2_64[0], left, right, input, count);
+    return 0;
+}
+
+static void check_set_key_128_256(size_t slot, const uint8_t *key)
+{
+    forkskinny_c_128_256_init_tk2(&check_ks2_128[slot], key, FORKSKINNY128_MAX_ROUNDS);
+    check_ks2_list[slot] = &check_ks2_128[slot];
+}
+
+static void check_scalar_128_256(unsigned direction, size_t slot, const uint8_t *tk1, uint8_t *left, uint8_t *right, const uint8_t *input)
+{
+    ForkSkinny128Key_t ks1;
+    forkskinny_c_128_256_init_tk1(&ks1, tk1, FORKSKINNY128_MAX_ROUNDS);
+    if (direction == CHECK_ENCRYPT)
+        forkskinny_c_128_256_encrypt(&ks1, &check_ks2_128[slot], left, right, input);
+    else
+        forkskinny_c_128_256_decrypt(&ks1, &check_ks2_128[slot], left, right, input);
+}
+
+static int check_kernel_128_256(unsigned kernel, unsigned direction, unsigned before, unsigned after, const uint8_t *tk1, uint8_t *left, uint8_t *right, const uint8_t *input, size_t count)
+{
+    if (kernel == CHECK_REDUCED) {
+        if (direction == CHECK_ENCRYPT)
+            return forkskinny_c_128_256_encrypt_reduced(tk1, &check_ks2_128[0], before, after, left, right, input, count);
+        return forkskinny_c_128_256_decrypt_reduced(tk1, &check_ks2_128[0], before, after, left, right, input, count);
+    }
+    if (kernel == CHECK_MULTIKEY) {
+        if (direction == CHECK_ENCRYPT)
+            forkskinny_c_128_256_encrypt_multikey(tk1, check_ks2_list, left, right, input, count);
+        else
+            forkskinny_c_128_256_decrypt_multikey(tk1, check_ks2_list, left, right, input, count);
+        return 0;
+    }
+    if (direction == CHECK_ENCRYPT)
+        forkskinny_c_128_256_encrypt_parallel(tk1, &check_ks2_128[0], left, right, input, count);
+    else
+        forkskinny_c_128_256_decrypt_parallel(tk1, &check_ks2_128[0], left, right, input, count);
+    return 0;
+}
+
+static void check_set_key_128_384(size_t slot, const uint8_t *key)
+{
+    forkskinny_c_128_384_init_tk2(&check_ks2_128[slot], key, FORKSKINNY128_MAX_ROUNDS);
+    forkskinny_c_128_384_init_tk3(&check_ks3_128[slot], key + FORKSKINNY128_BLOCK_SIZE, FORKSKINNY128_MAX_ROUNDS);
+    check_ks2_list[slot] = &check_ks2_128[slot];
+    check_ks3_list[slot] = &check_ks3_128[slot];
+}
+
+static void check_scalar_128_384(unsigned direction, size_t slot, const uint8_t *tk1, uint8_t *left, uint8_t *right, const uint8_t *input)
+{
+    ForkSkinny128Key_t ks1;
+    forkskinny_c_128_384_init_tk1(&ks1, tk1, FORKSKINNY128_MAX_ROUNDS);
+    if (direction == CHECK_ENCRYPT)
+        forkskinny_c_128_384_encrypt(&ks1, &check_ks2_128[slot], &check_ks3_128[slot], left, right, input);
+    else
+        forkskinny_c_128_384_decrypt(&ks1, &check_ks2_128[slot], &check_ks3_128[slot], left, right, input);
+}
+
+static int check_kernel_128_384(unsigned kernel, unsigned direction, unsigned before, unsigned after, const uint8_t *tk1, uint8_t *left, uint8_t *right, const uint8_t *input, size_t count)
+{
+    if (kernel == CHECK_REDUCED) {
+        if (direction == CHECK_ENCRYPT)
+            return forkskinny_c_128_384_encrypt_reduced(tk1, &check_ks2_128[0], &check_ks3_128[0], before, after, left, right, input, count);
+        return forkskinny_c_128_384_decrypt_reduced(tk1, &check_ks2_128[0], &check_ks3_128[0], before, after, left, right, input, count);
+    }
+    if (kernel == CHECK_MULTIKEY) {
+        if (direction == CHECK_ENCRYPT)
+            forkskinny_c_128_384_encrypt_multikey(tk1, check_ks2_list, check_ks3_list, left, right, input, count);
+        else
+            forkskinny_c_128_384_decrypt_multikey(tk1, check_ks2_list, check_ks3_list, left, right, input, count);
+        return 0;
+    }
+    if (direction == CHECK_ENCRYPT)
+        forkskinny_c_128_384_encrypt_parallel(tk1, &check_ks2_128[0], &check_ks3_128[0], left, right, input, count);
+    else
+        forkskinny_c_128_384_decrypt_parallel(tk1, &check_ks2_128[0], &check_ks3_128[0], left, right, input, count);
+    return 0;
+}
+
+#define CHECK_CIPHERS 3
+
+static const CheckCipher_t check_ciphers[CHECK_CIPHERS] = {
+    {"forkskinny-64-192", FORKSKINNY64_BLOCK_SIZE, 2 * FORKSKINNY64_BLOCK_SIZE,
+     FORKSKINNY_64_192_ROUNDS_BEFORE, FORKSKINNY_64_192_ROUNDS_AFTER, FORKSKINNY64_MAX_ROUNDS, 0,
+     check_set_key_64_192, check_scalar_64_192, check_kernel_64_192},
+    {"forkskinny-128-256", FORKSKINNY128_BLOCK_SIZE, FORKSKINNY128_BLOCK_SIZE,
+     FORKSKINNY_128_256_ROUNDS_BEFORE, FORKSKINNY_128_256_ROUNDS_AFTER, FORKSKINNY128_MAX_ROUNDS, 1,
+     check_set_key_128_256, check_scalar_128_256, check_kernel_128_256},
+    {"forkskinny-128-384", FORKSKINNY128_BLOCK_SIZE, 2 * FORKSKINNY128_BLOCK_SIZE,
+     FORKSKINNY_128_384_ROUNDS_BEFORE, FORKSKINNY_128_384_ROUNDS_AFTER, FORKSKINNY128_MAX_ROUNDS, 1,
+     check_set_key_128_384, check_scalar_128_384, check_kernel_128_384}
+};
+
+/* One comparison of a batch kernel with the reference */
+typedef struct
+{
+    const CheckCipher_t *cipher;
+    unsigned kernel;
+    unsigned direction;
+    unsigned legs;
+    unsigned before;
+    unsigned after;
+    size_t count;
+
+    /** Misalignment of the buffers passed to the kernel, 0 to 15 bytes */
+    unsigned offset;
+
+    /** Non-zero to pass the input buffer as the right output (or the left one if only that is computed) */
+    int in_place;
+
+    /** One key, or count keys for the multikey kernels, of cipher->key_size bytes each */
+    const uint8_t *keys;
+
+    /** count*cipher->block_size bytes each */
+    const uint8_t *tk1;
+    const uint8_t *input;
+
+} CheckCase_t;
+
+static uint64_t check_random(uint64_t *state)
+{
+    uint64_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    *state = x;
+    return x;
+}
+
+static void check_fill(uint64_t *state, uint8_t *buffer, size_t size)
+{
+    size_t posn;
+    for (posn = 0; posn < size; ++posn)
+        buffer[posn] = (uint8_t)(check_random(state) >> 56);
+}
+
+static const char *check_legs(unsigned direction, unsigned legs)
+{
+    if (legs == CHECK_BOTH)
+        return "both";
+    if (legs == CHECK_LEFT)
+        return "left";
+    return direction == CHECK_ENCRYPT ? "right" : "inverse";
+}
+
+static void check_report(const CheckCase_t *c, const char *result, const char *detail, size_t block)
+{
+    printf("%s %s %s %s legs=%s", result, c->cipher->name,
+           check_kernels[c->kernel],
+           c->direction == CHECK_ENCRYPT ? "encrypt" : "decrypt",
+           check_legs(c->direction, c->legs));
+    if (c->kernel == CHECK_REDUCED)
+        printf(" rounds=%u+2*%u", c->before, c->after);
+    printf(" count=%lu offset=%u%s", (unsigned long)c->count, c->offset,
+           c->in_place ? " in-place" : "");
+    if (detail)
+        printf(": %s at block %lu", detail, (unsigned long)block);
+    printf("\n");
+}
+
+/* Returns non-zero if any byte of the buffer differs from the guard byte */
+static int check_guard(const uint8_t *buffer, size_t size)
+{
+    size_t posn;
+    for (posn = 0; posn < size; ++posn) {
+        if (buffer[posn] != CHECK_GUARD_BYTE)
+            return 1;
+    }
+    return 0;
+}
+
+/* Returns the index of the first block that differs, or count */
+static size_t check_compare(const uint8_t *actual, const uint8_t *expected, size_t block_size, size_t count)
+{
+    size_t block;
+    for (block = 0; block < count; ++block) {
+        if (memcmp(actual + block * block_size, expected + block * block_size, block_size) != 0)
+            break;
+    }
+    return block;
+}
+
+/* Computes the expected outputs of one block of a case */
+static void check_expect(const CheckCase_t *c, size_t block, uint8_t *left, uint8_t *right)
+{
+    const CheckCipher_t *cipher = c->cipher;
+    size_t posn = block * cipher->block_size;
+    size_t slot = c->kernel == CHECK_MULTIKEY ? block : 0;
+
+    if (c->kernel == CHECK_REDUCED &&
+            (c->before != cipher->rounds_before || c->after != cipher->rounds_after)) {
+        cipher->kernel(CHECK_REDUCED, c->direction, c->before, c->after,
+                       c->tk1 + posn, (c->legs & CHECK_LEFT) ? left : 0,
+                       (c->legs & CHECK_RIGHT) ? right : 0, c->input + posn, 1);
+    } else {
+        cipher->scalar(c->direction, slot, c->tk1 + posn,
+                       (c->legs & CHECK_LEFT) ? left : 0,
+                       (c->legs & CHECK_RIGHT) ? right : 0, c->input + posn);
+    }
+}
+
+/* Checks that the reduced kernels invert each other on every block */
+static const char *check_inverse(const CheckCase_t *c, size_t *block)
+{
+    const CheckCipher_t *cipher = c->cipher;
+    uint8_t left[FORKSKINNY128_BLOCK_SIZE];
+    uint8_t right[FORKSKINNY128_BLOCK_SIZE];
+    uint8_t input[FORKSKINNY128_BLOCK_SIZE];
+    uint8_t other[FORKSKINNY128_BLOCK_SIZE];
+    size_t posn;
+
+    for (*block = 0; *block < c->count; ++*block) {
+        posn = *block * cipher->block_size;
+        cipher->kernel(CHECK_REDUCED, CHECK_ENCRYPT, c->before, c->after,
+                       c->tk1 + posn, left, right, c->input + posn, 1);
+        cipher->kernel(CHECK_REDUCED, CHECK_DECRYPT, c->before, c->after,
+                       c->tk1 + posn, other, input, right, 1);
+        if (memcmp(input, c->input + posn, cipher->block_size) != 0)
+            return "decryption does not invert encryption";
+        if (memcmp(other, left, cipher->block_size) != 0)
+            return "left leg of decryption differs from encryption";
+    }
+    return 0;
+}
+
+/* Runs one case; returns non-zero if it failed */
+static int check_run(const CheckCase_t *c)
+{
+    const CheckCipher_t *cipher = c->cipher;
+    size_t block_size = cipher->block_size;
+    size_t bytes = c->count * block_size;
+    size_t size = c->offset + bytes + CHECK_GUARD;
+    size_t slots = c->kernel == CHECK_MULTIKEY ? c->count : 1;
+    uint8_t *tk1 = (uint8_t *)malloc(size);
+    uint8_t *input = (uint8_t *)malloc(size);
+    uint8_t *left = (uint8_t *)malloc(size);
+    uint8_t *right = (uint8_t *)malloc(size);
+    uint8_t *expected_left = (uint8_t *)malloc(bytes + 1);
+    uint8_t *expected_right = (uint8_t *)malloc(bytes + 1);
+    uint8_t *output_left = 0;
+    uint8_t *output_right = 0;
+    const char *detail = 0;
+    size_t slot, block = 0;
+
+    if (!tk1 || !input || !left || !right || !expected_left || !expected_right) {
+        perror("check.x");
+        exit(2);
+    }
+
+    for (slot = 0; slot < slots; ++slot)
+        cipher->set_key(slot, c->keys + slot * cipher->key_size);
+    for (block = 0; block < c->count; ++block)
+        check_expect(c, block, expected_left + block * block_size, expected_right + block * block_size);
+
+    memset(tk1, CHECK_GUARD_BYTE, size);
+    memset(input, CHECK_GUARD_BYTE, size);
+    memset(left, CHECK_GUARD_BYTE, size);
+    memset(right, CHECK_GUARD_BYTE, size);
+    memcpy(tk1 + c->offset, c->tk1, bytes);
+    memcpy(input + c->offset, c->input, bytes);
+    if (c->legs & CHECK_LEFT)
+        output_left = left + c->offset;
+    if (c->legs & CHECK_RIGHT)
+        output_right = right + c->offset;
+    if (c->in_place) {
+        if (output_right)
+            output_right = input + c->offset;
+        else
+            output_left = input + c->offset;
+    }
+
+    if (cipher->kernel(c->kernel, c->direction, c->before, c->after, tk1 + c->offset,
+                       output_left, output_right, input + c->offset, c->count) != 0)
+        detail = "kernel rejected the case";
+    else if (output_left && (block = check_compare(output_left, expected_left, block_size, c->count)) < c->count)
+        detail = "left output differs";
+    else if (output_right && (block = check_compare(output_right, expected_right, block_size, c->count)) < c->count)
+        detail = c->direction == CHECK_ENCRYPT ? "right output differs" : "inverse differs";
+    else if (check_guard(left, c->offset) || check_guard(left + c->offset + bytes, CHECK_GUARD) ||
+             (!output_left && check_guard(left, size)) ||
+             check_guard(right, c->offset) || check_guard(right + c->offset + bytes, CHECK_GUARD) ||
+             (!output_right && check_guard(right, size)) ||
+             check_guard(input, c->offset) || check_guard(input + c->offset + bytes, CHECK_GUARD))
+        detail = "write outside the output buffers", block = 0;
+    else if (memcmp(tk1 + c->offset, c->tk1, bytes) != 0)
+        detail = "TK1 modified", block = 0;
+    else if (!c->in_place && memcmp(input + c->offset, c->input, bytes) != 0)
+        detail = "input modified", block = 0;
+    else if (c->kernel == CHECK_REDUCED)
+        detail = check_inverse(c, &block);
+
+    if (detail)
+        check_report(c, "FAIL", detail, block);
+    else if (check_verbose)
+        check_report(c, "ok", 0, 0);
+
+    free(tk1);
+    free(input);
+    free(left);
+    free(right);
+    free(expected_left);
+    free(expected_right);
+    return detail != 0;
+}
+
+#if !defined(FORKSKINNY_FUZZ)
+
+/*
+ * Known answers: TK1, then the key (TK2, TK3), the input and the right
+ * (C0) and left (C1) outputs of the forkcipher. The vectors are those of
+ * demo.c, with the key of 64-192 split into TK1 and TK2||TK3.
+ */
+typedef struct
+{
+    const CheckCipher_t *cipher;
+    uint8_t tk1[FORKSKINNY128_BLOCK_SIZE];
+    uint8_t key[2 * FORKSKINNY128_BLOCK_SIZE];
+    uint8_t input[FORKSKINNY128_BLOCK_SIZE];
+    uint8_t right[FORKSKINNY128_BLOCK_SIZE];
+    uint8_t left[FORKSKINNY128_BLOCK_SIZE];
+
+} CheckKAT_t;
+
+static const CheckKAT_t check_kats[CHECK_CIPHERS] = {
+    {&check_ciphers[0],
+     {0x29, 0xcd, 0xba, 0xab, 0xf2, 0xfb, 0xe3, 0x46},
+     {0x7c, 0xc2, 0x54, 0xf8, 0x1b, 0xe8, 0xe7, 0x8d, 0x76, 0x5a, 0x2e, 0x63, 0x33, 0x9f, 0xc9, 0x9a},
+     {0x67, 0xc6, 0x69, 0x73, 0x51, 0xff, 0x4a, 0xec},
+     {0x47, 0x00, 0xf4, 0x43, 0xf3, 0xf0, 0x3c, 0x09},
+     {0x0a, 0xae, 0x6e, 0x75, 0xea, 0x6b, 0xe1, 0xfc}},
+    {&check_ciphers[1],
+     {0x29, 0xcd, 0xba, 0xab, 0xf2, 0xfb, 0xe3, 0x46, 0x7c, 0xc2, 0x54, 0xf8, 0x1b, 0xe8, 0xe7, 0x8d},
+     {0x76, 0x5a, 0x2e, 0x63, 0x33, 0x9f, 0xc9, 0x9a, 0x66, 0x32, 0x0d, 0xb7, 0x31, 0x58, 0x80, 0x01},
+     {0x67, 0xc6, 0x69, 0x73, 0x51, 0xff, 0x4a, 0xec, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+     {0xdc, 0xf8, 0x3b, 0x78, 0xfc, 0xf1, 0x01, 0x77, 0x4d, 0x41, 0xc0, 0x76, 0x4c, 0xd3, 0xb6, 0x2d},
+     {0xcb, 0x49, 0x5e, 0xb6, 0xe2, 0xf9, 0x60, 0x3e, 0x51, 0xee, 0x40, 0x94, 0xbc, 0xdf, 0xcd, 0xd5}},
+    {&check_ciphers[2],
+     {0x29, 0xcd, 0xba, 0xab, 0xf2, 0xfb, 0xe3, 0x46, 0x7c, 0xc2, 0x54, 0xf8, 0x1b, 0xe8, 0xe7, 0x8d},
+     {0x76, 0x5a, 0x2e, 0x63, 0x33, 0x9f, 0xc9, 0x9a, 0x66, 0x32, 0x0d, 0xb7, 0x31, 0x58, 0x80, 0x01,
+      0x29, 0xcd, 0xba, 0xab, 0xf2, 0xfb, 0xe3, 0x46, 0x7c, 0xc2, 0x54, 0xf8, 0x1b, 0xe8, 0xe7, 0x8d},
+     {0x67, 0xc6, 0x69, 0x73, 0x51, 0xff, 0x4a, 0xec, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+     {0x16, 0x8c, 0xdc, 0x77, 0x41, 0x87, 0xd8, 0x72, 0x73, 0xd2, 0x1f, 0xa1, 0x8e, 0xa4, 0x6d, 0x26},
+     {0x06, 0x2f, 0xa2, 0xa6, 0xe8, 0x8c, 0x31, 0x4f, 0x45, 0x69, 0x1c, 0xcd, 0x8e, 0xdd, 0xe2, 0x09}}
+};
+
+static unsigned long check_cases;
+static unsigned long check_failures;
+
+static void check_count(int failed)
+{
+    ++check_cases;
+    if (failed)
+        ++check_failures;
+}
+
+/* Checks the scalar code, then every kernel, against the known answers */
+static void check_kat(const CheckKAT_t *kat)
+{
+    const CheckCipher_t *cipher = kat->cipher;
+    size_t block_size = cipher->block_size;
+    uint8_t tk1[CHECK_KAT_BLOCKS * FORKSKINNY128_BLOCK_SIZE];
+    uint8_t input[CHECK_KAT_BLOCKS * FORKSKINNY128_BLOCK_SIZE];
+    uint8_t keys[CHECK_KAT_BLOCKS * 2 * FORKSKINNY128_BLOCK_SIZE];
+    uint8_t left[FORKSKINNY128_BLOCK_SIZE];
+    uint8_t right[FORKSKINNY128_BLOCK_SIZE];
+    CheckCase_t c;
+    unsigned kernel;
+    size_t block;
+    int failed;
+
+    cipher->set_key(0, kat->key);
+    cipher->scalar(CHECK_ENCRYPT, 0, kat->tk1, left, right, kat->input);
+    failed = memcmp(left, kat->left, block_size) != 0 || memcmp(right, kat->right, block_size) != 0;
+    memset(left, 0, sizeof(left));
+    cipher->scalar(CHECK_ENCRYPT, 0, kat->tk1, left, 0, kat->input);
+    failed |= memcmp(left, kat->left, block_size) != 0;
+    memset(right, 0, sizeof(right));
+    cipher->scalar(CHECK_ENCRYPT, 0, kat->tk1, 0, right, kat->input);
+    failed |= memcmp(right, kat->right, block_size) != 0;
+    memset(left, 0, sizeof(left));
+    memset(right, 0, sizeof(right));
+    cipher->scalar(CHECK_DECRYPT, 0, kat->tk1, left, right, kat->right);
+    failed |= memcmp(left, kat->left, block_size) != 0 || memcmp(right, kat->input, block_size) != 0;
+    memset(left, 0, sizeof(left));
+    cipher->scalar(CHECK_DECRYPT, 0, kat->tk1, left, 0, kat->right);
+    failed |= memcmp(left, kat->left, block_size) != 0;
+    memset(right, 0, sizeof(right));
+    cipher->scalar(CHECK_DECRYPT, 0, kat->tk1, 0, right, kat->right);
+    failed |= memcmp(right, kat->input, block_size) != 0;
+    /* Without outputs there is nothing to compute (or write) */
+    cipher->scalar(CHECK_ENCRYPT, 0, kat->tk1, 0, 0, kat->input);
+    cipher->scalar(CHECK_DECRYPT, 0, kat->tk1, 0, 0, kat->right);
+    printf("%s %s scalar known answers\n", failed ? "FAIL" : "ok", cipher->name);
+    check_count(failed);
+
+    /* A batch of copies of the vector puts it in every lane */
+    for (block = 0; block < CHECK_KAT_BLOCKS; ++block) {
+        memcpy(tk1 + block * block_size, kat->tk1, block_size);
+        memcpy(keys + block * cipher->key_size, kat->key, cipher->key_size);
+    }
+    for (kernel = 0; kernel < CHECK_KERNELS; ++kernel) {
+        if (kernel == CHECK_MULTIKEY && !cipher->multikey)
+            continue;
+        memset(&c, 0, sizeof(c));
+        c.cipher = cipher;
+        c.kernel = kernel;
+        c.before = cipher->rounds_before;
+        c.after = cipher->rounds_after;
+        c.legs = CHECK_BOTH;
+        c.count = CHECK_KAT_BLOCKS;
+        c.offset = 1;
+        c.keys = keys;
+        c.tk1 = tk1;
+        c.input = input;
+        c.direction = CHECK_ENCRYPT;
+        for (block = 0; block < CHECK_KAT_BLOCKS; ++block)
+            memcpy(input + block * block_size, kat->input, block_size);
+        check_count(check_run(&c));
+        c.direction = CHECK_DECRYPT;
+        for (block = 0; block < CHECK_KAT_BLOCKS; ++block)
+            memcpy(input + block * block_size, kat->right, block_size);
+        check_count(check_run(&c));
+    }
+}
+
+/* Runs a case with random keys, TK1 and inputs */
+static void check_random_case(uint64_t *state, CheckCase_t *c)
+{
+    static uint8_t keys[CHECK_MAX_BLOCKS * 2 * FORKSKINNY128_BLOCK_SIZE];
+    static uint8_t tk1[CHECK_MAX_BLOCKS * FORKSKINNY128_BLOCK_SIZE];
+    static uint8_t input[CHECK_MAX_BLOCKS * FORKSKINNY128_BLOCK_SIZE];
+
+    check_fill(state, keys, sizeof(keys));
+    check_fill(state, tk1, sizeof(tk1));
+    check_fill(state, input, sizeof(input));
+    c->keys = keys;
+    c->tk1 = tk1;
+    c->input = input;
+    check_count(check_run(c));
+}
+
+/*
+ * Mode cases: the ciphertext of forkae_c_paef_128_384_encrypt is the
+ * reference for the other ways of running PAEF (midstate of the
+ * associated data, scatter/gather lists, thread pool, batches and job
+ * manager), and for the batches of PAEF-64-192. Every decryption must
+ * also reject a ciphertext with one changed bit, whether in an earlier
+ * block, in the last one or in the tag.
+ */
+
+#define CHECK_MODE_MESSAGES 24
+#define CHECK_MODE_SWEEP_BATCHES 3
+#define CHECK_MODE_BATCHES 8
+#define CHECK_MODE_MAX_LEN 300
+#define CHECK_MODE_MAX_AD 40
+#define CHECK_MODE_IOVS 64
+#define CHECK_MODE_THREADS 3
+#define CHECK_MODE_TAMPER 4
+#define CHECK_MODE_CHUNK 40
+
+/* A message of the mode cases and its reference ciphertext */
+typedef struct
+{
+    uint8_t nonce[FORKAE_PAEF_128_384_NONCE_SIZE];
+    uint8_t ad[CHECK_MODE_MAX_AD];
+    size_t adlen;
+    uint8_t *message;
+    size_t mlen;
+    uint8_t *ciphertext;
+    size_t clen;
+
+} CheckMessage_t;
+
+static void *check_alloc(size_t size)
+{
+    void *buffer = malloc(size ? size : 1);
+    if (!buffer) {
+        fprintf(stderr, "check.x: out of memory\n");
+        exit(2);
+    }
+    return buffer;
+}
+
+static void check_mode(const char *mode, const char *what, const CheckMessage_t *msg, int failed)
+{
+    if (failed || check_verbose)
+        printf("%s %s %s mlen=%lu adlen=%lu\n", failed ? "FAIL" : "ok", mode, what,
+               (unsigned long)msg->mlen, (unsigned long)msg->adlen);
+    check_count(failed);
+}
+
+/* Returns non-zero unless the output is the expected len bytes */
+static int check_output(int result, const uint8_t *output, size_t outlen, const uint8_t *expected, size_t len)
+{
+    return result != 0 || outlen != len || memcmp(output, expected, len) != 0;
+}
+
+/* Returns non-zero unless a decryption failed with an empty message and
+   left nothing but CHECK_GUARD_BYTE or zeroes in its output */
+static int check_rejected(int result, size_t mlen, const uint8_t *output, size_t size)
+{
+    size_t posn;
+    if (result != -1 || mlen != 0)
+        return 1;
+    for (posn = 0; posn < size; ++posn) {
+        if (output[posn] != CHECK_GUARD_BYTE && output[posn] != 0)
+            return 1;
+    }
+    return 0;
+}
+
+/* Splits a buffer into a scatter/gather list of random pieces; the last
+   one may be empty */
+static size_t check_split(uint64_t *state, ForkAEIOVec_t *iov, uint8_t *buffer, size_t len)
+{
+    size_t count = 0;
+    size_t piece;
+    while (len > 0 && count < CHECK_MODE_IOVS - 1) {
+        piece = 1 + (size_t)(check_random(state) % (len / 8 + 37));
+        if (piece > len)
+            piece = len;
+        iov[count].iov_base = buffer;
+        iov[count].iov_len = piece;
+        ++count;
+        buffer += piece;
+        len -= piece;
+    }
+    iov[count].iov_base = buffer;
+    iov[count].iov_len = len;
+    return count + 1;
+}
+
+/* Picks the bytes to change: in the first block, anywhere, in the last
+   block and in the tag */
+static void check_tamper_positions(uint64_t *state, size_t *posns, size_t size, size_t tag_size)
+{
+    posns[0] = 0;
+    posns[1] = (size_t)(check_random(state) % size);
+    posns[2] = size > tag_size ? size - tag_size - 1 : 0;
+    posns[3] = size - 1;
+}
+
+static void check_message(uint64_t *state, CheckMessage_t *msg, size_t mlen)
+{
+    check_fill(state, msg->nonce, sizeof(msg->nonce));
+    msg->adlen = (size_t)(check_random(state) % (CHECK_MODE_MAX_AD + 1));
+    check_fill(state, msg->ad, msg->adlen);
+    msg->mlen = mlen;
+    msg->message = check_alloc(mlen);
+    check_fill(state, msg->message, mlen);
+    msg->ciphertext = 0;
+    msg->clen = 0;
+}
+
+/* Sets the reference ciphertext of a message, and checks every other way
+   of encrypting and decrypting it on its own */
+static void check_paef_128_384(uint64_t *state, ForkAEPool_t *pool, const ForkAE128384Key_t *key, CheckMessage_t *msg)
+{
+    static const char mode[] = "paef-128-384";
+    size_t size = FORKAE_PAEF_128_384_CIPHERTEXT_SIZE(msg->mlen);
+    uint8_t *output = check_alloc(size);
+    uint8_t *tampered = check_alloc(size);
+    uint8_t *reduced = check_alloc(size);
+    ForkAEIOVec_t civ[CHECK_MODE_IOVS];
+    ForkAEIOVec_t miv[CHECK_MODE_IOVS];
+    ForkAEIOVec_t adiv[CHECK_MODE_IOVS];
+    ForkAEPAEF128384AD_t midstate;
+    size_t posns[CHECK_MODE_TAMPER];
+    size_t ccount, mcount, adcount;
+    size_t len, rlen, tamper;
+    int result;
+
+    msg->ciphertext = check_alloc(size);
+    result = forkae_c_paef_128_384_encrypt(key, msg->ciphertext, &msg->clen, msg->message, msg->mlen, msg->ad, msg->adlen, msg->nonce);
+    check_mode(mode, "encrypt", msg, result != 0 || msg->clen != size);
+    memset(output, CHECK_GUARD_BYTE, size);
+    result = forkae_c_paef_128_384_decrypt(key, output, &len, msg->ciphertext, size, msg->ad, msg->adlen, msg->nonce);
+    check_mode(mode, "decrypt", msg, check_output(result, output, len, msg->message, msg->mlen));
+
+    /* Associated data absorbed once */
+    result = forkae_c_paef_128_384_init_ad(key, &midstate, msg->ad, msg->adlen);
+    memset(output, CHECK_GUARD_BYTE, size);
+    result |= forkae_c_paef_128_384_encrypt_ad(key, &midstate, output, &len, msg->message, msg->mlen, msg->nonce);
+    check_mode(mode, "encrypt_ad", msg, check_output(result, output, len, msg->ciphertext, size));
+    memset(output, CHECK_GUARD_BYTE, size);
+    result = forkae_c_paef_128_384_decrypt_ad(key, &midstate, output, &len, msg->ciphertext, size, msg->nonce);
+    check_mode(mode, "decrypt_ad", msg, check_output(result, output, len, msg->message, msg->mlen));
+
+    /* Scatter/gather lists, decrypting in place */
+    memset(output, CHECK_GUARD_BYTE, size);
+    ccount = check_split(state, civ, output, size);
+    mcount = check_split(state, miv, msg->message, msg->mlen);
+    adcount = check_split(state, adiv, msg->ad, msg->adlen);
+    result = forkae_c_paef_128_384_encrypt_iov(key, civ, ccount, &len, miv, mcount, adiv, adcount, msg->nonce);
+    check_mode(mode, "encrypt_iov", msg, check_output(result, output, len, msg->ciphertext, size));
+    ccount = check_split(state, civ, output, size);
+    result = forkae_c_paef_128_384_decrypt_iov(key, civ, ccount, &len, civ, ccount, adiv, adcount, msg->nonce);
+    check_mode(mode, "decrypt_iov", msg, check_output(result, output, len, msg->message, msg->mlen));
+
+    /* Thread pool */
+    memset(output, CHECK_GUARD_BYTE, size);
+    result = forkae_c_paef_128_384_encrypt_pool(pool, key, output, &len, msg->message, msg->mlen, msg->ad, msg->adlen, msg->nonce);
+    check_mode(mode, "encrypt_pool", msg, check_output(result, output, len, msg->ciphertext, size));
+    memset(output, CHECK_GUARD_BYTE, size);
+    result = forkae_c_paef_128_384_decrypt_pool(pool, key, output, &len, msg->ciphertext, size, msg->ad, msg->adlen, msg->nonce);
+    check_mode(mode, "decrypt_pool", msg, check_output(result, output, len, msg->message, msg->mlen));
+
+    /* RPAEF has no second implementation: it must round-trip */
+    result = forkae_c_rpaef_128_384_encrypt(key, reduced, &rlen, msg->message, msg->mlen, msg->ad, msg->adlen, msg->nonce);
+    check_mode("rpaef-128-384", "encrypt", msg, result != 0 || rlen != size);
+    memset(output, CHECK_GUARD_BYTE, size);
+    result = forkae_c_rpaef_128_384_decrypt(key, output, &len, reduced, size, msg->ad, msg->adlen, msg->nonce);
+    check_mode("rpaef-128-384", "decrypt", msg, check_output(result, output, len, msg->message, msg->mlen));
+
+    /* One changed bit */
+    check_tamper_positions(state, posns, size, FORKAE_PAEF_128_384_TAG_SIZE);
+    for (tamper = 0; tamper < CHECK_MODE_TAMPER; ++tamper) {
+        uint8_t bit = (uint8_t)(1 << (check_random(state) % 8));
+        memcpy(tampered, msg->ciphertext, size);
+        tampered[posns[tamper]] ^= bit;
+        memset(output, CHECK_GUARD_BYTE, size);
+        result = forkae_c_paef_128_384_decrypt(key, output, &len, tampered, size, msg->ad, msg->adlen, msg->nonce);
+        check_mode(mode, "decrypt tampered", msg, check_rejected(result, len, output, size));
+        memset(output, CHECK_GUARD_BYTE, size);
+        result = forkae_c_paef_128_384_decrypt_ad(key, &midstate, output, &len, tampered, size, msg->nonce);
+        check_mode(mode, "decrypt_ad tampered", msg, check_rejected(result, len, output, size));
+        memset(output, CHECK_GUARD_BYTE, size);
+        ccount = check_split(state, civ, tampered, size);
+        mcount = check_split(state, miv, output, size);
+        result = forkae_c_paef_128_384_decrypt_iov(key, miv, mcount, &len, civ, ccount, adiv, adcount, msg->nonce);
+        check_mode(mode, "decrypt_iov tampered", msg, check_rejected(result, len, output, size));
+        memset(output, CHECK_GUARD_BYTE, size);
+        result = forkae_c_paef_128_384_decrypt_pool(pool, key, output, &len, tampered, size, msg->ad, msg->adlen, msg->nonce);
+        check_mode(mode, "decrypt_pool tampered", msg, check_rejected(result, len, output, size));
+        memcpy(tampered, reduced, size);
+        tampered[posns[tamper]] ^= bit;
+        memset(output, CHECK_GUARD_BYTE, size);
+        result = forkae_c_rpaef_128_384_decrypt(key, output, &len, tampered, size, msg->ad, msg->adlen, msg->nonce);
+        check_mode("rpaef-128-384", "decrypt tampered", msg, check_rejected(result, len, output, size));
+    }
+
+    free(output);
+    free(tampered);
+    free(reduced);
+}
+
+/* Checks streaming SAEF-128-384 against the one-shot functions, with
+   chunks of random sizes, each encrypted or decrypted in place */
+static void check_saef_128_384(uint64_t *state, const ForkAE128384Key_t *key, const CheckMessage_t *msg)
+{
+    static const char mode[] = "saef-128-384";
+    size_t size = msg->mlen + FORKAE_SAEF_128_TAG_SIZE;
+    uint8_t chunk[CHECK_MODE_CHUNK + 2 * FORKSKINNY128_BLOCK_SIZE];
+    uint8_t *reference = check_alloc(size);
+    uint8_t *output = check_alloc(size + 2 * FORKSKINNY128_BLOCK_SIZE);
+    ForkAESAEF128State_t saef;
+    size_t clen, posn, len, written, total;
+    int result;
+
+    forkae_c_saef_128_384_encrypt(key, reference, &clen, msg->message, msg->mlen, msg->ad, msg->adlen, msg->nonce);
+
+    forkae_c_saef_128_384_init(&saef, key, msg->nonce);
+    forkae_c_saef_128_update_ad(&saef, msg->ad, msg->adlen);
+    for (posn = 0, total = 0; posn < msg->mlen; posn += len) {
+        len = 1 + (size_t)(check_random(state) % CHECK_MODE_CHUNK);
+        if (len > msg->mlen - posn)
+            len = msg->mlen - posn;
+        memcpy(chunk, msg->message + posn, len);
+        written = forkae_c_saef_128_encrypt_update(&saef, chunk, chunk, len);
+        memcpy(output + total, chunk, written);
+        total += written;
+    }
+    total += forkae_c_saef_128_encrypt_final(&saef, output + total);
+    check_mode(mode, "encrypt_update in place", msg, check_output(0, output, total, reference, clen));
+
+    forkae_c_saef_128_384_init(&saef, key, msg->nonce);
+    forkae_c_saef_128_update_ad(&saef, msg->ad, msg->adlen);
+    for (posn = 0, total = 0; posn < clen; posn += len) {
+        len = 1 + (size_t)(check_random(state) % CHECK_MODE_CHUNK);
+        if (len > clen - posn)
+            len = clen - posn;
+        memcpy(chunk, reference + posn, len);
+        written = forkae_c_saef_128_decrypt_update(&saef, chunk, chunk, len);
+        memcpy(output + total, chunk, written);
+        total += written;
+    }
+    result = forkae_c_saef_128_decrypt_final(&saef, output + total, &len);
+    check_mode(mode, "decrypt_update in place", msg, check_output(result, output, total + len, msg->message, msg->mlen));
+
+    free(reference);
+    free(output);
+}
+
+/* Checks the batches and the job manager against the reference
+   ciphertexts; message index is under keys[index & 1], and one
+   ciphertext of each decryption batch has a changed bit */
+static void check_paef_128_384_batch(uint64_t *state, const ForkAE128384Key_t *keys, CheckMessage_t *msgs, size_t count)
+{
+    static const char mode[] = "paef-128-384";
+    static ForkAEMessage_t batch[CHECK_MODE_MESSAGES];
+    static ForkAEPAEF128384Job_t jobs[CHECK_MODE_MESSAGES];
+    static size_t indices[CHECK_MODE_MESSAGES];
+    static uint8_t *outputs[CHECK_MODE_MESSAGES];
+    static uint8_t *inputs[CHECK_MODE_MESSAGES];
+    static int returned[CHECK_MODE_MESSAGES];
+    ForkAEPAEF128384Manager_t manager;
+    ForkAEPAEF128384Job_t *job;
+    const CheckMessage_t *msg;
+    size_t index, posn, size, bad;
+    unsigned k;
+
+    for (index = 0; index < count; ++index) {
+        size = msgs[index].clen;
+        outputs[index] = check_alloc(size);
+        inputs[index] = check_alloc(size);
+        memcpy(inputs[index], msgs[index].ciphertext, size);
+    }
+
+    for (k = 0; k < 2; ++k) {
+        /* Encryption of the messages under this key */
+        size_t n = 0;
+        for (index = k; index < count; index += 2) {
+            msg = &msgs[index];
+            memset(outputs[index], CHECK_GUARD_BYTE, msg->clen);
+            memset(&batch[n], 0, sizeof(batch[n]));
+            batch[n].nonce = msg->nonce;
+            batch[n].ad = msg->ad;
+            batch[n].adlen = msg->adlen;
+            batch[n].input = msg->message;
+            batch[n].inlen = msg->mlen;
+            batch[n].output = outputs[index];
+            indices[n++] = index;
+        }
+        forkae_c_paef_128_384_encrypt_many(&keys[k], batch, n);
+        for (posn = 0; posn < n; ++posn) {
+            msg = &msgs[indices[posn]];
+            check_mode(mode, "encrypt_many", msg, check_output(batch[posn].result, batch[posn].output, batch[posn].outlen, msg->ciphertext, msg->clen));
+        }
+
+        /* Decryption, with one of the ciphertexts changed */
+        bad = n ? (size_t)(check_random(state) % n) : 0;
+        for (posn = 0; posn < n; ++posn) {
+            msg = &msgs[indices[posn]];
+            memset(outputs[indices[posn]], CHECK_GUARD_BYTE, msg->clen);
+            batch[posn].input = inputs[indices[posn]];
+            batch[posn].inlen = msg->clen;
+        }
+        if (n)
+            inputs[indices[bad]][check_random(state) % msgs[indices[bad]].clen] ^= 0x01;
+        forkae_c_paef_128_384_decrypt_many(&keys[k], batch, n);
+        for (posn = 0; posn < n; ++posn) {
+            msg = &msgs[indices[posn]];
+            if (posn == bad)
+                check_mode(mode, "decrypt_many tampered", msg, check_rejected(batch[posn].result, batch[posn].outlen, batch[posn].output, msg->clen));
+            else
+                check_mode(mode, "decrypt_many", msg, check_output(batch[posn].result, batch[posn].output, batch[posn].outlen, msg->message, msg->mlen));
+        }
+        if (n)
+            memcpy(inputs[indices[bad]], msgs[indices[bad]].ciphertext, msgs[indices[bad]].clen);
+    }
+
+    /* Job manager: both keys and both directions mixed, the last
+       decryption job changed */
+    forkae_c_paef_128_384_mb_init(&manager);
+    bad = count;
+    for (index = 0; index < count; ++index) {
+        msg = &msgs[index];
+        job = &jobs[index];
+        memset(job, 0, sizeof(*job));
+        memset(outputs[index], CHECK_GUARD_BYTE, msg->clen);
+        job->key = &keys[index & 1];
+        job->decrypt = (int)(check_random(state) & 1);
+        job->message.nonce = msg->nonce;
+        job->message.ad = msg->ad;
+        job->message.adlen = msg->adlen;
+        job->message.output = outputs[index];
+        if (job->decrypt) {
+            job->message.input = inputs[index];
+            job->message.inlen = msg->clen;
+            bad = index;
+        } else {
+            job->message.input = msg->message;
+            job->message.inlen = msg->mlen;
+        }
+        job->user = &returned[index];
+        returned[index] = 0;
+    }
+    if (bad < count)
+        inputs[bad][check_random(state) % msgs[bad].clen] ^= 0x80;
+    for (index = 0; index < count; ++index) {
+        job = forkae_c_paef_128_384_mb_submit(&manager, &jobs[index]);
+        if (job)
+            ++*(int *)job->user;
+        while ((job = forkae_c_paef_128_384_mb_get_completed(&manager)) != 0)
+            ++*(int *)job->user;
+    }
+    while ((job = forkae_c_paef_128_384_mb_flush(&manager)) != 0)
+        ++*(int *)job->user;
+    for (index = 0; index < count; ++index) {
+        ForkAEMessage_t *m = &jobs[index].message;
+        msg = &msgs[index];
+        if (!jobs[index].decrypt)
+            check_mode(mode, "mb encrypt", msg, returned[index] != 1 || check_output(m->result, m->output, m->outlen, msg->ciphertext, msg->clen));
+        else if (index == bad)
+            check_mode(mode, "mb decrypt tampered", msg, returned[index] != 1 || check_rejected(m->result, m->outlen, m->output, msg->clen));
+        else
+            check_mode(mode, "mb decrypt", msg, returned[index] != 1 || check_output(m->result, m->output, m->outlen, msg->message, msg->mlen));
+    }
+
+    for (index = 0; index < count; ++index) {
+        free(outputs[index]);
+        free(inputs[index]);
+    }
+}
+
+/* Checks PAEF-64-192 on its own and in batches, with one ciphertext of
+   the decryption batch changed */
+static void check_paef_64_192(uint64_t *state, const ForkAE64192Key_t *key, CheckMessage_t *msgs, size_t count)
+{
+    static const char mode[] = "paef-64-192";
+    static ForkAEMessage_t batch[CHECK_MODE_MESSAGES];
+    static uint8_t *refs[CHECK_MODE_MESSAGES];
+    static uint8_t *outputs[CHECK_MODE_MESSAGES];
+    size_t posns[CHECK_MODE_TAMPER];
+    const CheckMessage_t *msg;
+    uint8_t *tampered;
+    size_t index, tamper, size, len, bad;
+    int result;
+
+    for (index = 0; index < count; ++index) {
+        msg = &msgs[index];
+        size = FORKAE_PAEF_64_192_CIPHERTEXT_SIZE(msg->mlen);
+        refs[index] = check_alloc(size);
+        outputs[index] = check_alloc(size);
+        tampered = check_alloc(size);
+        result = forkae_c_paef_64_192_encrypt(key, refs[index], &len, msg->message, msg->mlen, msg->ad, msg->adlen, msg->nonce);
+        check_mode(mode, "encrypt", msg, result != 0 || len != size);
+        memset(outputs[index], CHECK_GUARD_BYTE, size);
+        result = forkae_c_paef_64_192_decrypt(key, outputs[index], &len, refs[index], size, msg->ad, msg->adlen, msg->nonce);
+        check_mode(mode, "decrypt", msg, check_output(result, outputs[index], len, msg->message, msg->mlen));
+        check_tamper_positions(state, posns, size, FORKAE_PAEF_64_192_TAG_SIZE);
+        for (tamper = 0; tamper < CHECK_MODE_TAMPER; ++tamper) {
+            memcpy(tampered, refs[index], size);
+            tampered[posns[tamper]] ^= (uint8_t)(1 << (check_random(state) % 8));
+            memset(outputs[index], CHECK_GUARD_BYTE, size);
+            result = forkae_c_paef_64_192_decrypt(key, outputs[index], &len, tampered, size, msg->ad, msg->adlen, msg->nonce);
+            check_mode(mode, "decrypt tampered", msg, check_rejected(result, len, outputs[index], size));
+        }
+        free(tampered);
+
+        memset(outputs[index], CHECK_GUARD_BYTE, size);
+        memset(&batch[index], 0, sizeof(batch[index]));
+        batch[index].nonce = msg->nonce;
+        batch[index].ad = msg->ad;
+        batch[index].adlen = msg->adlen;
+        batch[index].input = msg->message;
+        batch[index].inlen = msg->mlen;
+        batch[index].output = outputs[index];
+    }
+    forkae_c_paef_64_192_encrypt_many(key, batch, count);
+    for (index = 0; index < count; ++index) {
+        msg = &msgs[index];
+        size = FORKAE_PAEF_64_192_CIPHERTEXT_SIZE(msg->mlen);
+        check_mode(mode, "encrypt_many", msg, check_output(batch[index].result, batch[index].output, batch[index].outlen, refs[index], size));
+        memset(outputs[index], CHECK_GUARD_BYTE, size);
+        batch[index].input = refs[index];
+        batch[index].inlen = size;
+    }
+    bad = count ? (size_t)(check_random(state) % count) : 0;
+    if (count)
+        refs[bad][check_random(state) % batch[bad].inlen] ^= 0x01;
+    forkae_c_paef_64_192_decrypt_many(key, batch, count);
+    for (index = 0; index < count; ++index) {
+        msg = &msgs[index];
+        if (index == bad)
+            check_mode(mode, "decrypt_many tampered", msg, check_rejected(batch[index].result, batch[index].outlen, batch[index].output, batch[index].inlen));
+        else
+            check_mode(mode, "decrypt_many", msg, check_output(batch[index].result, batch[index].output, batch[index].outlen, msg->message, msg->mlen));
+        free(refs[index]);
+        free(outputs[index]);
+    }
+}
+
+/* Runs the mode cases: batches of every length up to a few blocks, then
+   of random lengths, then a few messages that span several chunks of the
+   thread pool */
+static void check_modes(uint64_t *state)
+{
+    static const size_t large[] = {
+        FORKAE_POOL_CHUNK_SIZE - 1, FORKAE_POOL_CHUNK_SIZE + 16, 2 * FORKAE_POOL_CHUNK_SIZE + 37
+    };
+    static CheckMessage_t msgs[CHECK_MODE_MESSAGES];
+    uint8_t k[FORKAE_128_384_KEY_SIZE];
+    ForkAE128384Key_t keys[2];
+    ForkAE64192Key_t key64;
+    ForkAEPool_t *pool;
+    size_t index, mlen;
+    unsigned batch;
+
+    check_fill(state, k, sizeof(k));
+    forkae_c_128_384_init_key(&keys[0], k);
+    check_fill(state, k, sizeof(k));
+    forkae_c_128_384_init_key(&keys[1], k);
+    check_fill(state, k, FORKAE_64_192_KEY_SIZE);
+    forkae_c_64_192_init_key(&key64, k);
+    pool = forkae_c_pool_create(CHECK_MODE_THREADS);
+
+    for (batch = 0; batch < CHECK_MODE_SWEEP_BATCHES + CHECK_MODE_BATCHES; ++batch) {
+        for (index = 0; index < CHECK_MODE_MESSAGES; ++index) {
+            if (batch < CHECK_MODE_SWEEP_BATCHES)
+                mlen = batch * CHECK_MODE_MESSAGES + index;
+            else
+                mlen = (size_t)(check_random(state) % (CHECK_MODE_MAX_LEN + 1));
+            check_message(state, &msgs[index], mlen);
+            check_paef_128_384(state, pool, &keys[index & 1], &msgs[index]);
+            check_saef_128_384(state, &keys[index & 1], &msgs[index]);
+        }
+        check_paef_128_384_batch(state, keys, msgs, CHECK_MODE_MESSAGES);
+        check_paef_64_192(state, &key64, msgs, CHECK_MODE_MESSAGES);
+        for (index = 0; index < CHECK_MODE_MESSAGES; ++index) {
+            free(msgs[index].message);
+            free(msgs[index].ciphertext);
+        }
+    }
+
+    for (index = 0; index < sizeof(large) / sizeof(large[0]); ++index) {
+        check_message(state, &msgs[0], large[index]);
+        check_paef_128_384(state, pool, &keys[0], &msgs[0]);
+        free(msgs[0].message);
+        free(msgs[0].ciphertext);
+    }
+
+    forkae_c_pool_destroy(pool);
+}
+
+static void usage(void)
+{
+    fprintf(stderr, "Usage: check.x [-n cases] [-s seed] [-v]\n");
+    exit(2);
+}
+
+int main(int argc, char *argv[])
+{
+    static const unsigned legs[] = {CHECK_BOTH, CHECK_LEFT, CHECK_RIGHT};
+    unsigned long cases = CHECK_DEFAULT_CASES;
+    unsigned long seed = 1;
+    unsigned long posn;
+    const CheckCipher_t *cipher;
+    CheckCase_t c;
+    uint64_t state;
+    unsigned variant, kernel, direction, leg;
+    size_t count;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "n:s:v")) != -1) {
+        switch (opt) {
+        case 'n': cases = strtoul(optarg, 0, 10); break;
+        case 's': seed = strtoul(optarg, 0, 10); break;
+        case 'v': check_verbose = 1; break;
+        default: usage();
+        }
+    }
+    if (optind != argc)
+        usage();
+    state = (uint64_t)seed * 0x9E3779B97F4A7C15ULL + 1;
+
+    for (variant = 0; variant < CHECK_CIPHERS; ++variant)
+        check_kat(&check_kats[variant]);
+
+    /* Every batch size up to a few groups of lanes, at every misalignment */
+    for (variant = 0; variant < CHECK_CIPHERS; ++variant) {
+        cipher = &check_ciphers[variant];
+        for (kernel = 0; kernel < CHECK_KERNELS; ++kernel) {
+            if (kernel == CHECK_MULTIKEY && !cipher->multikey)
+                continue;
+            for (direction = CHECK_ENCRYPT; direction <= CHECK_DECRYPT; ++direction) {
+                for (leg = 0; leg < sizeof(legs) / sizeof(legs[0]); ++leg) {
+                    for (count = 0; count <= CHECK_SWEEP_BLOCKS; ++count) {
+                        memset(&c, 0, sizeof(c));
+                        c.cipher = cipher;
+                        c.kernel = kernel;
+                        c.direction = direction;
+                        c.legs = legs[leg];
+                        c.before = cipher->rounds_before;
+                        c.after = cipher->rounds_after;
+                        c.count = count;
+                        c.offset = (unsigned)(count % 16);
+                        c.in_place = (int)(count & 1);
+                        check_random_case(&state, &c);
+                    }
+                }
+            }
+        }
+    }
+
+    /* Random cases, with random round counts for the reduced kernels */
+    for (posn = 0; posn < cases; ++posn) {
+        memset(&c, 0, sizeof(c));
+        c.cipher = cipher = &check_ciphers[check_random(&state) % CHECK_CIPHERS];
+        c.kernel = (unsigned)(check_random(&state) % CHECK_KERNELS);
+        if (c.kernel == CHECK_MULTIKEY && !cipher->multikey)
+            c.kernel = CHECK_PARALLEL;
+        c.direction = (unsigned)(check_random(&state) & 1);
+        c.legs = legs[check_random(&state) % 3];
+        c.before = cipher->rounds_before;
+        c.after = cipher->rounds_after;
+        if (c.kernel == CHECK_REDUCED && (check_random(&state) & 1)) {
+            c.before = (unsigned)(check_random(&state) % (cipher->max_rounds + 1));
+            c.after = (unsigned)(check_random(&state) % ((cipher->max_rounds - c.before) / 2 + 1));
+        }
+        c.count = (size_t)(check_random(&state) % (CHECK_MAX_BLOCKS + 1));
+        c.offset = (unsigned)(check_random(&state) % 16);
+        c.in_place = (int)(check_random(&state) & 1);
+        check_random_case(&state, &c);
+    }
+
+    check_modes(&state);
+
+    printf("%lu cases, %lu failed\n", check_cases, check_failures);
+    return check_failures ? 1 : 0;
+}
+
+#else /* FORKSKINNY_FUZZ */
+
+#define CHECK_FUZZ_BLOCKS 64
+#define CHECK_FUZZ_HEADER 6
+
+int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size);
+
+/*
+ * Input layout: cipher, flags (bits 0-1 kernel, 2 direction, 3-4 legs,
+ * 5 in place), misalignment, count, rounds before and after the forking
+ * point for the reduced kernels; the remaining bytes are the keys, TK1
+ * and inputs, extended by a generator seeded from the whole input.
+ */
+int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size)
+{
+    static uint8_t material[CHECK_FUZZ_BLOCKS * 4 * FORKSKINNY128_BLOCK_SIZE];
+    const CheckCipher_t *cipher;
+    uint64_t state = 0xCBF29CE484222325ULL;
+    CheckCase_t c;
+    size_t posn;
+
+    if (size < CHECK_FUZZ_HEADER)
+        return 0;
+    for (posn = 0; posn < size; ++posn)
+        state = (state ^ data[posn]) * 0x100000001B3ULL;
+    state |= 1;
+    check_fill(&state, material, sizeof(material));
+    posn = size - CHECK_FUZZ_HEADER;
+    if (posn > sizeof(material))
+        posn = sizeof(material);
+    memcpy(material, data + CHECK_FUZZ_HEADER, posn);
+
+    memset(&c, 0, sizeof(c));
+    c.cipher = cipher = &check_ciphers[data[0] % CHECK_CIPHERS];
+    c.kernel = (data[1] & 3) % CHECK_KERNELS;
+    if (c.kernel == CHECK_MULTIKEY && !cipher->multikey)
+        c.kernel = CHECK_PARALLEL;
+    c.direction = (data[1] >> 2) & 1;
+    c.legs = (data[1] >> 3) & 3;
+    if (!c.legs)
+        c.legs = CHECK_BOTH;
+    c.in_place = (data[1] >> 5) & 1;
+    c.offset = data[2] % 16;
+    c.count = data[3] % (CHECK_FUZZ_BLOCKS + 1);
+    c.before = cipher->rounds_before;
+    c.after = cipher->rounds_after;
+    if (c.kernel == CHECK_REDUCED && data[4] != 0xFF) {
+        c.before = data[4] % (cipher->max_rounds + 1);
+        c.after = data[5] % ((cipher->max_rounds - c.before) / 2 + 1);
+    }
+    c.keys = material;
+    c.tk1 = material + CHECK_FUZZ_BLOCKS * 2 * FORKSKINNY128_BLOCK_SIZE;
+    c.input = c.tk1 + CHECK_FUZZ_BLOCKS * FORKSKINNY128_BLOCK_SIZE;
+    if (check_run(&c))
+        abort();
+    return 0;
+}
+
+#endif /* FORKSKINNY_FUZZ */
@@ -1,8 +1,19 @@
 #include "forkskinny64-cipher.h"
 #include "forkskinny128-cipher.h"
+#include "forkae-paef.h"
+#include "forkae-saef.h"
+#include "forkae-ctr.h"
+#include "forkae-sector.h"
+#include "forkae-pmac.h"
+#include "forkae-pool.h"
+#include "forkae-container.h"
+#include "forkae-ring.h"
+#include "forkskinny-reduced.h"
+#include "forkskinny-stats.h"
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 void print_block(uint8_t *block, unsigned int n) {
   for(unsigned int i=0; i<n; i++)
@@ -36,6 +47,14 @@ void demo_forkskinny_64_192() {
   uint8_t output_left2[FORKSKINNY64_BLOCK_SIZE];
   forkskinny_c_64_192_decrypt(&tk1, &tk23, output_left2, inverse_message, output_right);
 
+  // forward left leg only
+  uint8_t output_left_oneleg[FORKSKINNY64_BLOCK_SIZE];
+  forkskinny_c_64_192_encrypt(&tk1, &tk23, output_left_oneleg, NULL, message);
+
+  // inverse left leg only
+  uint8_t output_left_inverse_oneleg[FORKSKINNY64_BLOCK_SIZE];
+  forkskinny_c_64_192_decrypt(&tk1, &tk23, output_left_inverse_oneleg, NULL, output_right);
+
   printf("Forkskinny-64-192 Forward s=0\n");
   printf("Tweakey: ");
   print_block(key, 3*FORKSKINNY64_BLOCK_SIZE);
@@ -71,6 +90,22 @@ void demo_forkskinny_64_192() {
   print_block(inverse_message, FORKSKINNY64_BLOCK_SIZE);
   printf("\nC1: ");
   print_block(output_left2, FORKSKINNY64_BLOCK_SIZE);
+
+  printf("\n\nForskinny-64-192 Forward s=1\n");
+  printf("Tweakey: ");
+  print_block(key, 3*FORKSKINNY64_BLOCK_SIZE);
+  printf("\nMessage: ");
+  print_block(message, FORKSKINNY64_BLOCK_SIZE);
+  printf("\nC1: ");
+  print_block(output_left_oneleg, FORKSKINNY64_BLOCK_SIZE);
+
+  printf("\n\nForskinny-64-192 Inverse s=o\n");
+  printf("Tweakey: ");
+  print_block(key, 3*FORKSKINNY64_BLOCK_SIZE);
+  printf("\nC0: ");
+  print_block(output_right, FORKSKINNY64_BLOCK_SIZE);
+  printf("\nC1: ");
+  print_block(output_left_inverse_oneleg, FORKSKINNY64_BLOCK_SIZE);
   printf("\n");
 }
 
@@ -101,6 +136,14 @@ void demo_forkskinny_128_256() {
   uint8_t output_left2[FORKSKINNY128_BLOCK_SIZE];
   forkskinny_c_128_256_decrypt(&tk1, &tk2, output_left2, inverse_message, output_right);
 
+  // forward left leg only
+  uint8_t output_left_oneleg[FORKSKINNY128_BLOCK_SIZE];
+  forkskinny_c_128_256_encrypt(&tk1, &tk2, output_left_oneleg, NULL, message);
+
+  // inverse left leg only
+  uint8_t output_left_inverse_oneleg[FORKSKINNY128_BLOCK_SIZE];
+  forkskinny_c_128_256_decrypt(&tk1, &tk2, output_left_inverse_oneleg, NULL, output_right);
+
   printf("\nForkskinny-128-256 Forward s=0\n");
   printf("Tweakey: ");
   print_block(key, 2*FORKSKINNY128_BLOCK_SIZE);
@@ -136,6 +179,22 @@ void demo_forkskinny_128_256() {
   print_block(inverse_message, FORKSKINNY128_BLOCK_SIZE);
   printf("\nC1: ");
   print_block(output_left2, FORKSKINNY128_BLOCK_SIZE);
+
+  printf("\n\nForskinny-128-256 Forward s=1\n");
+  printf("Tweakey: ");
+  print_block(key, 2*FORKSKINNY128_BLOCK_SIZE);
+  printf("\nMessage: ");
+  print_block(message, FORKSKINNY128_BLOCK_SIZE);
+  printf("\nC1: ");
+  print_block(output_left_oneleg, FORKSKINNY128_BLOCK_SIZE);
+
+  printf("\n\nForskinny-128-256 Inverse s=o\n");
+  printf("Tweakey: ");
+  print_block(key, 2*FORKSKINNY128_BLOCK_SIZE);
+  printf("\nC0: ");
+  print_block(output_right, FORKSKINNY128_BLOCK_SIZE);
+  printf("\nC1: ");
+  print_block(output_left_inverse_oneleg, FORKSKINNY128_BLOCK_SIZE);
   printf("\n");
 }
 
@@ -167,6 +226,14 @@ void demo_forkskinny_128_384() {
   uint8_t output_left2[FORKSKINNY128_BLOCK_SIZE];
   forkskinny_c_128_384_decrypt(&tk1, &tk2, &tk3, output_left2, inverse_message, output_right);
 
+  // forward left leg only
+  uint8_t output_left_oneleg[FORKSKINNY128_BLOCK_SIZE];
+  forkskinny_c_128_384_encrypt(&tk1, &tk2, &tk3, output_left_oneleg, NULL, message);
+
+  // inverse left leg only
+  uint8_t output_left_inverse_oneleg[FORKSKINNY128_BLOCK_SIZE];
+  forkskinny_c_128_384_decrypt(&tk1, &tk2, &tk3, output_left_inverse_oneleg, NULL, output_right);
+
   printf("\nForkskinny-128-384 Forward s=0\n");
   printf("Tweakey: ");
   print_block(key, 3*FORKSKINNY128_BLOCK_SIZE);
@@ -202,7 +269,586 @@ void demo_forkskinny_128_384() {
   print_block(inverse_message, FORKSKINNY128_BLOCK_SIZE);
   printf("\nC1: ");
   print_block(output_left2, FORKSKINNY128_BLOCK_SIZE);
+
+  printf("\n\nForskinny-128-384 Forward s=1\n");
+  printf("Tweakey: ");
+  print_block(key, 3*FORKSKINNY128_BLOCK_SIZE);
+  printf("\nMessage: ");
+  print_block(message, FORKSKINNY128_BLOCK_SIZE);
+  printf("\nC1: ");
+  print_block(output_left_oneleg, FORKSKINNY128_BLOCK_SIZE);
+
+  printf("\n\nForskinny-128-384 Inverse s=o\n");
+  printf("Tweakey: ");
+  print_block(key, 3*FORKSKINNY128_BLOCK_SIZE);
+  printf("\nC0: ");
+  print_block(output_right, FORKSKINNY128_BLOCK_SIZE);
+  printf("\nC1: ");
+  print_block(output_left_inverse_oneleg, FORKSKINNY128_BLOCK_SIZE);
+  printf("\n");
+}
+
+void demo_paef_forkskinny_64_192() {
+  uint8_t key[FORKAE_64_192_KEY_SIZE] = {0x29, 0xcd, 0xba, 0xab, 0xf2, 0xfb, 0xe3, 0x46, 0x7c, 0xc2, 0x54, 0xf8, 0x1b, 0xe8, 0xe7, 0x8d};
+  uint8_t nonces[3][FORKAE_PAEF_64_192_NONCE_SIZE] = {{0x00, 0x01, 0x02, 0x03, 0x04, 0x05}, {0x00, 0x01, 0x02, 0x03, 0x04, 0x06}, {0x00, 0x01, 0x02, 0x03, 0x04, 0x07}};
+  uint8_t ad[4] = {0x67, 0xc6, 0x69, 0x73};
+  uint8_t messages[3][12] = {{0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07}, {0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b}, {0x00, 0x01, 0x02}};
+  size_t message_lens[3] = {8, 12, 3};
+  uint8_t ciphertexts[3][FORKAE_PAEF_64_192_CIPHERTEXT_SIZE(12)];
+  uint8_t plaintexts[3][FORKAE_PAEF_64_192_CIPHERTEXT_SIZE(12) - FORKAE_PAEF_64_192_TAG_SIZE];
+  ForkAEMessage_t batch[3];
+  unsigned i;
+
+  // Pre-compute key schedule
+  ForkAE64192Key_t ks;
+  forkae_c_64_192_init_key(&ks, key);
+
+  // encrypt all messages with one call
+  for (i = 0; i < 3; i++) {
+    batch[i].nonce = nonces[i];
+    batch[i].ad = ad;
+    batch[i].adlen = sizeof(ad);
+    batch[i].input = messages[i];
+    batch[i].inlen = message_lens[i];
+    batch[i].output = ciphertexts[i];
+  }
+  forkae_c_paef_64_192_encrypt_many(&ks, batch, 3);
+
+  printf("\nPAEF-Forkskinny-64-192\n");
+  printf("Key: ");
+  print_block(key, FORKAE_64_192_KEY_SIZE);
+  printf("\nAD: ");
+  print_block(ad, sizeof(ad));
+  for (i = 0; i < 3; i++) {
+    printf("\nNonce: ");
+    print_block(nonces[i], FORKAE_PAEF_64_192_NONCE_SIZE);
+    printf("\nMessage: ");
+    print_block(messages[i], message_lens[i]);
+    printf("\nCiphertext: ");
+    print_block(ciphertexts[i], batch[i].outlen);
+  }
+
+  // decrypt all ciphertexts with one call
+  for (i = 0; i < 3; i++) {
+    batch[i].input = ciphertexts[i];
+    batch[i].inlen = batch[i].outlen;
+    batch[i].output = plaintexts[i];
+  }
+  forkae_c_paef_64_192_decrypt_many(&ks, batch, 3);
+
+  for (i = 0; i < 3; i++) {
+    printf("\nDecrypted (%s): ", batch[i].result == 0 ? "valid" : "invalid");
+    print_block(plaintexts[i], batch[i].outlen);
+  }
+  printf("\n");
+}
+
+void demo_paef_forkskinny_128_384() {
+  uint8_t key[FORKAE_128_384_KEY_SIZE] = {0x29, 0xcd, 0xba, 0xab, 0xf2, 0xfb, 0xe3, 0x46, 0x7c, 0xc2, 0x54, 0xf8, 0x1b, 0xe8, 0xe7, 0x8d, 0x76, 0x5a, 0x2e, 0x63, 0x33, 0x9f, 0xc9, 0x9a, 0x66, 0x32, 0x0d, 0xb7, 0x31, 0x58, 0x80, 0x01};
+  uint8_t nonce[FORKAE_PAEF_128_384_NONCE_SIZE] = {0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b};
+  uint8_t ad[20] = {0x67, 0xc6, 0x69, 0x73, 0x51, 0xff, 0x4a, 0xec, 0x29, 0xcd, 0xba, 0xab, 0xf2, 0xfb, 0xe3, 0x46, 0x7c, 0xc2, 0x54, 0xf8};
+  uint8_t message[40] = {0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f, 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f, 0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27};
+
+  // Pre-compute key schedule
+  ForkAE128384Key_t ks;
+  forkae_c_128_384_init_key(&ks, key);
+
+  // encrypt
+  uint8_t ciphertext[FORKAE_PAEF_128_384_CIPHERTEXT_SIZE(sizeof(message))];
+  size_t ciphertext_len;
+  forkae_c_paef_128_384_encrypt(&ks, ciphertext, &ciphertext_len, message, sizeof(message), ad, sizeof(ad), nonce);
+
+  // decrypt
+  uint8_t plaintext[sizeof(ciphertext) - FORKAE_PAEF_128_384_TAG_SIZE];
+  size_t plaintext_len;
+  int result = forkae_c_paef_128_384_decrypt(&ks, plaintext, &plaintext_len, ciphertext, ciphertext_len, ad, sizeof(ad), nonce);
+
+  printf("\nPAEF-Forkskinny-128-384\n");
+  printf("Key: ");
+  print_block(key, FORKAE_128_384_KEY_SIZE);
+  printf("\nNonce: ");
+  print_block(nonce, FORKAE_PAEF_128_384_NONCE_SIZE);
+  printf("\nAD: ");
+  print_block(ad, sizeof(ad));
+  printf("\nMessage: ");
+  print_block(message, sizeof(message));
+  printf("\nCiphertext: ");
+  print_block(ciphertext, ciphertext_len);
+  printf("\nDecrypted (%s): ", result == 0 ? "valid" : "invalid");
+  print_block(plaintext, plaintext_len);
+  printf("\n");
+}
+
+void demo_paef_iov_forkskinny_128_384() {
+  uint8_t key[FORKAE_128_384_KEY_SIZE] = {0x29, 0xcd, 0xba, 0xab, 0xf2, 0xfb, 0xe3, 0x46, 0x7c, 0xc2, 0x54, 0xf8, 0x1b, 0xe8, 0xe7, 0x8d, 0x76, 0x5a, 0x2e, 0x63, 0x33, 0x9f, 0xc9, 0x9a, 0x66, 0x32, 0x0d, 0xb7, 0x31, 0x58, 0x80, 0x01};
+  uint8_t nonce[FORKAE_PAEF_128_384_NONCE_SIZE] = {0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b};
+  uint8_t ad[20] = {0x67, 0xc6, 0x69, 0x73, 0x51, 0xff, 0x4a, 0xec, 0x29, 0xcd, 0xba, 0xab, 0xf2, 0xfb, 0xe3, 0x46, 0x7c, 0xc2, 0x54, 0xf8};
+
+  // The message of the PAEF demo, as a chain of three fragments
+  uint8_t header[5] = {0x00, 0x01, 0x02, 0x03, 0x04};
+  uint8_t payload1[20] = {0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f, 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18};
+  uint8_t payload2[15] = {0x19, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f, 0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27};
+  uint8_t tail[FORKAE_PAEF_128_384_CIPHERTEXT_SIZE(40) - 40];
+  ForkAEIOVec_t ad_iov[1] = {{ad, sizeof(ad)}};
+  ForkAEIOVec_t iov[4] = {{header, sizeof(header)}, {payload1, sizeof(payload1)}, {payload2, sizeof(payload2)}, {tail, sizeof(tail)}};
+
+  // Pre-compute key schedule
+  ForkAE128384Key_t ks;
+  forkae_c_128_384_init_key(&ks, key);
+
+  // encrypt in place; the padding and the tag go to the extra buffer
+  size_t ciphertext_len;
+  forkae_c_paef_128_384_encrypt_iov(&ks, iov, 4, &ciphertext_len, iov, 3, ad_iov, 1, nonce);
+
+  printf("\nPAEF-Forkskinny-128-384 (scatter/gather)\n");
+  printf("Ciphertext: ");
+  print_block(header, sizeof(header));
+  print_block(payload1, sizeof(payload1));
+  print_block(payload2, sizeof(payload2));
+  print_block(tail, sizeof(tail));
+
+  // decrypt in place; only the message is written back
+  size_t plaintext_len;
+  int result = forkae_c_paef_128_384_decrypt_iov(&ks, iov, 4, &plaintext_len, iov, 4, ad_iov, 1, nonce);
+
+  printf("\nDecrypted (%s): ", result == 0 ? "valid" : "invalid");
+  print_block(header, sizeof(header));
+  print_block(payload1, sizeof(payload1));
+  print_block(payload2, sizeof(payload2));
+  printf("\n");
+}
+
+void demo_paef_mb_forkskinny_128_384() {
+  uint8_t key1[FORKAE_128_384_KEY_SIZE] = {0x29, 0xcd, 0xba, 0xab, 0xf2, 0xfb, 0xe3, 0x46, 0x7c, 0xc2, 0x54, 0xf8, 0x1b, 0xe8, 0xe7, 0x8d, 0x76, 0x5a, 0x2e, 0x63, 0x33, 0x9f, 0xc9, 0x9a, 0x66, 0x32, 0x0d, 0xb7, 0x31, 0x58, 0x80, 0x01};
+  uint8_t key2[FORKAE_128_384_KEY_SIZE] = {0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f, 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f};
+  uint8_t nonce[FORKAE_PAEF_128_384_NONCE_SIZE] = {0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b};
+  uint8_t ad[20] = {0x67, 0xc6, 0x69, 0x73, 0x51, 0xff, 0x4a, 0xec, 0x29, 0xcd, 0xba, 0xab, 0xf2, 0xfb, 0xe3, 0x46, 0x7c, 0xc2, 0x54, 0xf8};
+  uint8_t message[40] = {0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f, 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f, 0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27};
+  uint8_t ciphertexts[2][FORKAE_PAEF_128_384_CIPHERTEXT_SIZE(sizeof(message))];
+
+  // Pre-compute key schedules, e.g. of two connections
+  ForkAE128384Key_t ks[2];
+  forkae_c_128_384_init_key(&ks[0], key1);
+  forkae_c_128_384_init_key(&ks[1], key2);
+
+  // submit one job per connection; both are processed in one batch on flush
+  ForkAEPAEF128384Manager_t manager;
+  ForkAEPAEF128384Job_t jobs[2];
+  ForkAEPAEF128384Job_t *job;
+  forkae_c_paef_128_384_mb_init(&manager);
+  for (int i = 0; i < 2; i++) {
+    jobs[i].key = &ks[i];
+    jobs[i].decrypt = 0;
+    jobs[i].message.nonce = nonce;
+    jobs[i].message.ad = ad;
+    jobs[i].message.adlen = sizeof(ad);
+    jobs[i].message.input = message;
+    jobs[i].message.inlen = sizeof(message);
+    jobs[i].message.output = ciphertexts[i];
+    forkae_c_paef_128_384_mb_submit(&manager, &jobs[i]);
+  }
+
+  printf("\nPAEF-Forkskinny-128-384 (job manager)\n");
+  while ((job = forkae_c_paef_128_384_mb_flush(&manager)) != NULL) {
+    printf("Ciphertext (key %d): ", job == &jobs[0] ? 1 : 2);
+    print_block(job->message.output, job->message.outlen);
+    printf("\n");
+  }
+}
+
+void demo_rpaef_forkskinny_128_384() {
+  uint8_t key[FORKAE_128_384_KEY_SIZE] = {0x29, 0xcd, 0xba, 0xab, 0xf2, 0xfb, 0xe3, 0x46, 0x7c, 0xc2, 0x54, 0xf8, 0x1b, 0xe8, 0xe7, 0x8d, 0x76, 0x5a, 0x2e, 0x63, 0x33, 0x9f, 0xc9, 0x9a, 0x66, 0x32, 0x0d, 0xb7, 0x31, 0x58, 0x80, 0x01};
+  uint8_t nonce[FORKAE_PAEF_128_384_NONCE_SIZE] = {0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b};
+  uint8_t ad[20] = {0x67, 0xc6, 0x69, 0x73, 0x51, 0xff, 0x4a, 0xec, 0x29, 0xcd, 0xba, 0xab, 0xf2, 0xfb, 0xe3, 0x46, 0x7c, 0xc2, 0x54, 0xf8};
+  uint8_t message[40] = {0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f, 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f, 0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27};
+
+  // Pre-compute key schedule
+  ForkAE128384Key_t ks;
+  forkae_c_128_384_init_key(&ks, key);
+
+  // encrypt
+  uint8_t ciphertext[FORKAE_PAEF_128_384_CIPHERTEXT_SIZE(sizeof(message))];
+  size_t ciphertext_len;
+  forkae_c_rpaef_128_384_encrypt(&ks, ciphertext, &ciphertext_len, message, sizeof(message), ad, sizeof(ad), nonce);
+
+  // decrypt
+  uint8_t plaintext[sizeof(ciphertext) - FORKAE_PAEF_128_384_TAG_SIZE];
+  size_t plaintext_len;
+  int result = forkae_c_rpaef_128_384_decrypt(&ks, plaintext, &plaintext_len, ciphertext, ciphertext_len, ad, sizeof(ad), nonce);
+
+  printf("\nRPAEF-Forkskinny-128-384\n");
+  printf("Key: ");
+  print_block(key, FORKAE_128_384_KEY_SIZE);
+  printf("\nNonce: ");
+  print_block(nonce, FORKAE_PAEF_128_384_NONCE_SIZE);
+  printf("\nAD: ");
+  print_block(ad, sizeof(ad));
+  printf("\nMessage: ");
+  print_block(message, sizeof(message));
+  printf("\nCiphertext: ");
+  print_block(ciphertext, ciphertext_len);
+  printf("\nDecrypted (%s): ", result == 0 ? "valid" : "invalid");
+  print_block(plaintext, plaintext_len);
+  printf("\n");
+}
+
+void demo_saef_forkskinny_128_256() {
+  uint8_t key[FORKAE_128_256_KEY_SIZE] = {0x29, 0xcd, 0xba, 0xab, 0xf2, 0xfb, 0xe3, 0x46, 0x7c, 0xc2, 0x54, 0xf8, 0x1b, 0xe8, 0xe7, 0x8d};
+  uint8_t nonce[FORKAE_SAEF_128_NONCE_SIZE] = {0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e};
+  uint8_t ad[20] = {0x67, 0xc6, 0x69, 0x73, 0x51, 0xff, 0x4a, 0xec, 0x29, 0xcd, 0xba, 0xab, 0xf2, 0xfb, 0xe3, 0x46, 0x7c, 0xc2, 0x54, 0xf8};
+  uint8_t message[40] = {0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f, 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f, 0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27};
+
+  // Pre-compute key schedule
+  ForkAE128256Key_t ks;
+  forkae_c_128_256_init_key(&ks, key);
+
+  // encrypt the message in chunks of 7 bytes
+  ForkAESAEF128State_t state;
+  uint8_t ciphertext[sizeof(message) + 2*FORKSKINNY128_BLOCK_SIZE];
+  size_t ciphertext_len = 0;
+  size_t pos;
+  forkae_c_saef_128_256_init(&state, &ks, nonce);
+  forkae_c_saef_128_update_ad(&state, ad, sizeof(ad));
+  for (pos = 0; pos < sizeof(message); pos += 7) {
+    size_t chunk = sizeof(message) - pos < 7 ? sizeof(message) - pos : 7;
+    ciphertext_len += forkae_c_saef_128_encrypt_update(&state, ciphertext + ciphertext_len, message + pos, chunk);
+  }
+  ciphertext_len += forkae_c_saef_128_encrypt_final(&state, ciphertext + ciphertext_len);
+
+  // decrypt with one call
+  uint8_t plaintext[sizeof(message)];
+  size_t plaintext_len;
+  int result = forkae_c_saef_128_256_decrypt(&ks, plaintext, &plaintext_len, ciphertext, ciphertext_len, ad, sizeof(ad), nonce);
+
+  printf("\nSAEF-Forkskinny-128-256\n");
+  printf("Key: ");
+  print_block(key, FORKAE_128_256_KEY_SIZE);
+  printf("\nNonce: ");
+  print_block(nonce, FORKAE_SAEF_128_NONCE_SIZE);
+  printf("\nAD: ");
+  print_block(ad, sizeof(ad));
+  printf("\nMessage: ");
+  print_block(message, sizeof(message));
+  printf("\nCiphertext: ");
+  print_block(ciphertext, ciphertext_len);
+  printf("\nDecrypted (%s): ", result == 0 ? "valid" : "invalid");
+  print_block(plaintext, plaintext_len);
+  printf("\n");
+}
+
+void demo_ctr_forkskinny_128_384() {
+  uint8_t key[FORKAE_128_384_KEY_SIZE] = {0x29, 0xcd, 0xba, 0xab, 0xf2, 0xfb, 0xe3, 0x46, 0x7c, 0xc2, 0x54, 0xf8, 0x1b, 0xe8, 0xe7, 0x8d, 0x76, 0x5a, 0x2e, 0x63, 0x33, 0x9f, 0xc9, 0x9a, 0x66, 0x32, 0x0d, 0xb7, 0x31, 0x58, 0x80, 0x01};
+  uint8_t nonce[FORKAE_CTR_128_NONCE_SIZE] = {0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f};
+
+  // Pre-compute key schedule
+  ForkAE128384Key_t ks;
+  forkae_c_128_384_init_key(&ks, key);
+
+  // two counters, i.e. 64 bytes of keystream
+  uint8_t keystream[2*FORKAE_CTR_128_STRIDE];
+  forkae_c_ctr_128_384_keystream(&ks, nonce, 0, keystream, sizeof(keystream));
+
+  // seek into the middle of the keystream
+  uint8_t tail[24];
+  forkae_c_ctr_128_384_keystream(&ks, nonce, sizeof(keystream) - sizeof(tail), tail, sizeof(tail));
+
+  printf("\nCTR-Forkskinny-128-384\n");
+  printf("Key: ");
+  print_block(key, FORKAE_128_384_KEY_SIZE);
+  printf("\nNonce: ");
+  print_block(nonce, FORKAE_CTR_128_NONCE_SIZE);
+  printf("\nKeystream: ");
+  print_block(keystream, sizeof(keystream));
+  printf("\nKeystream at offset %u: ", (unsigned)(sizeof(keystream) - sizeof(tail)));
+  print_block(tail, sizeof(tail));
+  printf("\n");
+}
+
+void demo_ctr_pool_forkskinny_128_256() {
+  uint8_t key[FORKAE_128_256_KEY_SIZE] = {0x29, 0xcd, 0xba, 0xab, 0xf2, 0xfb, 0xe3, 0x46, 0x7c, 0xc2, 0x54, 0xf8, 0x1b, 0xe8, 0xe7, 0x8d};
+  uint8_t nonce[FORKAE_CTR_128_NONCE_SIZE] = {0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f};
+  uint8_t message[20] = {0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f, 0x10, 0x11, 0x12, 0x13};
+
+  // Pre-compute key schedule
+  ForkAE128256Key_t ks;
+  forkae_c_128_256_init_key(&ks, key);
+
+  // fill the pool ahead of time, e.g. while idle
+  static ForkAECTR128Pool_t pool;
+  forkae_c_ctr_128_256_pool_init(&pool, &ks, nonce, 0);
+  size_t filled = forkae_c_ctr_128_256_pool_fill(&pool, 256);
+
+  // a send only XORs precomputed keystream
+  uint8_t ciphertext[sizeof(message)];
+  forkae_c_ctr_128_256_pool_xor(&pool, ciphertext, message, sizeof(message));
+
+  // decrypt without the pool
+  uint8_t plaintext[sizeof(message)];
+  forkae_c_ctr_128_256_xor(&ks, nonce, 0, plaintext, ciphertext, sizeof(ciphertext));
+
+  printf("\nCTR-Forkskinny-128-256 keystream pool (%u bytes pregenerated)\n", (unsigned)filled);
+  printf("Message: ");
+  print_block(message, sizeof(message));
+  printf("\nCiphertext: ");
+  print_block(ciphertext, sizeof(ciphertext));
+  printf("\nDecrypted: ");
+  print_block(plaintext, sizeof(plaintext));
+  printf("\n");
+}
+
+void demo_sector_forkskinny_128_256() {
+  uint8_t key[FORKAE_128_256_KEY_SIZE] = {0x29, 0xcd, 0xba, 0xab, 0xf2, 0xfb, 0xe3, 0x46, 0x7c, 0xc2, 0x54, 0xf8, 0x1b, 0xe8, 0xe7, 0x8d};
+  static uint8_t page[FORKAE_SECTOR_PAGE_SIZE];
+  static uint8_t decrypted[FORKAE_SECTOR_PAGE_SIZE];
+  unsigned i;
+
+  for (i = 0; i < sizeof(page); i++)
+    page[i] = (uint8_t)i;
+
+  // Pre-compute key schedule
+  ForkAE128256Key_t ks;
+  forkae_c_128_256_init_key(&ks, key);
+
+  // encrypt the page in place at logical sector 42, then decrypt it
+  memcpy(decrypted, page, sizeof(page));
+  forkae_c_sector_128_256_encrypt(&ks, 42, decrypted, decrypted, sizeof(decrypted));
+  printf("\nSector-Forkskinny-128-256 (sector 42)\n");
+  printf("First ciphertext blocks: ");
+  print_block(decrypted, 2*FORKAE_SECTOR_BLOCK_SIZE);
+  forkae_c_sector_128_256_decrypt(&ks, 42, decrypted, decrypted, sizeof(decrypted));
+  printf("\nDecrypted page %s\n", memcmp(page, decrypted, sizeof(page)) == 0 ? "matches" : "differs");
+}
+
+void demo_pmac_forkskinny_128_384() {
+  uint8_t key[FORKAE_128_384_KEY_SIZE] = {0x29, 0xcd, 0xba, 0xab, 0xf2, 0xfb, 0xe3, 0x46, 0x7c, 0xc2, 0x54, 0xf8, 0x1b, 0xe8, 0xe7, 0x8d, 0x76, 0x5a, 0x2e, 0x63, 0x33, 0x9f, 0xc9, 0x9a, 0x66, 0x32, 0x0d, 0xb7, 0x31, 0x58, 0x80, 0x01};
+  static uint8_t data[1 << 16];
+  uint8_t tag[FORKAE_PMAC_128_384_TAG_SIZE];
+  uint8_t tag_threaded[FORKAE_PMAC_128_384_TAG_SIZE];
+  unsigned i;
+
+  for (i = 0; i < sizeof(data); i++)
+    data[i] = (uint8_t)i;
+
+  // Pre-compute key schedule
+  ForkAE128384Key_t ks;
+  forkae_c_128_384_init_key(&ks, key);
+
+  forkae_c_pmac_128_384(&ks, tag, data, sizeof(data));
+  forkae_c_pmac_128_384_threaded(&ks, tag_threaded, data, sizeof(data), 4);
+
+  printf("\nPMAC-Forkskinny-128-384 (%u bytes)\n", (unsigned)sizeof(data));
+  printf("Tag: ");
+  print_block(tag, FORKAE_PMAC_128_384_TAG_SIZE);
+  printf("\nTag (4 threads): ");
+  print_block(tag_threaded, FORKAE_PMAC_128_384_TAG_SIZE);
+  printf("\n");
+}
+
+void demo_pool_paef_forkskinny_128_384() {
+  uint8_t key[FORKAE_128_384_KEY_SIZE] = {0x29, 0xcd, 0xba, 0xab, 0xf2, 0xfb, 0xe3, 0x46, 0x7c, 0xc2, 0x54, 0xf8, 0x1b, 0xe8, 0xe7, 0x8d, 0x76, 0x5a, 0x2e, 0x63, 0x33, 0x9f, 0xc9, 0x9a, 0x66, 0x32, 0x0d, 0xb7, 0x31, 0x58, 0x80, 0x01};
+  uint8_t nonce[FORKAE_PAEF_128_384_NONCE_SIZE] = {0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b};
+  size_t len = 4 * FORKAE_POOL_CHUNK_SIZE + 5;
+  uint8_t *message = (uint8_t *)malloc(len);
+  uint8_t *ciphertext = (uint8_t *)malloc(FORKAE_PAEF_128_384_CIPHERTEXT_SIZE(len));
+  size_t ciphertext_len;
+  size_t i;
+
+  for (i = 0; i < len; i++)
+    message[i] = (uint8_t)i;
+
+  // Pre-compute key schedule
+  ForkAE128384Key_t ks;
+  forkae_c_128_384_init_key(&ks, key);
+
+  printf("\nPAEF-Forkskinny-128-384 on a thread pool (%u bytes)\n", (unsigned)len);
+
+  // encrypt on the calling thread only
+  forkae_c_paef_128_384_encrypt(&ks, ciphertext, &ciphertext_len, message, len, NULL, 0, nonce);
+  printf("Tag: ");
+  print_block(ciphertext + ciphertext_len - FORKAE_PAEF_128_384_TAG_SIZE, FORKAE_PAEF_128_384_TAG_SIZE);
+
+  // encrypt with 4 threads
+  ForkAEPool_t *pool = forkae_c_pool_create(4);
+  forkae_c_paef_128_384_encrypt_pool(pool, &ks, ciphertext, &ciphertext_len, message, len, NULL, 0, nonce);
+  printf("\nTag (4 threads): ");
+  print_block(ciphertext + ciphertext_len - FORKAE_PAEF_128_384_TAG_SIZE, FORKAE_PAEF_128_384_TAG_SIZE);
   printf("\n");
+
+  forkae_c_pool_destroy(pool);
+  free(ciphertext);
+  free(message);
+}
+
+void demo_container_forkskinny_128_384() {
+  uint8_t key[FORKAE_128_384_KEY_SIZE] = {0x29, 0xcd, 0xba, 0xab, 0xf2, 0xfb, 0xe3, 0x46, 0x7c, 0xc2, 0x54, 0xf8, 0x1b, 0xe8, 0xe7, 0x8d, 0x76, 0x5a, 0x2e, 0x63, 0x33, 0x9f, 0xc9, 0x9a, 0x66, 0x32, 0x0d, 0xb7, 0x31, 0x58, 0x80, 0x01};
+  uint8_t id[FORKAE_CONTAINER_ID_SIZE] = {0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f};
+  static uint8_t data[100000];
+  uint8_t range[32];
+  unsigned i;
+
+  for (i = 0; i < sizeof(data); i++)
+    data[i] = (uint8_t)i;
+
+  // Pre-compute key schedule
+  ForkAE128384Key_t ks;
+  forkae_c_128_384_init_key(&ks, key);
+
+  // write a container with 4 KiB chunks
+  ForkAEContainer_t writer;
+  forkae_c_container_init(&writer, &ks, id, 12, sizeof(data));
+  size_t stored_len = (size_t)forkae_c_container_size(&writer);
+  uint8_t *stored = (uint8_t *)malloc(stored_len);
+  ForkAEPool_t *pool = forkae_c_pool_create(4);
+  forkae_c_container_write(&writer, pool, stored, data);
+
+  printf("\nContainer on PAEF-Forkskinny-128-384 (%u bytes, %u chunks)\n", (unsigned)sizeof(data), (unsigned)writer.chunks);
+  printf("Tag of chunk 0: ");
+  print_block(stored + forkae_c_container_chunk_offset(&writer, 0) + forkae_c_container_chunk_length(&writer, 0), FORKAE_CONTAINER_TAG_SIZE);
+
+  // read a range across two chunks, then a large range on the pool
+  ForkAEContainer_t reader;
+  forkae_c_container_open(&reader, &ks, stored);
+  forkae_c_container_read(&reader, NULL, stored, stored_len, 4096 - 16, range, sizeof(range));
+  printf("\nRange [4080, 4112): %s\n", memcmp(range, data + 4096 - 16, sizeof(range)) == 0 ? "matches" : "differs");
+  uint8_t *decrypted = (uint8_t *)malloc(sizeof(data));
+  int result = forkae_c_container_read(&reader, pool, stored, stored_len, 1000, decrypted, sizeof(data) - 1000);
+  printf("Range [1000, %u) (4 threads): %s\n", (unsigned)sizeof(data), result == 0 && memcmp(decrypted, data + 1000, sizeof(data) - 1000) == 0 ? "matches" : "differs");
+
+  // a modified chunk fails to verify
+  stored[forkae_c_container_chunk_offset(&reader, 5)] ^= 0x01;
+  result = forkae_c_container_read(&reader, pool, stored, stored_len, 0, decrypted, sizeof(data));
+  printf("Modified chunk: %s\n", result == 0 ? "accepted" : "rejected");
+
+  forkae_c_pool_destroy(pool);
+  free(decrypted);
+  free(stored);
+}
+
+void demo_ring_forkskinny_128_384() {
+  uint8_t key[FORKAE_128_384_KEY_SIZE] = {0x29, 0xcd, 0xba, 0xab, 0xf2, 0xfb, 0xe3, 0x46, 0x7c, 0xc2, 0x54, 0xf8, 0x1b, 0xe8, 0xe7, 0x8d, 0x76, 0x5a, 0x2e, 0x63, 0x33, 0x9f, 0xc9, 0x9a, 0x66, 0x32, 0x0d, 0xb7, 0x31, 0x58, 0x80, 0x01};
+  uint8_t message[] = "Hello across the ring";
+  uint8_t received[64 - FORKAE_RING_SLOT_OVERHEAD];
+  size_t received_len;
+  uint8_t *record;
+
+  // Pre-compute key schedule
+  ForkAE128384Key_t ks;
+  forkae_c_128_384_init_key(&ks, key);
+
+  // the memory would normally be shared between two processes
+  void *memory = malloc(forkae_c_ring_size(4, 64));
+  ForkAERing_t writer, reader;
+  forkae_c_ring_create(&writer, &ks, memory, 4, 64, 1);
+  forkae_c_ring_attach(&reader, &ks, memory, 4, 64, 1);
+
+  // one record copied in, one written in place
+  forkae_c_ring_send(&writer, message, sizeof(message));
+  record = forkae_c_ring_reserve(&writer);
+  memcpy(record, message, 5);
+  forkae_c_ring_commit(&writer, 5);
+
+  printf("\nEncrypted ring on PAEF-Forkskinny-128-384\n");
+  printf("Sealed record 0: ");
+  print_block((uint8_t *)memory + FORKAE_RING_CONTROL_SIZE, FORKAE_PAEF_128_384_CIPHERTEXT_SIZE(sizeof(message)));
+
+  forkae_c_ring_receive(&reader, received, &received_len);
+  printf("\nReceived: %.*s\n", (int)received_len, (char *)received);
+  if (forkae_c_ring_peek(&reader, &record, &received_len) == 1) {
+    printf("Peeked in place: %.*s\n", (int)received_len, (char *)record);
+    forkae_c_ring_release(&reader);
+  }
+  printf("Ring empty: %s\n", forkae_c_ring_receive(&reader, received, &received_len) == 0 ? "yes" : "no");
+
+  free(memory);
+}
+
+void demo_reduced_forkskinny_128_384() {
+  uint8_t key[32] = {0x29, 0xcd, 0xba, 0xab, 0xf2, 0xfb, 0xe3, 0x46, 0x7c, 0xc2, 0x54, 0xf8, 0x1b, 0xe8, 0xe7, 0x8d, 0x76, 0x5a, 0x2e, 0x63, 0x33, 0x9f, 0xc9, 0x9a, 0x66, 0x32, 0x0d, 0xb7, 0x31, 0x58, 0x80, 0x01};
+  uint8_t input_difference[FORKSKINNY128_BLOCK_SIZE] = {0x01};
+  uint8_t output_difference[FORKSKINNY128_BLOCK_SIZE] = {0};
+  uint64_t right_pairs;
+
+  // Pre-compute key schedule
+  ForkSkinny128Key_t ks2, ks3;
+  forkskinny_c_128_384_init_tk2(&ks2, key, FORKSKINNY128_MAX_ROUNDS);
+  forkskinny_c_128_384_init_tk3(&ks3, key + 16, FORKSKINNY128_MAX_ROUNDS);
+
+  // one round: the S-box maps difference 01 to 20 with probability 2^-2,
+  // then the difference is copied into the rows 0, 1 and 3 of column 0
+  output_difference[0] = output_difference[4] = output_difference[12] = 0x20;
+
+  ForkSkinnyDifferential_t experiment;
+  memset(&experiment, 0, sizeof(experiment));
+  experiment.before = 1;
+  experiment.after = 0;
+  experiment.input_difference = input_difference;
+  experiment.right_difference = output_difference;
+  experiment.seed = 1;
+
+  ForkAEPool_t *pool = forkae_c_pool_create(4);
+  forkskinny_c_128_384_differential(pool, &ks2, &ks3, &experiment, 1 << 20, &right_pairs);
+  forkae_c_pool_destroy(pool);
+
+  printf("\nReduced-round Forkskinny-128-384 (1 round, random TK1, 4 threads)\n");
+  printf("Right pairs: %lu of %lu\n", (unsigned long)right_pairs, 1UL << 20);
+}
+
+void demo_boomerang_forkskinny_128_384() {
+  uint8_t key[32] = {0x29, 0xcd, 0xba, 0xab, 0xf2, 0xfb, 0xe3, 0x46, 0x7c, 0xc2, 0x54, 0xf8, 0x1b, 0xe8, 0xe7, 0x8d, 0x76, 0x5a, 0x2e, 0x63, 0x33, 0x9f, 0xc9, 0x9a, 0x66, 0x32, 0x0d, 0xb7, 0x31, 0x58, 0x80, 0x01};
+  uint8_t input_difference[FORKSKINNY128_BLOCK_SIZE] = {0x01};
+  uint8_t output_difference[FORKSKINNY128_BLOCK_SIZE] = {0};
+  uint64_t right_quartets;
+
+  // Pre-compute key schedule
+  ForkSkinny128Key_t ks2, ks3;
+  forkskinny_c_128_384_init_tk2(&ks2, key, FORKSKINNY128_MAX_ROUNDS);
+  forkskinny_c_128_384_init_tk3(&ks3, key + 16, FORKSKINNY128_MAX_ROUNDS);
+
+  // every quartet with differences 01 and 20 comes back through the S-box,
+  // so over two rounds more quartets come back than pairs follow the
+  // one-round differential above
+  output_difference[0] = output_difference[4] = output_difference[12] = 0x20;
+
+  ForkSkinnyBoomerang_t experiment;
+  memset(&experiment, 0, sizeof(experiment));
+  experiment.before = 2;
+  experiment.after = 0;
+  experiment.input_difference = input_difference;
+  experiment.output_difference = output_difference;
+  experiment.seed = 1;
+
+  ForkAEPool_t *pool = forkae_c_pool_create(4);
+  forkskinny_c_128_384_boomerang(pool, &ks2, &ks3, &experiment, 1 << 20, &right_quartets);
+  forkae_c_pool_destroy(pool);
+
+  printf("\nReduced-round Forkskinny-128-384 boomerang (2 rounds, random TK1, 4 threads)\n");
+  printf("Right quartets: %lu of %lu\n", (unsigned long)right_quartets, 1UL << 20);
+}
+
+void demo_stats_forkskinny_128_384() {
+  uint8_t key[FORKAE_128_384_KEY_SIZE] = {0x29, 0xcd, 0xba, 0xab, 0xf2, 0xfb, 0xe3, 0x46, 0x7c, 0xc2, 0x54, 0xf8, 0x1b, 0xe8, 0xe7, 0x8d, 0x76, 0x5a, 0x2e, 0x63, 0x33, 0x9f, 0xc9, 0x9a, 0x66, 0x32, 0x0d, 0xb7, 0x31, 0x58, 0x80, 0x01};
+  uint8_t nonce[FORKAE_PAEF_128_384_NONCE_SIZE] = {0x11, 0x22};
+  uint8_t message[200] = {0};
+  uint8_t ciphertext[FORKAE_PAEF_128_384_CIPHERTEXT_SIZE(sizeof(message))];
+  size_t ciphertext_len;
+  ForkSkinnyStats_t stats;
+
+  printf("\nOperation counters of PAEF-Forkskinny-128-384 (200 bytes)\n");
+  if (!forkskinny_c_stats_enabled()) {
+    printf("Not compiled in (make STATS=1)\n");
+    return;
+  }
+
+  forkskinny_c_stats_reset();
+  ForkAE128384Key_t ks;
+  forkae_c_128_384_init_key(&ks, key);
+  forkae_c_paef_128_384_encrypt(&ks, ciphertext, &ciphertext_len, message, sizeof(message), NULL, 0, nonce);
+  forkskinny_c_stats_snapshot(&stats);
+
+  ForkSkinnyStatsCounts_t *parallel = &stats.ops[FORKSKINNY_STATS_128_384][FORKSKINNY_STATS_ENCRYPT][FORKSKINNY_STATS_PARALLEL];
+  printf("Key schedules: TK2 %lu, TK3 %lu\n", (unsigned long)stats.inits[FORKSKINNY_STATS_128_384][FORKSKINNY_STATS_TK2], (unsigned long)stats.inits[FORKSKINNY_STATS_128_384][FORKSKINNY_STATS_TK3]);
+  printf("Parallel kernel: %lu calls, %lu blocks, %lu left legs, %lu right legs\n", (unsigned long)parallel->calls, (unsigned long)parallel->blocks, (unsigned long)parallel->left_blocks, (unsigned long)parallel->right_blocks);
+  printf("Lane groups: %lu full, %lu partial of %lu lanes\n", (unsigned long)stats.full_groups[FORKSKINNY_STATS_128_384], (unsigned long)stats.partial_groups[FORKSKINNY_STATS_128_384], (unsigned long)stats.lanes[FORKSKINNY_STATS_128_384]);
 }
 
 int main() {
@@ -211,4 +857,35 @@ int main() {
   demo_forkskinny_128_256();
 
   demo_forkskinny_128_384();
+
+  demo_paef_forkskinny_64_192();
+
+  demo_paef_forkskinny_128_384();
+
+  demo_paef_iov_forkskinny_128_384();
+
+  demo_paef_mb_forkskinny_128_384();
+
+  demo_rpaef_forkskinny_128_384();
+
+  demo_saef_forkskinny_128_256();
+
+  demo_ctr_forkskinny_128_384();
+
+  demo_ctr_pool_forkskinny_128_256();
+
+  demo_sector_forkskinny_128_256();
+
+  demo_pmac_forkskinny_128_384();
+
+  demo_pool_paef_forkskinny_128_384();
+
+  demo_container_forkskinny_128_384();
+
+  demo_ring_forkskinny_128_384();
+
+  demo_reduced_forkskinny_128_384();
+  demo_boomerang_forkskinny_128_384();
+
+  demo_stats_forkskinny_128_384();
 }
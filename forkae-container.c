@@ -0,0 +1,315 @@
+#include "forkae-container.h"
+#include "forkskinny128-parallel.h"
+#include "forkae-internal.h"
+#include <stdlib.h>
+
+#define CONTAINER_VERSION 2
+
+static const uint8_t container_magic[4] = {'F', 'k', 'C', 't'};
+
+/* Writes a 64-bit big-endian value */
+STATIC_INLINE void container_write_be64(uint8_t *ptr, uint64_t value)
+{
+    unsigned posn;
+    for (posn = 0; posn < 8; ++posn)
+        ptr[7 - posn] = (uint8_t)(value >> (8 * posn));
+}
+
+/* Reads a 64-bit big-endian value */
+STATIC_INLINE uint64_t container_read_be64(const uint8_t *ptr)
+{
+    uint64_t value = 0;
+    unsigned posn;
+    for (posn = 0; posn < 8; ++posn)
+        value = (value << 8) | ptr[posn];
+    return value;
+}
+
+/* Returns the number of chunks of 2^shift bytes needed for len bytes */
+STATIC_INLINE uint64_t container_chunks(uint64_t len, unsigned shift)
+{
+    return (len >> shift) + ((len & (((uint64_t)1 << shift) - 1)) != 0);
+}
+
+/* Returns a non-zero value if the stored container for length bytes, with
+   its header, padding and tags, would not fit into a uint64_t or size_t */
+static int container_too_large(uint64_t length, unsigned shift)
+{
+#if SIZE_MAX < UINT64_MAX
+    uint64_t limit = SIZE_MAX;
+#else
+    uint64_t limit = UINT64_MAX;
+#endif
+    uint64_t overhead = FORKAE_CONTAINER_HEADER_SIZE +
+                        FORKSKINNY128_BLOCK_SIZE - 1 +
+                        container_chunks(length, shift) *
+                        FORKAE_CONTAINER_TAG_SIZE;
+    return length > limit - overhead;
+}
+
+/* Derives the key of the container and processes the header as associated
+   data; the header is already in container->header */
+static void container_setup
+    (ForkAEContainer_t *container, const ForkAE128384Key_t *key,
+     unsigned shift, uint64_t length)
+{
+    const uint8_t *id = container->header + FORKAE_CONTAINER_HEADER_SIZE -
+                        FORKAE_CONTAINER_ID_SIZE;
+    uint8_t tweak[FORKSKINNY128_BLOCK_SIZE] = {0};
+    uint8_t input[FORKSKINNY128_BLOCK_SIZE] = {0};
+    uint8_t derived[FORKAE_128_384_KEY_SIZE];
+
+    /* Both legs of one forkcipher call. TK1 is a PAEF tweak with a zero
+       block counter, which PAEF never uses, so the derivation cannot
+       collide with a block sealed under the master key: the id fills the
+       nonce, and its last bytes go into the input after the magic. */
+    memcpy(tweak, id, FORKAE_PAEF_128_384_NONCE_SIZE);
+    memcpy(input, container_magic, sizeof(container_magic));
+    memcpy(input + sizeof(container_magic),
+           id + FORKAE_PAEF_128_384_NONCE_SIZE,
+           FORKAE_CONTAINER_ID_SIZE - FORKAE_PAEF_128_384_NONCE_SIZE);
+    forkskinny_c_128_384_encrypt_parallel
+        (tweak, &key->tks2, &key->tks3, derived + FORKSKINNY128_BLOCK_SIZE,
+         derived, input, 1);
+    forkae_c_128_384_init_key(&container->key, derived);
+    memset(derived, 0, sizeof(derived));
+
+    container->length = length;
+    container->chunk_size = (size_t)1 << shift;
+    container->chunks = container_chunks(length, shift);
+    forkae_c_paef_128_384_init_ad
+        (&container->key, &container->ad, container->header,
+         FORKAE_CONTAINER_HEADER_SIZE);
+}
+
+int forkae_c_container_init(ForkAEContainer_t *container, const ForkAE128384Key_t *key, const uint8_t *id, unsigned shift, uint64_t length)
+{
+    uint8_t *header = container->header;
+    if (shift < FORKAE_CONTAINER_MIN_SHIFT || shift > FORKAE_CONTAINER_MAX_SHIFT ||
+            container_too_large(length, shift))
+        return -1;
+    memcpy(header, container_magic, sizeof(container_magic));
+    header[4] = CONTAINER_VERSION;
+    header[5] = (uint8_t)shift;
+    header[6] = 0;
+    header[7] = 0;
+    container_write_be64(header + 8, length);
+    memcpy(header + FORKAE_CONTAINER_HEADER_SIZE - FORKAE_CONTAINER_ID_SIZE,
+           id, FORKAE_CONTAINER_ID_SIZE);
+    container_setup(container, key, shift, length);
+    return 0;
+}
+
+int forkae_c_container_open(ForkAEContainer_t *container, const ForkAE128384Key_t *key, const uint8_t *header)
+{
+    unsigned shift = header[5];
+    uint64_t length = container_read_be64(header + 8);
+    if (memcmp(header, container_magic, sizeof(container_magic)) != 0 ||
+            header[4] != CONTAINER_VERSION || header[6] || header[7] ||
+            shift < FORKAE_CONTAINER_MIN_SHIFT ||
+            shift > FORKAE_CONTAINER_MAX_SHIFT ||
+            container_too_large(length, shift))
+        return -1;
+    memcpy(container->header, header, FORKAE_CONTAINER_HEADER_SIZE);
+    container_setup(container, key, shift, length);
+    return 0;
+}
+
+uint64_t forkae_c_container_size(const ForkAEContainer_t *container)
+{
+    /* Only the last chunk may need padding to whole blocks */
+    uint64_t padded = container->length + FORKSKINNY128_BLOCK_SIZE - 1;
+    padded -= padded % FORKSKINNY128_BLOCK_SIZE;
+    return FORKAE_CONTAINER_HEADER_SIZE + padded +
+           container->chunks * FORKAE_CONTAINER_TAG_SIZE;
+}
+
+uint64_t forkae_c_container_chunk_offset(const ForkAEContainer_t *container, uint64_t index)
+{
+    return FORKAE_CONTAINER_HEADER_SIZE +
+           index * (container->chunk_size + FORKAE_CONTAINER_TAG_SIZE);
+}
+
+size_t forkae_c_container_chunk_length(const ForkAEContainer_t *container, uint64_t index)
+{
+    uint64_t start = index * container->chunk_size;
+    if (index >= container->chunks)
+        return 0;
+    if (container->length - start < container->chunk_size)
+        return (size_t)(container->length - start);
+    return container->chunk_size;
+}
+
+/* The nonce of a chunk is its index */
+STATIC_INLINE void container_nonce(uint8_t *nonce, uint64_t index)
+{
+    memset(nonce, 0, FORKAE_PAEF_128_384_NONCE_SIZE - 8);
+    container_write_be64(nonce + FORKAE_PAEF_128_384_NONCE_SIZE - 8, index);
+}
+
+int forkae_c_container_seal_chunk(const ForkAEContainer_t *container, uint64_t index, uint8_t *output, const uint8_t *input)
+{
+    uint8_t nonce[FORKAE_PAEF_128_384_NONCE_SIZE];
+    size_t clen;
+    if (index >= container->chunks)
+        return -1;
+    container_nonce(nonce, index);
+    return forkae_c_paef_128_384_encrypt_ad
+        (&container->key, &container->ad, output, &clen, input,
+         forkae_c_container_chunk_length(container, index), nonce);
+}
+
+int forkae_c_container_open_chunk(const ForkAEContainer_t *container, uint64_t index, uint8_t *output, const uint8_t *input)
+{
+    uint8_t nonce[FORKAE_PAEF_128_384_NONCE_SIZE];
+    size_t len = forkae_c_container_chunk_length(container, index);
+    size_t mlen;
+    if (index >= container->chunks)
+        return -1;
+    container_nonce(nonce, index);
+    if (forkae_c_paef_128_384_decrypt_ad
+            (&container->key, &container->ad, output, &mlen, input,
+             FORKAE_PAEF_128_384_CIPHERTEXT_SIZE(len), nonce) != 0)
+        return -1;
+    if (mlen != len) {
+        memset(output, 0, mlen);
+        return -1;
+    }
+    return 0;
+}
+
+typedef struct
+{
+    const ForkAEContainer_t *container;
+    uint8_t *output;
+    const uint8_t *input;
+    uint64_t first;
+    int failed;
+
+} ContainerRun_t;
+
+/* Seals chunk first + index of the data into the stored container */
+static void container_seal_run(void *ctx, size_t index, uint8_t *scratch)
+{
+    ContainerRun_t *run = (ContainerRun_t *)ctx;
+    const ForkAEContainer_t *container = run->container;
+    uint64_t chunk = run->first + index;
+    (void)scratch;
+    forkae_c_container_seal_chunk
+        (container, chunk,
+         run->output + forkae_c_container_chunk_offset(container, chunk),
+         run->input + chunk * container->chunk_size);
+}
+
+/* Opens chunk first + index of the stored container, which is entirely
+   within the range that starts with chunk first */
+static void container_open_run(void *ctx, size_t index, uint8_t *scratch)
+{
+    ContainerRun_t *run = (ContainerRun_t *)ctx;
+    const ForkAEContainer_t *container = run->container;
+    uint64_t chunk = run->first + index;
+    if (forkae_c_container_open_chunk
+            (container, chunk, run->output + index * container->chunk_size,
+             run->input + forkae_c_container_chunk_offset(container, chunk)))
+        scratch[0] = 1;
+}
+
+static void container_failed(void *ctx, const uint8_t *scratch)
+{
+    ((ContainerRun_t *)ctx)->failed |= scratch[0];
+}
+
+void forkae_c_container_write(const ForkAEContainer_t *container, ForkAEPool_t *pool, uint8_t *stored, const uint8_t *data)
+{
+    ContainerRun_t run;
+    memcpy(stored, container->header, FORKAE_CONTAINER_HEADER_SIZE);
+    run.container = container;
+    run.output = stored;
+    run.input = data;
+    run.first = 0;
+    run.failed = 0;
+    forkae_pool_run
+        (pool, (size_t)container->chunks, container_seal_run, 0, &run);
+}
+
+/* Opens a chunk that is only partly within the range, or the last chunk,
+   whose padding does not fit into the output */
+static int container_read_partial
+    (const ForkAEContainer_t *container, const uint8_t *stored,
+     uint64_t chunk, size_t skip, uint8_t *output, size_t len,
+     uint8_t **buffer)
+{
+    int result;
+    if (!*buffer) {
+        *buffer = (uint8_t *)malloc(container->chunk_size);
+        if (!*buffer)
+            return -1;
+    }
+    result = forkae_c_container_open_chunk
+        (container, chunk, *buffer,
+         stored + forkae_c_container_chunk_offset(container, chunk));
+    memcpy(output, *buffer + skip, len);
+    return result;
+}
+
+int forkae_c_container_read(const ForkAEContainer_t *container, ForkAEPool_t *pool, const uint8_t *stored, uint64_t stored_len, uint64_t offset, uint8_t *output, size_t len)
+{
+    size_t chunk_size = container->chunk_size;
+    uint8_t *buffer = 0;
+    uint8_t *start = output;
+    size_t total = len;
+    uint64_t chunk;
+    size_t skip, part;
+    int result = 0;
+    ContainerRun_t run;
+
+    /* Every chunk is located from the header, so the whole container must
+       be there before any of it is read */
+    if (forkae_c_container_size(container) > stored_len ||
+            offset > container->length || len > container->length - offset)
+        return -1;
+
+    /* Head of the range, within a single chunk */
+    chunk = offset / chunk_size;
+    skip = (size_t)(offset % chunk_size);
+    if (len > 0 && (skip != 0 || len < chunk_size)) {
+        part = forkae_c_container_chunk_length(container, chunk) - skip;
+        if (part > len)
+            part = len;
+        if (part < forkae_c_container_chunk_length(container, chunk)) {
+            result |= container_read_partial
+                (container, stored, chunk, skip, output, part, &buffer);
+            output += part;
+            len -= part;
+            ++chunk;
+        }
+    }
+
+    /* Full chunks entirely within the range, decrypted in place */
+    run.container = container;
+    run.output = output;
+    run.input = stored;
+    run.first = chunk;
+    run.failed = 0;
+    part = len / chunk_size;
+    forkae_pool_run(pool, part, container_open_run, container_failed, &run);
+    result |= -run.failed;
+    output += part * chunk_size;
+    len -= part * chunk_size;
+
+    /* Tail of the range, within a single chunk */
+    if (len > 0) {
+        result |= container_read_partial
+            (container, stored, chunk + part, 0, output, len, &buffer);
+    }
+
+    if (buffer) {
+        memset(buffer, 0, chunk_size);
+        free(buffer);
+    }
+    if (result != 0) {
+        memset(start, 0, total);
+        return -1;
+    }
+    return 0;
+}
@@ -0,0 +1,168 @@
+#ifndef FORKSKINNY_C_FORKAE_CONTAINER_H
+#define FORKSKINNY_C_FORKAE_CONTAINER_H
+
+#include "forkae-paef.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Seekable encrypted container on PAEF-Forkskinny-128-384.
+ *
+ * A container is a header of FORKAE_CONTAINER_HEADER_SIZE bytes followed by
+ * the data split into chunks of 2^shift bytes (the last one may be
+ * shorter, and is stored padded to whole blocks), each sealed separately
+ * and stored with its tag:
+ *
+ *   bytes 0-3    magic "FkCt"
+ *   byte  4      version (2)
+ *   byte  5      shift
+ *   bytes 6-7    zero
+ *   bytes 8-15   length of the data (64 bits, big-endian)
+ *   bytes 16-31  container id, unique for each container under a key
+ *   then chunk i at offset FORKAE_CONTAINER_HEADER_SIZE + i * (2^shift + FORKAE_CONTAINER_TAG_SIZE)
+ *
+ * As all chunks but the last one have the same size, the header is the
+ * whole index: the position of any byte of the data is computed from it.
+ *
+ * The key of a container is derived from the master key and the container
+ * id (both legs of one forkcipher call), so the chunk index can serve as
+ * the nonce of a chunk. The derivation uses a PAEF tweak with a zero block
+ * counter, which PAEF and RPAEF never use, so the master key may also seal
+ * messages with those modes; it must not be used with other modes (e.g.
+ * CTR or the sector mode, whose tweaks are arbitrary), as an id chosen by
+ * whoever writes the header could then collide with one of their blocks. The header is the associated data of every chunk:
+ * a chunk only verifies at its own position in its own container, and the
+ * length of the data (and hence the number of chunks) is authenticated.
+ *
+ * A byte range is read by decrypting only the chunks it touches; with a
+ * thread pool (see forkae-pool.h), the chunks are decrypted in parallel.
+ */
+
+#define FORKAE_CONTAINER_HEADER_SIZE 32
+
+#define FORKAE_CONTAINER_ID_SIZE 16
+
+#define FORKAE_CONTAINER_TAG_SIZE FORKAE_PAEF_128_384_TAG_SIZE
+
+/** Range of chunk sizes, as powers of two */
+#define FORKAE_CONTAINER_MIN_SHIFT 10
+#define FORKAE_CONTAINER_MAX_SHIFT 24
+
+/**
+ * An open container: the derived key and the parsed header
+ */
+typedef struct
+{
+    /** Key schedules derived for this container */
+    ForkAE128384Key_t key;
+
+    /** The associated data of all chunks (the header), processed once */
+    ForkAEPAEF128384AD_t ad;
+
+    /** The header as stored */
+    uint8_t header[FORKAE_CONTAINER_HEADER_SIZE];
+
+    /** Length of the data */
+    uint64_t length;
+
+    /** Length of a chunk of data */
+    size_t chunk_size;
+
+    /** Number of chunks */
+    uint64_t chunks;
+
+} ForkAEContainer_t;
+
+/**
+ * Starts a new container for data of a given length and writes its header
+ * into container->header.
+ * container: the container to initialize
+ * key:       master key schedules (see forkae_c_128_384_init_key)
+ * id:        pointer to FORKAE_CONTAINER_ID_SIZE bytes; must be unique for each container under the master key, e.g. random
+ * shift:     the chunk size is 2^shift bytes, FORKAE_CONTAINER_MIN_SHIFT <= shift <= FORKAE_CONTAINER_MAX_SHIFT
+ * length:    length of the data
+ * returns:   0 on success, -1 if shift is out of range or the stored container would not fit into a uint64_t or size_t
+ */
+int forkae_c_container_init(ForkAEContainer_t *container, const ForkAE128384Key_t *key, const uint8_t *id, unsigned shift, uint64_t length);
+
+/**
+ * Opens an existing container from its header. The header is authenticated
+ * with every chunk that is read.
+ * container: the container to initialize
+ * key:       master key schedules (see forkae_c_128_384_init_key)
+ * header:    pointer to FORKAE_CONTAINER_HEADER_SIZE bytes; the stored header
+ * returns:   0 on success, -1 if the header is malformed, or its length gives a stored container that would not fit into a uint64_t or size_t
+ */
+int forkae_c_container_open(ForkAEContainer_t *container, const ForkAE128384Key_t *key, const uint8_t *header);
+
+/**
+ * Returns the total size of the stored container, header included.
+ * container: the container
+ */
+uint64_t forkae_c_container_size(const ForkAEContainer_t *container);
+
+/**
+ * Returns the offset of a stored chunk from the start of the container.
+ * container: the container
+ * index:     the index of the chunk
+ */
+uint64_t forkae_c_container_chunk_offset(const ForkAEContainer_t *container, uint64_t index);
+
+/**
+ * Returns the length of the data in a chunk; the stored chunk is
+ * FORKAE_PAEF_128_384_CIPHERTEXT_SIZE(length) bytes long, i.e. the data
+ * padded to whole blocks and the tag.
+ * container: the container
+ * index:     the index of the chunk
+ */
+size_t forkae_c_container_chunk_length(const ForkAEContainer_t *container, uint64_t index);
+
+/**
+ * Seals one chunk.
+ * container: the container
+ * index:     the index of the chunk
+ * output:    pointer to FORKAE_PAEF_128_384_CIPHERTEXT_SIZE(forkae_c_container_chunk_length()) bytes; will contain the stored chunk; may be equal to input
+ * input:     pointer to forkae_c_container_chunk_length() bytes; the data of the chunk
+ * returns:   0 on success, -1 if there is no such chunk
+ */
+int forkae_c_container_seal_chunk(const ForkAEContainer_t *container, uint64_t index, uint8_t *output, const uint8_t *input);
+
+/**
+ * Opens one chunk.
+ * container: the container
+ * index:     the index of the chunk
+ * output:    pointer to FORKAE_PAEF_128_384_CIPHERTEXT_SIZE(forkae_c_container_chunk_length()) - FORKAE_CONTAINER_TAG_SIZE bytes (the length of the data rounded up to whole blocks); will contain the data, or zeroes if verification fails; may be equal to input
+ * input:     pointer to FORKAE_PAEF_128_384_CIPHERTEXT_SIZE(forkae_c_container_chunk_length()) bytes; the stored chunk
+ * returns:   0 on success, -1 if there is no such chunk or it is not authentic
+ */
+int forkae_c_container_open_chunk(const ForkAEContainer_t *container, uint64_t index, uint8_t *output, const uint8_t *input);
+
+/**
+ * Writes a whole container: the header and all sealed chunks.
+ * container: the container (see forkae_c_container_init)
+ * pool:      thread pool to seal the chunks in parallel, or NULL
+ * stored:    pointer to forkae_c_container_size() bytes; will contain the container
+ * data:      pointer to the data of container->length bytes
+ */
+void forkae_c_container_write(const ForkAEContainer_t *container, ForkAEPool_t *pool, uint8_t *stored, const uint8_t *data);
+
+/**
+ * Decrypts a range of the data, reading only the chunks that it touches.
+ * container: the container (see forkae_c_container_open)
+ * pool:      thread pool to open the chunks in parallel, or NULL
+ * stored:    the stored container, e.g. a memory mapping of a file; only the header and the chunks of the range are read
+ * stored_len: length of the stored container, e.g. of the file
+ * offset:    position of the range in the data
+ * output:    pointer to len bytes; will contain the data, or zeroes if verification fails
+ * len:       length of the range
+ * returns:   0 on success, -1 if stored_len is less than forkae_c_container_size(), the range is out of bounds or a chunk is not authentic
+ */
+int forkae_c_container_read(const ForkAEContainer_t *container, ForkAEPool_t *pool, const uint8_t *stored, uint64_t stored_len, uint64_t offset, uint8_t *output, size_t len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // FORKSKINNY_C_FORKAE_CONTAINER_H
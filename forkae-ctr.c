@@ -0,0 +1,246 @@
+#include "forkae-ctr.h"
+#include "forkae-pool.h"
+#include "forkskinny128-parallel.h"
+#include "forkae-internal.h"
+
+#define CTR_128_BLOCK_SIZE FORKSKINNY128_BLOCK_SIZE
+
+/* Offsets shared by the producer and the consumer of a keystream pool */
+#if defined(__GNUC__) || defined(__clang__)
+#define CTR_POOL_LOAD(ptr) __atomic_load_n((ptr), __ATOMIC_ACQUIRE)
+#define CTR_POOL_STORE(ptr, value) __atomic_store_n((ptr), (value), __ATOMIC_RELEASE)
+#else
+#define CTR_POOL_LOAD(ptr) (*(ptr))
+#define CTR_POOL_STORE(ptr, value) (*(ptr) = (value))
+#endif
+
+/* Generates the keystream of count consecutive counters */
+static void ctr_128_generate
+    (const ForkSkinny128Key_t *tks2, const ForkSkinny128Key_t *tks3,
+     const uint8_t *nonce, uint64_t counter, uint8_t *output, size_t count)
+{
+    uint8_t tweaks[FORKAE_PARALLEL_BLOCKS * CTR_128_BLOCK_SIZE];
+    uint8_t input[FORKAE_PARALLEL_BLOCKS * CTR_128_BLOCK_SIZE];
+    uint8_t left[FORKAE_PARALLEL_BLOCKS * CTR_128_BLOCK_SIZE];
+    uint8_t right[FORKAE_PARALLEL_BLOCKS * CTR_128_BLOCK_SIZE];
+    uint8_t *block;
+    size_t index;
+    unsigned posn;
+
+    memset(input, 0, count * CTR_128_BLOCK_SIZE);
+    for (index = 0; index < count; ++index, ++counter) {
+        memcpy(tweaks + index * CTR_128_BLOCK_SIZE, nonce,
+               FORKAE_CTR_128_NONCE_SIZE);
+        block = input + index * CTR_128_BLOCK_SIZE;
+        for (posn = 0; posn < 8; ++posn)
+            block[CTR_128_BLOCK_SIZE - 1 - posn] = (uint8_t)(counter >> (8 * posn));
+    }
+    if (tks3) {
+        forkskinny_c_128_384_encrypt_parallel
+            (tweaks, tks2, tks3, left, right, input, count);
+    } else {
+        forkskinny_c_128_256_encrypt_parallel
+            (tweaks, tks2, left, right, input, count);
+    }
+    for (index = 0; index < count; ++index) {
+        memcpy(output, right + index * CTR_128_BLOCK_SIZE, CTR_128_BLOCK_SIZE);
+        memcpy(output + CTR_128_BLOCK_SIZE, left + index * CTR_128_BLOCK_SIZE,
+               CTR_128_BLOCK_SIZE);
+        output += FORKAE_CTR_128_STRIDE;
+    }
+}
+
+/* XORs the keystream into input, or outputs it if input is NULL */
+static void ctr_128_xor
+    (const ForkSkinny128Key_t *tks2, const ForkSkinny128Key_t *tks3,
+     const uint8_t *nonce, uint64_t offset, uint8_t *output,
+     const uint8_t *input, size_t len)
+{
+    uint8_t stream[FORKAE_PARALLEL_BLOCKS * FORKAE_CTR_128_STRIDE];
+    uint64_t counter = offset / FORKAE_CTR_128_STRIDE;
+    size_t skip = (size_t)(offset % FORKAE_CTR_128_STRIDE);
+    size_t count, size;
+
+    while (len > 0) {
+        count = forkae_blocks(skip + len, FORKAE_CTR_128_STRIDE);
+        if (count > FORKAE_PARALLEL_BLOCKS)
+            count = FORKAE_PARALLEL_BLOCKS;
+        ctr_128_generate(tks2, tks3, nonce, counter, stream, count);
+        size = count * FORKAE_CTR_128_STRIDE - skip;
+        if (size > len)
+            size = len;
+        if (input) {
+            forkae_xor(output, input, stream + skip, size);
+            input += size;
+        } else {
+            memcpy(output, stream + skip, size);
+        }
+        output += size;
+        len -= size;
+        counter += count;
+        skip = 0;
+    }
+}
+
+void forkae_c_ctr_128_256_keystream
+    (const ForkAE128256Key_t *key, const uint8_t *nonce, uint64_t offset,
+     uint8_t *output, size_t len)
+{
+    ctr_128_xor(&key->tks2, NULL, nonce, offset, output, NULL, len);
+}
+
+void forkae_c_ctr_128_256_xor
+    (const ForkAE128256Key_t *key, const uint8_t *nonce, uint64_t offset,
+     uint8_t *output, const uint8_t *input, size_t len)
+{
+    ctr_128_xor(&key->tks2, NULL, nonce, offset, output, input, len);
+}
+
+void forkae_c_ctr_128_384_keystream
+    (const ForkAE128384Key_t *key, const uint8_t *nonce, uint64_t offset,
+     uint8_t *output, size_t len)
+{
+    ctr_128_xor(&key->tks2, &key->tks3, nonce, offset, output, NULL, len);
+}
+
+void forkae_c_ctr_128_384_xor
+    (const ForkAE128384Key_t *key, const uint8_t *nonce, uint64_t offset,
+     uint8_t *output, const uint8_t *input, size_t len)
+{
+    ctr_128_xor(&key->tks2, &key->tks3, nonce, offset, output, input, len);
+}
+
+/* A keystream operation split into chunks for a thread pool */
+typedef struct
+{
+    const ForkSkinny128Key_t *tks2;
+    const ForkSkinny128Key_t *tks3;
+    const uint8_t *nonce;
+    uint64_t offset;
+    uint8_t *output;
+    const uint8_t *input;
+    size_t len;
+
+} CTR128Bulk_t;
+
+static void ctr_128_chunk(void *ctx, size_t index, uint8_t *scratch)
+{
+    const CTR128Bulk_t *bulk = (const CTR128Bulk_t *)ctx;
+    size_t posn = index * FORKAE_POOL_CHUNK_SIZE;
+    size_t size = bulk->len - posn;
+    (void)scratch;
+
+    if (size > FORKAE_POOL_CHUNK_SIZE)
+        size = FORKAE_POOL_CHUNK_SIZE;
+    ctr_128_xor(bulk->tks2, bulk->tks3, bulk->nonce, bulk->offset + posn,
+                bulk->output + posn, bulk->input + posn, size);
+}
+
+static void ctr_128_xor_pool
+    (ForkAEPool_t *pool, const ForkSkinny128Key_t *tks2,
+     const ForkSkinny128Key_t *tks3, const uint8_t *nonce, uint64_t offset,
+     uint8_t *output, const uint8_t *input, size_t len)
+{
+    CTR128Bulk_t bulk;
+    bulk.tks2 = tks2;
+    bulk.tks3 = tks3;
+    bulk.nonce = nonce;
+    bulk.offset = offset;
+    bulk.output = output;
+    bulk.input = input;
+    bulk.len = len;
+    forkae_pool_run
+        (pool, forkae_blocks(len, FORKAE_POOL_CHUNK_SIZE), ctr_128_chunk,
+         NULL, &bulk);
+}
+
+void forkae_c_ctr_128_256_xor_pool
+    (ForkAEPool_t *pool, const ForkAE128256Key_t *key, const uint8_t *nonce,
+     uint64_t offset, uint8_t *output, const uint8_t *input, size_t len)
+{
+    ctr_128_xor_pool(pool, &key->tks2, NULL, nonce, offset, output, input, len);
+}
+
+void forkae_c_ctr_128_384_xor_pool
+    (ForkAEPool_t *pool, const ForkAE128384Key_t *key, const uint8_t *nonce,
+     uint64_t offset, uint8_t *output, const uint8_t *input, size_t len)
+{
+    ctr_128_xor_pool
+        (pool, &key->tks2, &key->tks3, nonce, offset, output, input, len);
+}
+
+void forkae_c_ctr_128_256_pool_init
+    (ForkAECTR128Pool_t *pool, const ForkAE128256Key_t *key,
+     const uint8_t *nonce, uint64_t offset)
+{
+    pool->tks2 = &key->tks2;
+    memcpy(pool->nonce, nonce, FORKAE_CTR_128_NONCE_SIZE);
+    pool->head = offset;
+    pool->tail = offset;
+}
+
+size_t forkae_c_ctr_128_256_pool_fill(ForkAECTR128Pool_t *pool, size_t max)
+{
+    uint64_t head = pool->head;
+    uint64_t tail;
+    size_t generated = 0;
+    size_t posn, size;
+
+    while (generated < max) {
+        /* Skip the keystream the consumer generated itself */
+        tail = CTR_POOL_LOAD(&pool->tail);
+        if (head < tail)
+            head = tail;
+        if (head - tail >= FORKAE_CTR_128_POOL_SIZE)
+            break;
+
+        /* Publish the keystream in chunks of one batch of the kernel */
+        posn = (size_t)(head % FORKAE_CTR_128_POOL_SIZE);
+        size = FORKAE_CTR_128_POOL_SIZE - (size_t)(head - tail);
+        if (size > FORKAE_CTR_128_POOL_SIZE - posn)
+            size = FORKAE_CTR_128_POOL_SIZE - posn;
+        if (size > FORKAE_PARALLEL_BLOCKS * FORKAE_CTR_128_STRIDE)
+            size = FORKAE_PARALLEL_BLOCKS * FORKAE_CTR_128_STRIDE;
+        if (size > max - generated)
+            size = max - generated;
+        ctr_128_xor(pool->tks2, NULL, pool->nonce, head, pool->ring + posn,
+                    NULL, size);
+        head += size;
+        generated += size;
+        CTR_POOL_STORE(&pool->head, head);
+    }
+    return generated;
+}
+
+void forkae_c_ctr_128_256_pool_xor
+    (ForkAECTR128Pool_t *pool, uint8_t *output, const uint8_t *input,
+     size_t len)
+{
+    uint64_t head = CTR_POOL_LOAD(&pool->head);
+    uint64_t tail = pool->tail;
+    size_t available = head > tail ? (size_t)(head - tail) : 0;
+    size_t posn, size;
+
+    /* Precomputed keystream first */
+    if (available > len)
+        available = len;
+    while (available > 0) {
+        posn = (size_t)(tail % FORKAE_CTR_128_POOL_SIZE);
+        size = FORKAE_CTR_128_POOL_SIZE - posn;
+        if (size > available)
+            size = available;
+        forkae_xor(output, input, pool->ring + posn, size);
+        output += size;
+        input += size;
+        tail += size;
+        len -= size;
+        available -= size;
+    }
+
+    /* The pool ran dry: generate the rest on the spot */
+    if (len > 0) {
+        ctr_128_xor(pool->tks2, NULL, pool->nonce, tail, output, input, len);
+        tail += len;
+    }
+    CTR_POOL_STORE(&pool->tail, tail);
+}
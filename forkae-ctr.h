@@ -0,0 +1,159 @@
+#ifndef FORKSKINNY_C_FORKAE_CTR_H
+#define FORKSKINNY_C_FORKAE_CTR_H
+
+#include "forkae.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Counter mode keystream using both legs of the forkcipher.
+ *
+ * The tweak TK1 is the nonce and the input block is the counter (64 bits,
+ * big-endian, in the last 8 bytes). Each counter yields
+ * FORKAE_CTR_128_STRIDE bytes of keystream: the right leg followed by the
+ * left leg, so the rounds before the forking point are shared by two blocks.
+ * The keystream is seekable: byte offset o belongs to counter
+ * o / FORKAE_CTR_128_STRIDE.
+ *
+ * This mode provides confidentiality only. A nonce must not be used twice
+ * under a key for overlapping ranges of the keystream.
+ */
+
+#define FORKAE_CTR_128_NONCE_SIZE FORKSKINNY128_BLOCK_SIZE
+
+/** Number of keystream bytes per counter value */
+#define FORKAE_CTR_128_STRIDE (2*FORKSKINNY128_BLOCK_SIZE)
+
+/**
+ * Generates keystream bytes with Forkskinny-128-256.
+ * key:     key schedule (see forkae_c_128_256_init_key)
+ * nonce:   pointer to FORKAE_CTR_128_NONCE_SIZE bytes
+ * offset:  position of the first byte in the keystream
+ * output:  pointer to len bytes; will contain the keystream
+ * len:     number of bytes to generate
+ */
+void forkae_c_ctr_128_256_keystream(const ForkAE128256Key_t *key, const uint8_t *nonce, uint64_t offset, uint8_t *output, size_t len);
+
+/**
+ * Encrypts or decrypts with the Forkskinny-128-256 keystream.
+ * key:     key schedule (see forkae_c_128_256_init_key)
+ * nonce:   pointer to FORKAE_CTR_128_NONCE_SIZE bytes
+ * offset:  position of the first byte in the keystream
+ * output:  pointer to len bytes; will contain the input XORed with the keystream; may be equal to input
+ * input:   pointer to len bytes; the plaintext or ciphertext
+ * len:     length of the input
+ */
+void forkae_c_ctr_128_256_xor(const ForkAE128256Key_t *key, const uint8_t *nonce, uint64_t offset, uint8_t *output, const uint8_t *input, size_t len);
+
+/**
+ * Generates keystream bytes with Forkskinny-128-384.
+ * key:     key schedules (see forkae_c_128_384_init_key)
+ * nonce:   pointer to FORKAE_CTR_128_NONCE_SIZE bytes
+ * offset:  position of the first byte in the keystream
+ * output:  pointer to len bytes; will contain the keystream
+ * len:     number of bytes to generate
+ */
+void forkae_c_ctr_128_384_keystream(const ForkAE128384Key_t *key, const uint8_t *nonce, uint64_t offset, uint8_t *output, size_t len);
+
+/**
+ * Encrypts or decrypts with the Forkskinny-128-384 keystream.
+ * key:     key schedules (see forkae_c_128_384_init_key)
+ * nonce:   pointer to FORKAE_CTR_128_NONCE_SIZE bytes
+ * offset:  position of the first byte in the keystream
+ * output:  pointer to len bytes; will contain the input XORed with the keystream; may be equal to input
+ * input:   pointer to len bytes; the plaintext or ciphertext
+ * len:     length of the input
+ */
+void forkae_c_ctr_128_384_xor(const ForkAE128384Key_t *key, const uint8_t *nonce, uint64_t offset, uint8_t *output, const uint8_t *input, size_t len);
+
+/**
+ * Encrypts or decrypts a large buffer with the Forkskinny-128-256 keystream,
+ * in chunks spread over the threads of a pool (see forkae-pool.h). The
+ * result is the same as for forkae_c_ctr_128_256_xor.
+ * pool:    the thread pool; if NULL, the calling thread does all the work
+ * Other parameters as for forkae_c_ctr_128_256_xor.
+ */
+void forkae_c_ctr_128_256_xor_pool(ForkAEPool_t *pool, const ForkAE128256Key_t *key, const uint8_t *nonce, uint64_t offset, uint8_t *output, const uint8_t *input, size_t len);
+
+/**
+ * Encrypts or decrypts a large buffer with the Forkskinny-128-384 keystream,
+ * in chunks spread over the threads of a pool (see forkae-pool.h). The
+ * result is the same as for forkae_c_ctr_128_384_xor.
+ * pool:    the thread pool; if NULL, the calling thread does all the work
+ * Other parameters as for forkae_c_ctr_128_384_xor.
+ */
+void forkae_c_ctr_128_384_xor_pool(ForkAEPool_t *pool, const ForkAE128384Key_t *key, const uint8_t *nonce, uint64_t offset, uint8_t *output, const uint8_t *input, size_t len);
+
+/*
+ * Keystream pool: a bounded ring buffer of future Forkskinny-128-256
+ * keystream. One producer fills it ahead of time, from a helper thread or
+ * in idle time, with forkae_c_ctr_128_256_pool_fill, while one consumer
+ * XORs the precomputed bytes into its messages with
+ * forkae_c_ctr_128_256_pool_xor. If the pool runs dry, the consumer
+ * generates the missing keystream itself, so no call ever blocks.
+ *
+ * The producer and the consumer may run on different threads (this needs
+ * the atomic builtins of GCC/clang); several producers or several consumers
+ * must not run at the same time.
+ */
+
+#ifndef FORKAE_CTR_128_POOL_SIZE
+#define FORKAE_CTR_128_POOL_SIZE 4096
+#endif
+
+/**
+ * Keystream pool for Forkskinny-128-256. The key must stay valid while the
+ * pool is in use.
+ */
+typedef struct
+{
+    /** Key schedule for TK2 */
+    const ForkSkinny128Key_t *tks2;
+
+    /** The nonce of the keystream */
+    uint8_t nonce[FORKAE_CTR_128_NONCE_SIZE];
+
+    /** Keystream offset up to which the ring is filled; written by the producer */
+    uint64_t head;
+
+    /** Keystream offset of the next byte to consume; written by the consumer */
+    uint64_t tail;
+
+    /** Keystream byte at offset o is at ring[o % FORKAE_CTR_128_POOL_SIZE] */
+    uint8_t ring[FORKAE_CTR_128_POOL_SIZE];
+
+} ForkAECTR128Pool_t;
+
+/**
+ * Initializes an empty keystream pool.
+ * pool:    the pool to initialize
+ * key:     key schedule (see forkae_c_128_256_init_key)
+ * nonce:   pointer to FORKAE_CTR_128_NONCE_SIZE bytes
+ * offset:  keystream offset of the first byte to consume
+ */
+void forkae_c_ctr_128_256_pool_init(ForkAECTR128Pool_t *pool, const ForkAE128256Key_t *key, const uint8_t *nonce, uint64_t offset);
+
+/**
+ * Generates keystream into the free space of the pool (producer side).
+ * pool:    the pool
+ * max:     upper bound on the number of bytes to generate, to bound the time spent
+ * returns: the number of bytes generated; 0 if the pool is full
+ */
+size_t forkae_c_ctr_128_256_pool_fill(ForkAECTR128Pool_t *pool, size_t max);
+
+/**
+ * Encrypts or decrypts with the next len bytes of keystream (consumer side).
+ * pool:    the pool
+ * output:  pointer to len bytes; will contain the input XORed with the keystream; may be equal to input
+ * input:   pointer to len bytes; the plaintext or ciphertext
+ * len:     length of the input
+ */
+void forkae_c_ctr_128_256_pool_xor(ForkAECTR128Pool_t *pool, uint8_t *output, const uint8_t *input, size_t len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // FORKSKINNY_C_FORKAE_CTR_H
@@ -0,0 +1,111 @@
+#ifndef FORKSKINNY_C_FORKAE_INTERNAL_H
+#define FORKSKINNY_C_FORKAE_INTERNAL_H
+
+#include "forkskinny-internal.h"
+#include "forkae.h"
+
+/* Number of blocks handed to the parallel kernels at once by the modes */
+#define FORKAE_PARALLEL_BLOCKS 16
+
+/* Domain separation flags of the PAEF tweak */
+#define FORKAE_FLAG_AD              0x0 /* AD block, not the last one */
+#define FORKAE_FLAG_AD_LAST         0x2 /* last AD block, full, M not empty */
+#define FORKAE_FLAG_AD_LAST_PAD     0x6 /* last AD block, padded, M not empty */
+#define FORKAE_FLAG_AD_FINAL        0x3 /* last AD block, full, M empty */
+#define FORKAE_FLAG_AD_FINAL_PAD    0x7 /* last AD block, padded, M empty */
+#define FORKAE_FLAG_M               0x4 /* M block, not the last one */
+#define FORKAE_FLAG_M_LAST          0x1 /* last M block, full */
+#define FORKAE_FLAG_M_LAST_PAD      0x5 /* last M block, padded */
+
+/* Returns the number of blocks of size bytes needed for len bytes */
+STATIC_INLINE size_t forkae_blocks(size_t len, size_t size)
+{
+    return len / size + (len % size != 0);
+}
+
+/* Copies len < size bytes into a block of size bytes with 10* padding */
+STATIC_INLINE void forkae_pad
+    (uint8_t *block, const uint8_t *data, size_t len, size_t size)
+{
+    if (len > 0)
+        memcpy(block, data, len);
+    block[len] = 0x80;
+    memset(block + len + 1, 0, size - len - 1);
+}
+
+/* XORs count consecutive blocks of size bytes into the tag */
+STATIC_INLINE void forkae_absorb
+    (uint8_t *tag, const uint8_t *blocks, size_t count, size_t size)
+{
+    for (; count > 0; --count, blocks += size)
+        skinny_xor(tag, tag, blocks, size);
+}
+
+/* XORs len bytes of two buffers, a 128-bit block at a time */
+STATIC_INLINE void forkae_xor
+    (uint8_t *output, const uint8_t *input1, const uint8_t *input2, size_t len)
+{
+    for (; len >= 16; len -= 16, output += 16, input1 += 16, input2 += 16)
+        skinny128_xor(output, input1, input2);
+    skinny_xor(output, input1, input2, len);
+}
+
+/* Returns a non-zero value in constant time if the first len bytes differ */
+STATIC_INLINE uint8_t forkae_compare
+    (const uint8_t *a, const uint8_t *b, size_t len)
+{
+    uint8_t diff = 0;
+    while (len > 0) {
+        --len;
+        diff |= a[len] ^ b[len];
+    }
+    return diff;
+}
+
+/* Returns a non-zero value in constant time if block[len..size) is not
+   the 10* padding written by forkae_pad() */
+STATIC_INLINE uint8_t forkae_check_pad
+    (const uint8_t *block, size_t len, size_t size)
+{
+    uint8_t diff = block[len] ^ 0x80;
+    while (++len < size)
+        diff |= block[len];
+    return diff;
+}
+
+/* Finds, in constant time, the length of the data in a block of size bytes
+   padded by forkae_pad(); returns a non-zero value if the block does not
+   end in 10* padding */
+STATIC_INLINE uint8_t forkae_unpad
+    (const uint8_t *block, size_t size, size_t *len)
+{
+    uint8_t seen = 0;
+    uint8_t diff = 0;
+    uint8_t here;
+    size_t index = size;
+    *len = 0;
+    while (index > 0) {
+        --index;
+        /* here is 0xFF at the last non-zero byte, 0 elsewhere */
+        here = (uint8_t)((block[index] | (uint8_t)-block[index]) >> 7);
+        here = (uint8_t)-(here & (seen ^ 1));
+        diff |= here & (block[index] ^ 0x80);
+        *len |= index & (size_t)-(size_t)(here & 1);
+        seen |= here & 1;
+    }
+    return diff | (seen ^ 1);
+}
+
+/* Per-thread scratch space of a pool run, e.g. for a partial tag */
+#define FORKAE_POOL_SCRATCH_SIZE 64
+
+/* Runs chunk(ctx, index, scratch) for every index in [0, count) on the
+   threads of the pool, or on the calling thread if pool is NULL. Every
+   thread has its own scratch, zeroed before the run; afterwards combine
+   (if not NULL) is called with the scratch of each thread in turn. */
+void forkae_pool_run
+    (ForkAEPool_t *pool, size_t count,
+     void (*chunk)(void *ctx, size_t index, uint8_t *scratch),
+     void (*combine)(void *ctx, const uint8_t *scratch), void *ctx);
+
+#endif // FORKSKINNY_C_FORKAE_INTERNAL_H
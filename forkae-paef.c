@@ -0,0 +1,1261 @@
+#include "forkae-paef.h"
+#include "forkae-pool.h"
+#include "forkskinny64-parallel.h"
+#include "forkskinny128-parallel.h"
+#include "forkae-internal.h"
+
+#define PAEF_128_384_BLOCK_SIZE FORKSKINNY128_BLOCK_SIZE
+
+#define PAEF_PHASE_AD        0
+#define PAEF_PHASE_ENCRYPT   1
+#define PAEF_PHASE_DECRYPT   2
+
+/* Fills the nonce into every tweak of the batch */
+static void paef_128_384_init_tweaks(uint8_t *tweaks, const uint8_t *nonce)
+{
+    unsigned index;
+    for (index = 0; index < FORKAE_PARALLEL_BLOCKS; ++index) {
+        memcpy(tweaks + index * PAEF_128_384_BLOCK_SIZE, nonce,
+               FORKAE_PAEF_128_384_NONCE_SIZE);
+    }
+}
+
+/* Writes the flags and consecutive counters into count tweaks of the batch */
+static void paef_128_384_set_counters
+    (uint8_t *tweaks, unsigned flags, size_t counter, size_t count)
+{
+    uint32_t value = ((uint32_t)flags << 29) | (uint32_t)counter;
+    tweaks += FORKAE_PAEF_128_384_NONCE_SIZE;
+    for (; count > 0; --count, ++value, tweaks += PAEF_128_384_BLOCK_SIZE) {
+        tweaks[0] = (uint8_t)(value >> 24);
+        tweaks[1] = (uint8_t)(value >> 16);
+        tweaks[2] = (uint8_t)(value >> 8);
+        tweaks[3] = (uint8_t)value;
+    }
+}
+
+/* Position in a scatter/gather list */
+typedef struct
+{
+    const ForkAEIOVec_t *iov;
+    size_t count;
+    size_t offset;
+
+} PAEFCursor_t;
+
+static void paef_cursor_init
+    (PAEFCursor_t *cursor, const ForkAEIOVec_t *iov, size_t count)
+{
+    cursor->iov = iov;
+    cursor->count = count;
+    cursor->offset = 0;
+}
+
+/* Returns the total length of a scatter/gather list */
+static size_t paef_iov_length(const ForkAEIOVec_t *iov, size_t count)
+{
+    size_t len = 0;
+    for (; count > 0; --count, ++iov)
+        len += iov->iov_len;
+    return len;
+}
+
+/* Returns the bytes at the cursor and, in len, how many of them are
+   contiguous; empty buffers are skipped */
+static uint8_t *paef_cursor_peek(PAEFCursor_t *cursor, size_t *len)
+{
+    while (cursor->count > 0 && cursor->offset == cursor->iov->iov_len) {
+        ++(cursor->iov);
+        --(cursor->count);
+        cursor->offset = 0;
+    }
+    if (cursor->count == 0) {
+        *len = 0;
+        return NULL;
+    }
+    *len = cursor->iov->iov_len - cursor->offset;
+    return (uint8_t *)cursor->iov->iov_base + cursor->offset;
+}
+
+/* Copies len bytes out of the list, across buffer boundaries */
+static void paef_cursor_read(PAEFCursor_t *cursor, uint8_t *data, size_t len)
+{
+    const uint8_t *ptr;
+    size_t size;
+    while (len > 0) {
+        ptr = paef_cursor_peek(cursor, &size);
+        if (size > len)
+            size = len;
+        memcpy(data, ptr, size);
+        cursor->offset += size;
+        data += size;
+        len -= size;
+    }
+}
+
+/* Copies len bytes into the list, or zeroes if data is NULL */
+static void paef_cursor_write
+    (PAEFCursor_t *cursor, const uint8_t *data, size_t len)
+{
+    uint8_t *ptr;
+    size_t size;
+    while (len > 0) {
+        ptr = paef_cursor_peek(cursor, &size);
+        if (size > len)
+            size = len;
+        if (data) {
+            memcpy(ptr, data, size);
+            data += size;
+        } else {
+            memset(ptr, 0, size);
+        }
+        cursor->offset += size;
+        len -= size;
+    }
+}
+
+/* Processes the next count blocks of a scatter/gather list with the kernel
+   (in the direction of phase), directly in the buffers where the blocks are
+   contiguous in both lists, otherwise through a staging buffer. Returns the
+   number of blocks processed, at least one. */
+static size_t paef_128_384_iov_blocks
+    (const ForkAE128384Key_t *key, unsigned phase, uint8_t *tweaks,
+     unsigned flags, size_t counter, uint8_t *legs, PAEFCursor_t *out,
+     PAEFCursor_t *in, size_t count)
+{
+    uint8_t stage[FORKAE_PARALLEL_BLOCKS * PAEF_128_384_BLOCK_SIZE];
+    const uint8_t *input;
+    uint8_t *output = NULL;
+    size_t inlen, outlen, direct;
+
+    if (count > FORKAE_PARALLEL_BLOCKS)
+        count = FORKAE_PARALLEL_BLOCKS;
+    input = paef_cursor_peek(in, &inlen);
+    direct = inlen;
+    if (out) {
+        output = paef_cursor_peek(out, &outlen);
+        if (direct > outlen)
+            direct = outlen;
+    }
+    direct /= PAEF_128_384_BLOCK_SIZE;
+    if (direct > 0) {
+        if (count > direct)
+            count = direct;
+        in->offset += count * PAEF_128_384_BLOCK_SIZE;
+        if (out)
+            out->offset += count * PAEF_128_384_BLOCK_SIZE;
+    } else {
+        /* A block straddles two buffers */
+        paef_cursor_read(in, stage, count * PAEF_128_384_BLOCK_SIZE);
+        input = stage;
+        output = out ? stage : NULL;
+    }
+    paef_128_384_set_counters(tweaks, flags, counter, count);
+    if (phase == PAEF_PHASE_DECRYPT) {
+        forkskinny_c_128_384_decrypt_parallel
+            (tweaks, &key->tks2, &key->tks3, legs, output, input, count);
+    } else {
+        forkskinny_c_128_384_encrypt_parallel
+            (tweaks, &key->tks2, &key->tks3, legs, output, input, count);
+    }
+    if (direct == 0 && out)
+        paef_cursor_write(out, stage, count * PAEF_128_384_BLOCK_SIZE);
+    return count;
+}
+
+static int paef_128_384_init_ad_iov
+    (const ForkAE128384Key_t *key, ForkAEPAEF128384AD_t *state,
+     PAEFCursor_t *ad, size_t adlen)
+{
+    uint8_t tweaks[FORKAE_PARALLEL_BLOCKS * PAEF_128_384_BLOCK_SIZE];
+    uint8_t legs[FORKAE_PARALLEL_BLOCKS * PAEF_128_384_BLOCK_SIZE];
+    size_t counter = 1;
+    size_t count;
+
+    if (forkae_blocks(adlen, PAEF_128_384_BLOCK_SIZE) > FORKAE_PAEF_128_384_MAX_BLOCKS)
+        return -1;
+
+    /* All blocks but the last one, with a zero nonce */
+    memset(tweaks, 0, sizeof(tweaks));
+    memset(state->sum, 0, PAEF_128_384_BLOCK_SIZE);
+    while (adlen > PAEF_128_384_BLOCK_SIZE) {
+        count = paef_128_384_iov_blocks
+            (key, PAEF_PHASE_AD, tweaks, FORKAE_FLAG_AD, counter, legs, NULL,
+             ad, (adlen - 1) / PAEF_128_384_BLOCK_SIZE);
+        forkae_absorb(state->sum, legs, count, PAEF_128_384_BLOCK_SIZE);
+        adlen -= count * PAEF_128_384_BLOCK_SIZE;
+        counter += count;
+    }
+
+    /* The last block depends on the nonce and is kept for later */
+    paef_cursor_read(ad, state->last, adlen);
+    state->lastlen = (unsigned)adlen;
+    state->counter = counter;
+    return 0;
+}
+
+int forkae_c_paef_128_384_init_ad
+    (const ForkAE128384Key_t *key, ForkAEPAEF128384AD_t *state,
+     const uint8_t *ad, size_t adlen)
+{
+    ForkAEIOVec_t iov;
+    PAEFCursor_t cursor;
+    iov.iov_base = (void *)ad;
+    iov.iov_len = adlen;
+    paef_cursor_init(&cursor, &iov, 1);
+    return paef_128_384_init_ad_iov(key, state, &cursor, adlen);
+}
+
+/* Starts the tag from the associated data midstate, adding the last block */
+static void paef_128_384_finish_ad
+    (const ForkAE128384Key_t *key, uint8_t *tweaks, uint8_t *tag,
+     const ForkAEPAEF128384AD_t *state, int final)
+{
+    uint8_t legs[PAEF_128_384_BLOCK_SIZE];
+    uint8_t block[PAEF_128_384_BLOCK_SIZE];
+    unsigned flags;
+
+    memcpy(tag, state->sum, PAEF_128_384_BLOCK_SIZE);
+
+    /* An empty message is authenticated by the associated data alone,
+       which then consists of at least one (padded) block */
+    if (state->lastlen == 0 && !final)
+        return;
+    if (state->lastlen == PAEF_128_384_BLOCK_SIZE) {
+        memcpy(block, state->last, PAEF_128_384_BLOCK_SIZE);
+        flags = final ? FORKAE_FLAG_AD_FINAL : FORKAE_FLAG_AD_LAST;
+    } else {
+        forkae_pad(block, state->last, state->lastlen, PAEF_128_384_BLOCK_SIZE);
+        flags = final ? FORKAE_FLAG_AD_FINAL_PAD : FORKAE_FLAG_AD_LAST_PAD;
+    }
+    paef_128_384_set_counters(tweaks, flags, state->counter, 1);
+    forkskinny_c_128_384_encrypt_parallel
+        (tweaks, &key->tks2, &key->tks3, legs, NULL, block, 1);
+    forkae_absorb(tag, legs, 1, PAEF_128_384_BLOCK_SIZE);
+}
+
+/* Encrypts mlen bytes of m into c; both lists are long enough. The first
+   block of m has the given counter; sum (if not NULL) is the XOR of the
+   left legs of the message blocks before it, processed elsewhere. */
+static void paef_128_384_encrypt_iov
+    (const ForkAE128384Key_t *key, const ForkAEPAEF128384AD_t *ad,
+     PAEFCursor_t *c, PAEFCursor_t *m, size_t mlen, const uint8_t *nonce,
+     size_t counter, const uint8_t *sum)
+{
+    uint8_t tweaks[FORKAE_PARALLEL_BLOCKS * PAEF_128_384_BLOCK_SIZE];
+    uint8_t legs[FORKAE_PARALLEL_BLOCKS * PAEF_128_384_BLOCK_SIZE];
+    uint8_t block[PAEF_128_384_BLOCK_SIZE];
+    uint8_t tag[FORKAE_PAEF_128_384_TAG_SIZE];
+    size_t count;
+    size_t last;
+
+    paef_128_384_init_tweaks(tweaks, nonce);
+    paef_128_384_finish_ad(key, tweaks, tag, ad, mlen == 0);
+    if (sum)
+        skinny128_xor(tag, tag, sum);
+    if (mlen == 0) {
+        paef_cursor_write(c, tag, FORKAE_PAEF_128_384_TAG_SIZE);
+        return;
+    }
+
+    /* All message blocks but the last one */
+    while (mlen > PAEF_128_384_BLOCK_SIZE) {
+        count = paef_128_384_iov_blocks
+            (key, PAEF_PHASE_ENCRYPT, tweaks, FORKAE_FLAG_M, counter, legs,
+             c, m, (mlen - 1) / PAEF_128_384_BLOCK_SIZE);
+        forkae_absorb(tag, legs, count, PAEF_128_384_BLOCK_SIZE);
+        mlen -= count * PAEF_128_384_BLOCK_SIZE;
+        counter += count;
+    }
+
+    /* The last message block, padded to a full block, then the tag */
+    last = mlen;
+    paef_cursor_read(m, legs, last);
+    if (last == PAEF_128_384_BLOCK_SIZE) {
+        memcpy(block, legs, PAEF_128_384_BLOCK_SIZE);
+        paef_128_384_set_counters(tweaks, FORKAE_FLAG_M_LAST, counter, 1);
+    } else {
+        forkae_pad(block, legs, last, PAEF_128_384_BLOCK_SIZE);
+        paef_128_384_set_counters(tweaks, FORKAE_FLAG_M_LAST_PAD, counter, 1);
+    }
+    forkskinny_c_128_384_encrypt_parallel
+        (tweaks, &key->tks2, &key->tks3, legs, block, block, 1);
+    forkae_absorb(tag, legs, 1, PAEF_128_384_BLOCK_SIZE);
+    paef_cursor_write(c, block, PAEF_128_384_BLOCK_SIZE);
+    paef_cursor_write(c, tag, FORKAE_PAEF_128_384_TAG_SIZE);
+}
+
+/* Decrypts and verifies clen bytes of c (tag excluded, a multiple of the
+   block size) into m, setting mlen to the length of the message; both
+   lists are long enough. counter and sum as for paef_128_384_encrypt_iov;
+   on failure, only the message bytes written by this function are wiped.
+   Whether the last block was padded follows from the tag: the block is
+   decrypted under both flags, and the padding is only accepted with the
+   tag that matches it. */
+static int paef_128_384_decrypt_iov
+    (const ForkAE128384Key_t *key, const ForkAEPAEF128384AD_t *ad,
+     PAEFCursor_t *m, size_t *mlen, PAEFCursor_t *c, size_t clen,
+     const uint8_t *nonce, size_t counter, const uint8_t *sum)
+{
+    uint8_t tweaks[FORKAE_PARALLEL_BLOCKS * PAEF_128_384_BLOCK_SIZE];
+    uint8_t legs[FORKAE_PARALLEL_BLOCKS * PAEF_128_384_BLOCK_SIZE];
+    uint8_t blocks[2 * PAEF_128_384_BLOCK_SIZE];
+    uint8_t tag[FORKAE_PAEF_128_384_TAG_SIZE];
+    uint8_t padded[FORKAE_PAEF_128_384_TAG_SIZE];
+    uint8_t received[FORKAE_PAEF_128_384_TAG_SIZE];
+    PAEFCursor_t mstart = *m;
+    size_t count;
+    size_t last;
+    uint8_t diff;
+
+    *mlen = 0;
+    paef_128_384_init_tweaks(tweaks, nonce);
+    paef_128_384_finish_ad(key, tweaks, tag, ad, clen == 0);
+    if (sum)
+        skinny128_xor(tag, tag, sum);
+    if (clen == 0) {
+        paef_cursor_read(c, received, FORKAE_PAEF_128_384_TAG_SIZE);
+        return forkae_compare(tag, received, FORKAE_PAEF_128_384_TAG_SIZE) ? -1 : 0;
+    }
+
+    /* All message blocks but the last one */
+    while (clen > PAEF_128_384_BLOCK_SIZE) {
+        count = paef_128_384_iov_blocks
+            (key, PAEF_PHASE_DECRYPT, tweaks, FORKAE_FLAG_M, counter, legs,
+             m, c, (clen - 1) / PAEF_128_384_BLOCK_SIZE);
+        forkae_absorb(tag, legs, count, PAEF_128_384_BLOCK_SIZE);
+        clen -= count * PAEF_128_384_BLOCK_SIZE;
+        *mlen += count * PAEF_128_384_BLOCK_SIZE;
+        counter += count;
+    }
+
+    /* The last block, as a full block and as a padded one */
+    paef_cursor_read(c, blocks, PAEF_128_384_BLOCK_SIZE);
+    paef_cursor_read(c, received, FORKAE_PAEF_128_384_TAG_SIZE);
+    memcpy(blocks + PAEF_128_384_BLOCK_SIZE, blocks, PAEF_128_384_BLOCK_SIZE);
+    paef_128_384_set_counters(tweaks, FORKAE_FLAG_M_LAST, counter, 1);
+    paef_128_384_set_counters
+        (tweaks + PAEF_128_384_BLOCK_SIZE, FORKAE_FLAG_M_LAST_PAD, counter, 1);
+    forkskinny_c_128_384_decrypt_parallel
+        (tweaks, &key->tks2, &key->tks3, legs, blocks, blocks, 2);
+    skinny128_xor(padded, tag, legs + PAEF_128_384_BLOCK_SIZE);
+    skinny128_xor(tag, tag, legs);
+    if (!forkae_compare(tag, received, FORKAE_PAEF_128_384_TAG_SIZE)) {
+        last = PAEF_128_384_BLOCK_SIZE;
+        diff = 0;
+    } else {
+        diff = forkae_compare(padded, received, FORKAE_PAEF_128_384_TAG_SIZE);
+        diff |= forkae_unpad
+            (blocks + PAEF_128_384_BLOCK_SIZE, PAEF_128_384_BLOCK_SIZE, &last);
+        diff |= (uint8_t)(last == 0);
+        memcpy(blocks, blocks + PAEF_128_384_BLOCK_SIZE, last);
+    }
+    if (diff) {
+        paef_cursor_write(&mstart, NULL, *mlen);
+        *mlen = 0;
+        return -1;
+    }
+    paef_cursor_write(m, blocks, last);
+    *mlen += last;
+    return 0;
+}
+
+int forkae_c_paef_128_384_encrypt_ad
+    (const ForkAE128384Key_t *key, const ForkAEPAEF128384AD_t *ad,
+     uint8_t *c, size_t *clen, const uint8_t *m, size_t mlen,
+     const uint8_t *nonce)
+{
+    ForkAEIOVec_t iovc, iovm;
+    PAEFCursor_t cc, cm;
+
+    if (forkae_blocks(mlen, PAEF_128_384_BLOCK_SIZE) > FORKAE_PAEF_128_384_MAX_BLOCKS)
+        return -1;
+    *clen = FORKAE_PAEF_128_384_CIPHERTEXT_SIZE(mlen);
+    iovc.iov_base = c;
+    iovc.iov_len = *clen;
+    iovm.iov_base = (void *)m;
+    iovm.iov_len = mlen;
+    paef_cursor_init(&cc, &iovc, 1);
+    paef_cursor_init(&cm, &iovm, 1);
+    paef_128_384_encrypt_iov(key, ad, &cc, &cm, mlen, nonce, 1, NULL);
+    return 0;
+}
+
+int forkae_c_paef_128_384_encrypt
+    (const ForkAE128384Key_t *key, uint8_t *c, size_t *clen,
+     const uint8_t *m, size_t mlen, const uint8_t *ad, size_t adlen,
+     const uint8_t *nonce)
+{
+    ForkAEPAEF128384AD_t state;
+    if (forkae_c_paef_128_384_init_ad(key, &state, ad, adlen) != 0)
+        return -1;
+    return forkae_c_paef_128_384_encrypt_ad(key, &state, c, clen, m, mlen, nonce);
+}
+
+int forkae_c_paef_128_384_decrypt_ad
+    (const ForkAE128384Key_t *key, const ForkAEPAEF128384AD_t *ad,
+     uint8_t *m, size_t *mlen, const uint8_t *c, size_t clen,
+     const uint8_t *nonce)
+{
+    ForkAEIOVec_t iovm, iovc;
+    PAEFCursor_t cm, cc;
+
+    if (clen < FORKAE_PAEF_128_384_TAG_SIZE)
+        return -1;
+    clen -= FORKAE_PAEF_128_384_TAG_SIZE;
+    if (clen % PAEF_128_384_BLOCK_SIZE != 0 ||
+            clen / PAEF_128_384_BLOCK_SIZE > FORKAE_PAEF_128_384_MAX_BLOCKS)
+        return -1;
+    iovm.iov_base = m;
+    iovm.iov_len = clen;
+    iovc.iov_base = (void *)c;
+    iovc.iov_len = clen + FORKAE_PAEF_128_384_TAG_SIZE;
+    paef_cursor_init(&cm, &iovm, 1);
+    paef_cursor_init(&cc, &iovc, 1);
+    return paef_128_384_decrypt_iov
+        (key, ad, &cm, mlen, &cc, clen, nonce, 1, NULL);
+}
+
+int forkae_c_paef_128_384_decrypt
+    (const ForkAE128384Key_t *key, uint8_t *m, size_t *mlen,
+     const uint8_t *c, size_t clen, const uint8_t *ad, size_t adlen,
+     const uint8_t *nonce)
+{
+    ForkAEPAEF128384AD_t state;
+    if (forkae_c_paef_128_384_init_ad(key, &state, ad, adlen) != 0)
+        return -1;
+    return forkae_c_paef_128_384_decrypt_ad(key, &state, m, mlen, c, clen, nonce);
+}
+
+int forkae_c_paef_128_384_encrypt_iov
+    (const ForkAE128384Key_t *key, const ForkAEIOVec_t *c, size_t ccount,
+     size_t *clen, const ForkAEIOVec_t *m, size_t mcount,
+     const ForkAEIOVec_t *ad, size_t adcount, const uint8_t *nonce)
+{
+    ForkAEPAEF128384AD_t state;
+    PAEFCursor_t cc, cm, cad;
+    size_t mlen = paef_iov_length(m, mcount);
+
+    if (forkae_blocks(mlen, PAEF_128_384_BLOCK_SIZE) > FORKAE_PAEF_128_384_MAX_BLOCKS ||
+            paef_iov_length(c, ccount) < FORKAE_PAEF_128_384_CIPHERTEXT_SIZE(mlen))
+        return -1;
+    paef_cursor_init(&cad, ad, adcount);
+    if (paef_128_384_init_ad_iov
+            (key, &state, &cad, paef_iov_length(ad, adcount)) != 0)
+        return -1;
+    *clen = FORKAE_PAEF_128_384_CIPHERTEXT_SIZE(mlen);
+    paef_cursor_init(&cc, c, ccount);
+    paef_cursor_init(&cm, m, mcount);
+    paef_128_384_encrypt_iov(key, &state, &cc, &cm, mlen, nonce, 1, NULL);
+    return 0;
+}
+
+int forkae_c_paef_128_384_decrypt_iov
+    (const ForkAE128384Key_t *key, const ForkAEIOVec_t *m, size_t mcount,
+     size_t *mlen, const ForkAEIOVec_t *c, size_t ccount,
+     const ForkAEIOVec_t *ad, size_t adcount, const uint8_t *nonce)
+{
+    ForkAEPAEF128384AD_t state;
+    PAEFCursor_t cm, cc, cad;
+    size_t clen = paef_iov_length(c, ccount);
+
+    if (clen < FORKAE_PAEF_128_384_TAG_SIZE)
+        return -1;
+    clen -= FORKAE_PAEF_128_384_TAG_SIZE;
+    if (clen % PAEF_128_384_BLOCK_SIZE != 0 ||
+            clen / PAEF_128_384_BLOCK_SIZE > FORKAE_PAEF_128_384_MAX_BLOCKS ||
+            paef_iov_length(m, mcount) < clen)
+        return -1;
+    paef_cursor_init(&cad, ad, adcount);
+    if (paef_128_384_init_ad_iov
+            (key, &state, &cad, paef_iov_length(ad, adcount)) != 0)
+        return -1;
+    paef_cursor_init(&cm, m, mcount);
+    paef_cursor_init(&cc, c, ccount);
+    return paef_128_384_decrypt_iov
+        (key, &state, &cm, mlen, &cc, clen, nonce, 1, NULL);
+}
+
+/* Message blocks per chunk of a thread pool */
+#define PAEF_128_384_CHUNK_BLOCKS (FORKAE_POOL_CHUNK_SIZE / PAEF_128_384_BLOCK_SIZE)
+
+/* The message blocks before the last one, split into chunks for a pool */
+typedef struct
+{
+    const ForkAE128384Key_t *key;
+    const uint8_t *nonce;
+    const uint8_t *input;
+    uint8_t *output;
+    size_t blocks;
+    int decrypt;
+
+    /* XOR of the left legs of all blocks */
+    uint8_t sum[PAEF_128_384_BLOCK_SIZE];
+
+} PAEF128384Bulk_t;
+
+/* Processes one chunk, absorbing the left legs into the thread's scratch */
+static void paef_128_384_chunk(void *ctx, size_t index, uint8_t *scratch)
+{
+    const PAEF128384Bulk_t *bulk = (const PAEF128384Bulk_t *)ctx;
+    const ForkAE128384Key_t *key = bulk->key;
+    uint8_t tweaks[FORKAE_PARALLEL_BLOCKS * PAEF_128_384_BLOCK_SIZE];
+    uint8_t legs[FORKAE_PARALLEL_BLOCKS * PAEF_128_384_BLOCK_SIZE];
+    size_t first = index * PAEF_128_384_CHUNK_BLOCKS;
+    const uint8_t *input = bulk->input + first * PAEF_128_384_BLOCK_SIZE;
+    uint8_t *output = bulk->output + first * PAEF_128_384_BLOCK_SIZE;
+    size_t remaining = bulk->blocks - first;
+    size_t counter = first + 1;
+    size_t count;
+
+    if (remaining > PAEF_128_384_CHUNK_BLOCKS)
+        remaining = PAEF_128_384_CHUNK_BLOCKS;
+    paef_128_384_init_tweaks(tweaks, bulk->nonce);
+    while (remaining > 0) {
+        count = remaining;
+        if (count > FORKAE_PARALLEL_BLOCKS)
+            count = FORKAE_PARALLEL_BLOCKS;
+        paef_128_384_set_counters(tweaks, FORKAE_FLAG_M, counter, count);
+        if (bulk->decrypt) {
+            forkskinny_c_128_384_decrypt_parallel
+                (tweaks, &key->tks2, &key->tks3, legs, output, input, count);
+        } else {
+            forkskinny_c_128_384_encrypt_parallel
+                (tweaks, &key->tks2, &key->tks3, legs, output, input, count);
+        }
+        forkae_absorb(scratch, legs, count, PAEF_128_384_BLOCK_SIZE);
+        input += count * PAEF_128_384_BLOCK_SIZE;
+        output += count * PAEF_128_384_BLOCK_SIZE;
+        remaining -= count;
+        counter += count;
+    }
+}
+
+static void paef_128_384_combine(void *ctx, const uint8_t *scratch)
+{
+    PAEF128384Bulk_t *bulk = (PAEF128384Bulk_t *)ctx;
+    skinny128_xor(bulk->sum, bulk->sum, scratch);
+}
+
+/* Runs all message blocks but the last one of len bytes on the pool */
+static void paef_128_384_bulk
+    (ForkAEPool_t *pool, PAEF128384Bulk_t *bulk, const ForkAE128384Key_t *key,
+     uint8_t *output, const uint8_t *input, size_t len,
+     const uint8_t *nonce, int decrypt)
+{
+    bulk->key = key;
+    bulk->nonce = nonce;
+    bulk->input = input;
+    bulk->output = output;
+    bulk->blocks = len > 0 ? (len - 1) / PAEF_128_384_BLOCK_SIZE : 0;
+    bulk->decrypt = decrypt;
+    memset(bulk->sum, 0, PAEF_128_384_BLOCK_SIZE);
+    forkae_pool_run
+        (pool, forkae_blocks(bulk->blocks, PAEF_128_384_CHUNK_BLOCKS),
+         paef_128_384_chunk, paef_128_384_combine, bulk);
+}
+
+int forkae_c_paef_128_384_encrypt_pool
+    (ForkAEPool_t *pool, const ForkAE128384Key_t *key, uint8_t *c,
+     size_t *clen, const uint8_t *m, size_t mlen, const uint8_t *ad,
+     size_t adlen, const uint8_t *nonce)
+{
+    ForkAEPAEF128384AD_t state;
+    PAEF128384Bulk_t bulk;
+    ForkAEIOVec_t iovc, iovm;
+    PAEFCursor_t cc, cm;
+    size_t done;
+
+    if (forkae_blocks(mlen, PAEF_128_384_BLOCK_SIZE) > FORKAE_PAEF_128_384_MAX_BLOCKS)
+        return -1;
+    if (forkae_c_paef_128_384_init_ad(key, &state, ad, adlen) != 0)
+        return -1;
+    *clen = FORKAE_PAEF_128_384_CIPHERTEXT_SIZE(mlen);
+    paef_128_384_bulk(pool, &bulk, key, c, m, mlen, nonce, 0);
+
+    /* The last block and the tag */
+    done = bulk.blocks * PAEF_128_384_BLOCK_SIZE;
+    iovc.iov_base = c + done;
+    iovc.iov_len = *clen - done;
+    iovm.iov_base = (void *)(m + done);
+    iovm.iov_len = mlen - done;
+    paef_cursor_init(&cc, &iovc, 1);
+    paef_cursor_init(&cm, &iovm, 1);
+    paef_128_384_encrypt_iov
+        (key, &state, &cc, &cm, mlen - done, nonce, bulk.blocks + 1, bulk.sum);
+    return 0;
+}
+
+int forkae_c_paef_128_384_decrypt_pool
+    (ForkAEPool_t *pool, const ForkAE128384Key_t *key, uint8_t *m,
+     size_t *mlen, const uint8_t *c, size_t clen, const uint8_t *ad,
+     size_t adlen, const uint8_t *nonce)
+{
+    ForkAEPAEF128384AD_t state;
+    PAEF128384Bulk_t bulk;
+    ForkAEIOVec_t iovm, iovc;
+    PAEFCursor_t cm, cc;
+    size_t done;
+
+    if (clen < FORKAE_PAEF_128_384_TAG_SIZE)
+        return -1;
+    clen -= FORKAE_PAEF_128_384_TAG_SIZE;
+    if (clen % PAEF_128_384_BLOCK_SIZE != 0 ||
+            clen / PAEF_128_384_BLOCK_SIZE > FORKAE_PAEF_128_384_MAX_BLOCKS)
+        return -1;
+    if (forkae_c_paef_128_384_init_ad(key, &state, ad, adlen) != 0)
+        return -1;
+    paef_128_384_bulk(pool, &bulk, key, m, c, clen, nonce, 1);
+
+    /* The last block and the tag */
+    done = bulk.blocks * PAEF_128_384_BLOCK_SIZE;
+    iovm.iov_base = m + done;
+    iovm.iov_len = clen - done;
+    iovc.iov_base = (void *)(c + done);
+    iovc.iov_len = clen - done + FORKAE_PAEF_128_384_TAG_SIZE;
+    paef_cursor_init(&cm, &iovm, 1);
+    paef_cursor_init(&cc, &iovc, 1);
+    if (paef_128_384_decrypt_iov
+            (key, &state, &cm, mlen, &cc, clen - done, nonce,
+             bulk.blocks + 1, bulk.sum) != 0) {
+        memset(m, 0, done);
+        return -1;
+    }
+    *mlen += done;
+    return 0;
+}
+
+static int rpaef_128_384_encrypt
+    (const ForkAE128384Key_t *key, const ForkAEPAEF128384AD_t *ad,
+     uint8_t *c, size_t *clen, const uint8_t *m, size_t mlen,
+     const uint8_t *nonce)
+{
+    uint8_t tweaks[FORKAE_PARALLEL_BLOCKS * PAEF_128_384_BLOCK_SIZE];
+    uint8_t block[PAEF_128_384_BLOCK_SIZE];
+    uint8_t leg[PAEF_128_384_BLOCK_SIZE];
+    uint8_t tag[FORKAE_PAEF_128_384_TAG_SIZE];
+    size_t counter = 1;
+    size_t count;
+    size_t last;
+
+    if (forkae_blocks(mlen, PAEF_128_384_BLOCK_SIZE) > FORKAE_PAEF_128_384_MAX_BLOCKS)
+        return -1;
+
+    paef_128_384_init_tweaks(tweaks, nonce);
+    paef_128_384_finish_ad(key, tweaks, tag, ad, mlen == 0);
+    if (mlen == 0) {
+        memcpy(c, tag, FORKAE_PAEF_128_384_TAG_SIZE);
+        *clen = FORKAE_PAEF_128_384_TAG_SIZE;
+        return 0;
+    }
+    *clen = FORKAE_PAEF_128_384_CIPHERTEXT_SIZE(mlen);
+
+    /* All message blocks but the last one, right leg only */
+    while (mlen > PAEF_128_384_BLOCK_SIZE) {
+        count = (mlen - 1) / PAEF_128_384_BLOCK_SIZE;
+        if (count > FORKAE_PARALLEL_BLOCKS)
+            count = FORKAE_PARALLEL_BLOCKS;
+        paef_128_384_set_counters(tweaks, FORKAE_FLAG_M, counter, count);
+        forkae_absorb(tag, m, count, PAEF_128_384_BLOCK_SIZE);
+        forkskinny_c_128_384_encrypt_parallel
+            (tweaks, &key->tks2, &key->tks3, NULL, c, m, count);
+        c += count * PAEF_128_384_BLOCK_SIZE;
+        m += count * PAEF_128_384_BLOCK_SIZE;
+        mlen -= count * PAEF_128_384_BLOCK_SIZE;
+        counter += count;
+    }
+
+    /* The last message block computes both legs */
+    last = mlen;
+    if (last == PAEF_128_384_BLOCK_SIZE) {
+        memcpy(block, m, PAEF_128_384_BLOCK_SIZE);
+        paef_128_384_set_counters(tweaks, FORKAE_FLAG_M_LAST, counter, 1);
+    } else {
+        forkae_pad(block, m, last, PAEF_128_384_BLOCK_SIZE);
+        paef_128_384_set_counters(tweaks, FORKAE_FLAG_M_LAST_PAD, counter, 1);
+    }
+    forkskinny_c_128_384_encrypt_parallel
+        (tweaks, &key->tks2, &key->tks3, leg, c, block, 1);
+    forkae_absorb(tag, leg, 1, PAEF_128_384_BLOCK_SIZE);
+    memcpy(c + PAEF_128_384_BLOCK_SIZE, tag, FORKAE_PAEF_128_384_TAG_SIZE);
+    return 0;
+}
+
+int forkae_c_rpaef_128_384_encrypt
+    (const ForkAE128384Key_t *key, uint8_t *c, size_t *clen,
+     const uint8_t *m, size_t mlen, const uint8_t *ad, size_t adlen,
+     const uint8_t *nonce)
+{
+    ForkAEPAEF128384AD_t state;
+    if (forkae_c_paef_128_384_init_ad(key, &state, ad, adlen) != 0)
+        return -1;
+    return rpaef_128_384_encrypt(key, &state, c, clen, m, mlen, nonce);
+}
+
+static int rpaef_128_384_decrypt
+    (const ForkAE128384Key_t *key, const ForkAEPAEF128384AD_t *ad,
+     uint8_t *m, size_t *mlen, const uint8_t *c, size_t clen,
+     const uint8_t *nonce)
+{
+    uint8_t tweaks[FORKAE_PARALLEL_BLOCKS * PAEF_128_384_BLOCK_SIZE];
+    uint8_t blocks[2 * PAEF_128_384_BLOCK_SIZE];
+    uint8_t legs[2 * PAEF_128_384_BLOCK_SIZE];
+    uint8_t tag[FORKAE_PAEF_128_384_TAG_SIZE];
+    uint8_t padded[FORKAE_PAEF_128_384_TAG_SIZE];
+    uint8_t *mstart = m;
+    size_t counter = 1;
+    size_t count;
+    size_t last;
+    uint8_t diff;
+
+    if (clen < FORKAE_PAEF_128_384_TAG_SIZE)
+        return -1;
+    clen -= FORKAE_PAEF_128_384_TAG_SIZE;
+    if (clen % PAEF_128_384_BLOCK_SIZE != 0 ||
+            clen / PAEF_128_384_BLOCK_SIZE > FORKAE_PAEF_128_384_MAX_BLOCKS)
+        return -1;
+    *mlen = 0;
+
+    paef_128_384_init_tweaks(tweaks, nonce);
+    paef_128_384_finish_ad(key, tweaks, tag, ad, clen == 0);
+    if (clen == 0)
+        return forkae_compare(tag, c, FORKAE_PAEF_128_384_TAG_SIZE) ? -1 : 0;
+
+    /* All message blocks but the last one, without the left leg */
+    while (clen > PAEF_128_384_BLOCK_SIZE) {
+        count = (clen - 1) / PAEF_128_384_BLOCK_SIZE;
+        if (count > FORKAE_PARALLEL_BLOCKS)
+            count = FORKAE_PARALLEL_BLOCKS;
+        paef_128_384_set_counters(tweaks, FORKAE_FLAG_M, counter, count);
+        forkskinny_c_128_384_decrypt_parallel
+            (tweaks, &key->tks2, &key->tks3, NULL, m, c, count);
+        forkae_absorb(tag, m, count, PAEF_128_384_BLOCK_SIZE);
+        c += count * PAEF_128_384_BLOCK_SIZE;
+        m += count * PAEF_128_384_BLOCK_SIZE;
+        clen -= count * PAEF_128_384_BLOCK_SIZE;
+        counter += count;
+    }
+
+    /* The last block, as a full block and as a padded one, as for PAEF */
+    memcpy(blocks, c, PAEF_128_384_BLOCK_SIZE);
+    memcpy(blocks + PAEF_128_384_BLOCK_SIZE, c, PAEF_128_384_BLOCK_SIZE);
+    paef_128_384_set_counters(tweaks, FORKAE_FLAG_M_LAST, counter, 1);
+    paef_128_384_set_counters
+        (tweaks + PAEF_128_384_BLOCK_SIZE, FORKAE_FLAG_M_LAST_PAD, counter, 1);
+    forkskinny_c_128_384_decrypt_parallel
+        (tweaks, &key->tks2, &key->tks3, legs, blocks, blocks, 2);
+    skinny128_xor(padded, tag, legs + PAEF_128_384_BLOCK_SIZE);
+    skinny128_xor(tag, tag, legs);
+    c += PAEF_128_384_BLOCK_SIZE;
+    if (!forkae_compare(tag, c, FORKAE_PAEF_128_384_TAG_SIZE)) {
+        last = PAEF_128_384_BLOCK_SIZE;
+        diff = 0;
+    } else {
+        diff = forkae_compare(padded, c, FORKAE_PAEF_128_384_TAG_SIZE);
+        diff |= forkae_unpad
+            (blocks + PAEF_128_384_BLOCK_SIZE, PAEF_128_384_BLOCK_SIZE, &last);
+        diff |= (uint8_t)(last == 0);
+        memcpy(blocks, blocks + PAEF_128_384_BLOCK_SIZE, last);
+    }
+    if (diff) {
+        memset(mstart, 0, (size_t)(m - mstart));
+        return -1;
+    }
+    memcpy(m, blocks, last);
+    *mlen = (size_t)(m - mstart) + last;
+    return 0;
+}
+
+int forkae_c_rpaef_128_384_decrypt
+    (const ForkAE128384Key_t *key, uint8_t *m, size_t *mlen,
+     const uint8_t *c, size_t clen, const uint8_t *ad, size_t adlen,
+     const uint8_t *nonce)
+{
+    ForkAEPAEF128384AD_t state;
+    if (forkae_c_paef_128_384_init_ad(key, &state, ad, adlen) != 0)
+        return -1;
+    return rpaef_128_384_decrypt(key, &state, m, mlen, c, clen, nonce);
+}
+
+/* Largest block size of the variants processed in batches */
+#define PAEF_MAX_BLOCK_SIZE FORKSKINNY128_BLOCK_SIZE
+
+/* Parameters of a forkcipher variant for the batched PAEF functions */
+typedef struct
+{
+    unsigned block_size;
+    unsigned nonce_size;
+    unsigned counter_bits;
+    size_t max_blocks;
+
+    /* Calls the parallel kernel in the direction given by the phase;
+       block i is processed under keys[i] */
+    void (*kernel)(const void *const *keys, unsigned phase,
+                   const uint8_t *tweaks, uint8_t *left, uint8_t *right,
+                   const uint8_t *input, size_t count);
+
+} PAEFVariant_t;
+
+/* Blocks of several messages collected for one call of the parallel kernel */
+typedef struct
+{
+    uint8_t tweaks[FORKAE_PARALLEL_BLOCKS * PAEF_MAX_BLOCK_SIZE];
+    uint8_t input[FORKAE_PARALLEL_BLOCKS * PAEF_MAX_BLOCK_SIZE];
+    uint8_t left[FORKAE_PARALLEL_BLOCKS * PAEF_MAX_BLOCK_SIZE];
+    uint8_t right[FORKAE_PARALLEL_BLOCKS * PAEF_MAX_BLOCK_SIZE];
+
+    /* Tag that absorbs the left leg of each block */
+    uint8_t *tag[FORKAE_PARALLEL_BLOCKS];
+
+    /* Destination of the right leg of each block */
+    uint8_t *output[FORKAE_PARALLEL_BLOCKS];
+
+    /* Key of each block */
+    const void *keys[FORKAE_PARALLEL_BLOCKS];
+
+    const PAEFVariant_t *variant;
+    unsigned phase;
+    unsigned count;
+
+} PAEFBatch_t;
+
+/* Only used with one key for all blocks */
+static void paef_64_192_kernel
+    (const void *const *keys, unsigned phase, const uint8_t *tweaks,
+     uint8_t *left, uint8_t *right, const uint8_t *input, size_t count)
+{
+    const ForkAE64192Key_t *k = (const ForkAE64192Key_t *)keys[0];
+    if (phase == PAEF_PHASE_DECRYPT) {
+        forkskinny_c_64_192_decrypt_parallel
+            (tweaks, &k->tks23, left, right, input, count);
+    } else {
+        forkskinny_c_64_192_encrypt_parallel
+            (tweaks, &k->tks23, left, phase == PAEF_PHASE_AD ? NULL : right,
+             input, count);
+    }
+}
+
+static void paef_128_384_kernel
+    (const void *const *keys, unsigned phase, const uint8_t *tweaks,
+     uint8_t *left, uint8_t *right, const uint8_t *input, size_t count)
+{
+    const ForkAE128384Key_t *k = (const ForkAE128384Key_t *)keys[0];
+    const ForkSkinny128Key_t *ks2[FORKAE_PARALLEL_BLOCKS];
+    const ForkSkinny128Key_t *ks3[FORKAE_PARALLEL_BLOCKS];
+    size_t index;
+    int same = 1;
+
+    for (index = 1; index < count; ++index)
+        same &= (keys[index] == keys[0]);
+    if (!same) {
+        /* Blocks under different keys share the lanes */
+        for (index = 0; index < count; ++index) {
+            k = (const ForkAE128384Key_t *)keys[index];
+            ks2[index] = &k->tks2;
+            ks3[index] = &k->tks3;
+        }
+        if (phase == PAEF_PHASE_DECRYPT) {
+            forkskinny_c_128_384_decrypt_multikey
+                (tweaks, ks2, ks3, left, right, input, count);
+        } else {
+            forkskinny_c_128_384_encrypt_multikey
+                (tweaks, ks2, ks3, left,
+                 phase == PAEF_PHASE_AD ? NULL : right, input, count);
+        }
+        return;
+    }
+    if (phase == PAEF_PHASE_DECRYPT) {
+        forkskinny_c_128_384_decrypt_parallel
+            (tweaks, &k->tks2, &k->tks3, left, right, input, count);
+    } else {
+        forkskinny_c_128_384_encrypt_parallel
+            (tweaks, &k->tks2, &k->tks3, left,
+             phase == PAEF_PHASE_AD ? NULL : right, input, count);
+    }
+}
+
+static const PAEFVariant_t paef_64_192_variant = {
+    FORKSKINNY64_BLOCK_SIZE, FORKAE_PAEF_64_192_NONCE_SIZE, 13,
+    FORKAE_PAEF_64_192_MAX_BLOCKS, paef_64_192_kernel
+};
+
+static const PAEFVariant_t paef_128_384_variant = {
+    FORKSKINNY128_BLOCK_SIZE, FORKAE_PAEF_128_384_NONCE_SIZE, 29,
+    FORKAE_PAEF_128_384_MAX_BLOCKS, paef_128_384_kernel
+};
+
+static void paef_batch_flush(PAEFBatch_t *batch)
+{
+    unsigned block_size = batch->variant->block_size;
+    unsigned index;
+
+    batch->variant->kernel
+        (batch->keys, batch->phase, batch->tweaks, batch->left, batch->right,
+         batch->input, batch->count);
+    for (index = 0; index < batch->count; ++index) {
+        forkae_xor(batch->tag[index], batch->tag[index],
+                   batch->left + index * block_size, block_size);
+        if (batch->phase != PAEF_PHASE_AD) {
+            memcpy(batch->output[index], batch->right + index * block_size,
+                   block_size);
+        }
+    }
+    batch->count = 0;
+}
+
+/* Adds a block to the batch; only the raw tweak is written, the kernel
+   expands it */
+static void paef_batch_push
+    (PAEFBatch_t *batch, const void *key, const uint8_t *nonce,
+     unsigned flags, size_t counter, const uint8_t *input, uint8_t *tag,
+     uint8_t *output)
+{
+    const PAEFVariant_t *variant = batch->variant;
+    uint8_t *tweak = batch->tweaks + batch->count * variant->block_size;
+    uint32_t value = ((uint32_t)flags << variant->counter_bits) | (uint32_t)counter;
+    unsigned posn;
+
+    memcpy(tweak, nonce, variant->nonce_size);
+    for (posn = variant->block_size; posn > variant->nonce_size; value >>= 8)
+        tweak[--posn] = (uint8_t)value;
+    memcpy(batch->input + batch->count * variant->block_size, input,
+           variant->block_size);
+    batch->tag[batch->count] = tag;
+    batch->output[batch->count] = output;
+    batch->keys[batch->count] = key;
+    if (++(batch->count) == FORKAE_PARALLEL_BLOCKS)
+        paef_batch_flush(batch);
+}
+
+static const uint8_t paef_zero_nonce[PAEF_MAX_BLOCK_SIZE] = {0};
+
+static void paef_batch_push_ad
+    (PAEFBatch_t *batch, const void *key, const ForkAEMessage_t *message,
+     uint8_t *tag, int final)
+{
+    unsigned block_size = batch->variant->block_size;
+    uint8_t block[PAEF_MAX_BLOCK_SIZE];
+    const uint8_t *ad = message->ad;
+    size_t adlen = message->adlen;
+    size_t counter = 1;
+
+    /* All blocks but the last one use a zero nonce */
+    for (; adlen > block_size; ++counter) {
+        paef_batch_push
+            (batch, key, paef_zero_nonce, FORKAE_FLAG_AD, counter, ad, tag,
+             NULL);
+        ad += block_size;
+        adlen -= block_size;
+    }
+    if (adlen == block_size) {
+        paef_batch_push
+            (batch, key, message->nonce,
+             final ? FORKAE_FLAG_AD_FINAL : FORKAE_FLAG_AD_LAST,
+             counter, ad, tag, NULL);
+    } else {
+        forkae_pad(block, ad, adlen, block_size);
+        paef_batch_push
+            (batch, key, message->nonce,
+             final ? FORKAE_FLAG_AD_FINAL_PAD : FORKAE_FLAG_AD_LAST_PAD,
+             counter, block, tag, NULL);
+    }
+}
+
+/* Adds all message blocks; the right leg of the last block goes to last.
+   When decrypting, the last block is added twice, as a full block and as
+   a padded one, absorbing its left legs into ends[0] and ends[1] and
+   writing its right legs to last[0] and last[1] (blocks of block_size
+   bytes each); the tag then tells which one was encrypted. */
+static void paef_batch_push_message
+    (PAEFBatch_t *batch, const void *key, const ForkAEMessage_t *message,
+     size_t mlen, uint8_t *tag, uint8_t *ends, uint8_t *last)
+{
+    unsigned block_size = batch->variant->block_size;
+    uint8_t block[PAEF_MAX_BLOCK_SIZE];
+    const uint8_t *input = message->input;
+    uint8_t *output = message->output;
+    size_t counter = 1;
+
+    for (; mlen > block_size; ++counter) {
+        paef_batch_push
+            (batch, key, message->nonce, FORKAE_FLAG_M, counter, input, tag,
+             output);
+        input += block_size;
+        output += block_size;
+        mlen -= block_size;
+    }
+    if (batch->phase == PAEF_PHASE_DECRYPT) {
+        paef_batch_push
+            (batch, key, message->nonce, FORKAE_FLAG_M_LAST, counter, input,
+             ends, last);
+        paef_batch_push
+            (batch, key, message->nonce, FORKAE_FLAG_M_LAST_PAD, counter,
+             input, ends + block_size, last + block_size);
+    } else if (mlen == block_size) {
+        paef_batch_push
+            (batch, key, message->nonce, FORKAE_FLAG_M_LAST, counter, input,
+             tag, last);
+    } else {
+        forkae_pad(block, input, mlen, block_size);
+        paef_batch_push
+            (batch, key, message->nonce, FORKAE_FLAG_M_LAST_PAD, counter,
+             block, tag, last);
+    }
+}
+
+/* Encrypts, or decrypts and verifies, a batch of messages. The blocks of
+   up to FORKAE_PARALLEL_BLOCKS messages at a time share the kernel calls;
+   when decrypting, each kernel call computes both the message block and
+   the left leg for the tag, so the ciphertext is only read once. The
+   message blocks are therefore written before the tag is checked, and
+   wiped if it does not match; only the last block is held back.
+   Message i uses keys[i], or key if keys is NULL. */
+static void paef_batch_process
+    (const PAEFVariant_t *variant, const void *key, const void *const *keys,
+     ForkAEMessage_t *messages, size_t count, int decrypt)
+{
+    unsigned block_size = variant->block_size;
+    PAEFBatch_t batch;
+    uint8_t tags[FORKAE_PARALLEL_BLOCKS][PAEF_MAX_BLOCK_SIZE];
+    uint8_t ends[FORKAE_PARALLEL_BLOCKS][2 * PAEF_MAX_BLOCK_SIZE];
+    uint8_t lasts[FORKAE_PARALLEL_BLOCKS][2 * PAEF_MAX_BLOCK_SIZE];
+    uint8_t tag[PAEF_MAX_BLOCK_SIZE];
+    size_t mlens[FORKAE_PARALLEL_BLOCKS];
+    ForkAEMessage_t *message;
+    size_t window, index, mlen, offset, last;
+    uint8_t diff;
+
+    batch.variant = variant;
+    batch.count = 0;
+    while (count > 0) {
+        window = count < FORKAE_PARALLEL_BLOCKS ? count : FORKAE_PARALLEL_BLOCKS;
+
+        /* Validate the lengths of the messages in this window; when
+           decrypting, mlens holds the length of the padded message */
+        for (index = 0, message = messages; index < window; ++index, ++message) {
+            mlen = message->inlen;
+            message->outlen = 0;
+            message->result = -1;
+            if (decrypt) {
+                if (mlen < block_size || mlen % block_size != 0)
+                    continue;
+                mlen -= block_size;
+            }
+            if (forkae_blocks(message->adlen, block_size) > variant->max_blocks ||
+                    forkae_blocks(mlen, block_size) > variant->max_blocks)
+                continue;
+            message->result = 0;
+            mlens[index] = mlen;
+            memset(tags[index], 0, block_size);
+            memset(ends[index], 0, 2 * block_size);
+        }
+
+        /* Associated data of all messages */
+        batch.phase = PAEF_PHASE_AD;
+        for (index = 0, message = messages; index < window; ++index, ++message) {
+            if (message->result == 0 && (message->adlen > 0 || mlens[index] == 0)) {
+                paef_batch_push_ad
+                    (&batch, keys ? keys[index] : key, message, tags[index],
+                     mlens[index] == 0);
+            }
+        }
+        if (batch.count > 0)
+            paef_batch_flush(&batch);
+
+        /* Message blocks of all messages */
+        batch.phase = decrypt ? PAEF_PHASE_DECRYPT : PAEF_PHASE_ENCRYPT;
+        for (index = 0, message = messages; index < window; ++index, ++message) {
+            if (message->result == 0 && mlens[index] > 0) {
+                paef_batch_push_message
+                    (&batch, keys ? keys[index] : key, message, mlens[index],
+                     tags[index], ends[index], lasts[index]);
+            }
+        }
+        if (batch.count > 0)
+            paef_batch_flush(&batch);
+
+        /* Output or verify the tags */
+        for (index = 0, message = messages; index < window; ++index, ++message) {
+            if (message->result != 0)
+                continue;
+            offset = forkae_blocks(mlens[index], block_size) * block_size;
+            if (!decrypt) {
+                /* The padded message is followed by the full tag */
+                if (offset > 0) {
+                    memcpy(message->output + offset - block_size,
+                           lasts[index], block_size);
+                }
+                memcpy(message->output + offset, tags[index], block_size);
+                message->outlen = offset + block_size;
+                continue;
+            }
+            if (offset == 0) {
+                if (forkae_compare(tags[index], message->input, block_size))
+                    message->result = -1;
+                continue;
+            }
+
+            /* The last block was full if the tag with its full leg
+               matches, otherwise it must be padded; the plaintext written
+               so far is wiped unless it is authentic */
+            skinny_xor(tag, tags[index], ends[index], block_size);
+            if (!forkae_compare(tag, message->input + offset, block_size)) {
+                memcpy(message->output + offset - block_size, lasts[index],
+                       block_size);
+                message->outlen = offset;
+                continue;
+            }
+            skinny_xor(tag, tags[index], ends[index] + block_size, block_size);
+            diff = forkae_compare(tag, message->input + offset, block_size);
+            diff |= forkae_unpad(lasts[index] + block_size, block_size, &last);
+            diff |= (uint8_t)(last == 0);
+            if (diff) {
+                memset(message->output, 0, offset - block_size);
+                message->result = -1;
+                continue;
+            }
+            memcpy(message->output + offset - block_size,
+                   lasts[index] + block_size, last);
+            message->outlen = offset - block_size + last;
+        }
+        messages += window;
+        if (keys)
+            keys += window;
+        count -= window;
+    }
+}
+
+int forkae_c_paef_64_192_encrypt
+    (const ForkAE64192Key_t *key, uint8_t *c, size_t *clen,
+     const uint8_t *m, size_t mlen, const uint8_t *ad, size_t adlen,
+     const uint8_t *nonce)
+{
+    ForkAEMessage_t message;
+    message.nonce = nonce;
+    message.ad = ad;
+    message.adlen = adlen;
+    message.input = m;
+    message.inlen = mlen;
+    message.output = c;
+    paef_batch_process(&paef_64_192_variant, key, NULL, &message, 1, 0);
+    *clen = message.outlen;
+    return message.result;
+}
+
+int forkae_c_paef_64_192_decrypt
+    (const ForkAE64192Key_t *key, uint8_t *m, size_t *mlen,
+     const uint8_t *c, size_t clen, const uint8_t *ad, size_t adlen,
+     const uint8_t *nonce)
+{
+    ForkAEMessage_t message;
+    message.nonce = nonce;
+    message.ad = ad;
+    message.adlen = adlen;
+    message.input = c;
+    message.inlen = clen;
+    message.output = m;
+    paef_batch_process(&paef_64_192_variant, key, NULL, &message, 1, 1);
+    *mlen = message.outlen;
+    return message.result;
+}
+
+void forkae_c_paef_64_192_encrypt_many
+    (const ForkAE64192Key_t *key, ForkAEMessage_t *messages, size_t count)
+{
+    paef_batch_process(&paef_64_192_variant, key, NULL, messages, count, 0);
+}
+
+void forkae_c_paef_64_192_decrypt_many
+    (const ForkAE64192Key_t *key, ForkAEMessage_t *messages, size_t count)
+{
+    paef_batch_process(&paef_64_192_variant, key, NULL, messages, count, 1);
+}
+
+void forkae_c_paef_128_384_encrypt_many
+    (const ForkAE128384Key_t *key, ForkAEMessage_t *messages, size_t count)
+{
+    paef_batch_process(&paef_128_384_variant, key, NULL, messages, count, 0);
+}
+
+void forkae_c_paef_128_384_decrypt_many
+    (const ForkAE128384Key_t *key, ForkAEMessage_t *messages, size_t count)
+{
+    paef_batch_process(&paef_128_384_variant, key, NULL, messages, count, 1);
+}
+
+void forkae_c_paef_128_384_mb_init(ForkAEPAEF128384Manager_t *manager)
+{
+    manager->count[0] = 0;
+    manager->count[1] = 0;
+    manager->first = NULL;
+    manager->last = NULL;
+}
+
+/* Processes the queued jobs of one direction as one batch */
+static void paef_128_384_mb_run(ForkAEPAEF128384Manager_t *manager, int decrypt)
+{
+    ForkAEMessage_t messages[FORKAE_PAEF_128_384_MB_JOBS];
+    const void *keys[FORKAE_PAEF_128_384_MB_JOBS] = {0};
+    ForkAEPAEF128384Job_t **jobs = manager->queued[decrypt];
+    unsigned count = manager->count[decrypt];
+    unsigned index;
+
+    for (index = 0; index < count; ++index) {
+        messages[index] = jobs[index]->message;
+        keys[index] = jobs[index]->key;
+    }
+    paef_batch_process
+        (&paef_128_384_variant, NULL, keys, messages, count, decrypt);
+    for (index = 0; index < count; ++index) {
+        jobs[index]->message.outlen = messages[index].outlen;
+        jobs[index]->message.result = messages[index].result;
+        jobs[index]->next = NULL;
+        if (manager->last)
+            manager->last->next = jobs[index];
+        else
+            manager->first = jobs[index];
+        manager->last = jobs[index];
+    }
+    manager->count[decrypt] = 0;
+}
+
+ForkAEPAEF128384Job_t *forkae_c_paef_128_384_mb_submit
+    (ForkAEPAEF128384Manager_t *manager, ForkAEPAEF128384Job_t *job)
+{
+    int decrypt = job->decrypt != 0;
+    manager->queued[decrypt][manager->count[decrypt]++] = job;
+    if (manager->count[decrypt] == FORKAE_PAEF_128_384_MB_JOBS)
+        paef_128_384_mb_run(manager, decrypt);
+    return forkae_c_paef_128_384_mb_get_completed(manager);
+}
+
+ForkAEPAEF128384Job_t *forkae_c_paef_128_384_mb_get_completed
+    (ForkAEPAEF128384Manager_t *manager)
+{
+    ForkAEPAEF128384Job_t *job = manager->first;
+    if (job) {
+        manager->first = job->next;
+        if (!manager->first)
+            manager->last = NULL;
+        job->next = NULL;
+    }
+    return job;
+}
+
+ForkAEPAEF128384Job_t *forkae_c_paef_128_384_mb_flush
+    (ForkAEPAEF128384Manager_t *manager)
+{
+    if (!manager->first) {
+        if (manager->count[0] > 0)
+            paef_128_384_mb_run(manager, 0);
+        if (manager->count[1] > 0)
+            paef_128_384_mb_run(manager, 1);
+    }
+    return forkae_c_paef_128_384_mb_get_completed(manager);
+}
+
+unsigned forkae_c_paef_128_384_mb_queued
+    (const ForkAEPAEF128384Manager_t *manager)
+{
+    return manager->count[0] + manager->count[1];
+}
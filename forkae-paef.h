@@ -0,0 +1,390 @@
+#ifndef FORKSKINNY_C_FORKAE_PAEF_H
+#define FORKSKINNY_C_FORKAE_PAEF_H
+
+#include "forkae.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * PAEF (parallel ForkAE) authenticated encryption.
+ *
+ * Every block of associated data and message is processed by an
+ * independent forkcipher call whose tweak is the nonce, 3 bits of domain
+ * separation flags and the index of the block (starting at 1, separately
+ * for the associated data and the message). Associated data blocks
+ * contribute the left leg to the tag. Message blocks produce the ciphertext
+ * block in the right leg and contribute the left leg to the tag.
+ *
+ * All associated data blocks but the last one use an all-zero nonce, so
+ * their contribution only depends on the key. Associated data that is
+ * shared by many messages can therefore be processed once into a midstate
+ * (see forkae_c_paef_128_384_init_ad) and reused with any nonce.
+ *
+ * The ciphertext is the message padded to whole blocks, followed by the
+ * full tag (see FORKAE_PAEF_*_CIPHERTEXT_SIZE). Whether the final block was
+ * padded is domain separated in its tweak, so decryption tries both and
+ * recovers the length of the message from the interpretation whose tag
+ * matches.
+ */
+
+#define FORKAE_PAEF_64_192_NONCE_SIZE 6
+
+#define FORKAE_PAEF_64_192_TAG_SIZE FORKSKINNY64_BLOCK_SIZE
+
+/** Maximum number of blocks of associated data or message (13-bit counter) */
+#define FORKAE_PAEF_64_192_MAX_BLOCKS ((((size_t)1) << 13) - 1)
+
+/** Length of the ciphertext of a message of mlen bytes */
+#define FORKAE_PAEF_64_192_CIPHERTEXT_SIZE(mlen) \
+    (((mlen) + FORKSKINNY64_BLOCK_SIZE - 1) / FORKSKINNY64_BLOCK_SIZE * \
+     FORKSKINNY64_BLOCK_SIZE + FORKAE_PAEF_64_192_TAG_SIZE)
+
+#define FORKAE_PAEF_128_384_NONCE_SIZE 12
+
+#define FORKAE_PAEF_128_384_TAG_SIZE FORKSKINNY128_BLOCK_SIZE
+
+/** Maximum number of blocks of associated data or message (29-bit counter) */
+#define FORKAE_PAEF_128_384_MAX_BLOCKS ((((size_t)1) << 29) - 1)
+
+/** Length of the ciphertext of a message of mlen bytes */
+#define FORKAE_PAEF_128_384_CIPHERTEXT_SIZE(mlen) \
+    (((mlen) + FORKSKINNY128_BLOCK_SIZE - 1) / FORKSKINNY128_BLOCK_SIZE * \
+     FORKSKINNY128_BLOCK_SIZE + FORKAE_PAEF_128_384_TAG_SIZE)
+
+/**
+ * Encrypts and authenticates a message with PAEF-Forkskinny-64-192.
+ * The tweak TK1 is the nonce followed by the flags (3 bits) and the block
+ * counter (13 bits, big-endian).
+ * key:     key schedule (see forkae_c_64_192_init_key)
+ * c:       pointer to FORKAE_PAEF_64_192_CIPHERTEXT_SIZE(mlen) bytes; will contain the ciphertext and tag; may be equal to m
+ * clen:    will contain the length of the ciphertext
+ * m:       pointer to mlen bytes; the message
+ * mlen:    length of the message
+ * ad:      pointer to adlen bytes; the associated data
+ * adlen:   length of the associated data
+ * nonce:   pointer to FORKAE_PAEF_64_192_NONCE_SIZE bytes; must be unique for each message under a key
+ * returns: 0 on success, -1 if the message or associated data has more than FORKAE_PAEF_64_192_MAX_BLOCKS blocks
+ */
+int forkae_c_paef_64_192_encrypt(const ForkAE64192Key_t *key, uint8_t *c, size_t *clen, const uint8_t *m, size_t mlen, const uint8_t *ad, size_t adlen, const uint8_t *nonce);
+
+/**
+ * Decrypts and verifies a ciphertext with PAEF-Forkskinny-64-192.
+ * key:     key schedule (see forkae_c_64_192_init_key)
+ * m:       pointer to clen - FORKAE_PAEF_64_192_TAG_SIZE bytes; will contain the message, or zeroes if verification fails; may be equal to c. Only the mlen bytes of the message are written.
+ * mlen:    will contain the length of the message
+ * c:       pointer to clen bytes; the ciphertext and tag
+ * clen:    length of the ciphertext
+ * ad:      pointer to adlen bytes; the associated data
+ * adlen:   length of the associated data
+ * nonce:   pointer to FORKAE_PAEF_64_192_NONCE_SIZE bytes
+ * returns: 0 on success, -1 if the ciphertext is not authentic or malformed
+ */
+int forkae_c_paef_64_192_decrypt(const ForkAE64192Key_t *key, uint8_t *m, size_t *mlen, const uint8_t *c, size_t clen, const uint8_t *ad, size_t adlen, const uint8_t *nonce);
+
+/**
+ * Encrypts and authenticates a batch of independent messages with
+ * PAEF-Forkskinny-64-192. The blocks of all messages are interleaved into
+ * the lanes of the parallel kernel, which suits many short messages.
+ * key:       key schedule (see forkae_c_64_192_init_key)
+ * messages:  the messages; output, outlen and result are set for each of them as in forkae_c_paef_64_192_encrypt
+ * count:     the number of messages
+ */
+void forkae_c_paef_64_192_encrypt_many(const ForkAE64192Key_t *key, ForkAEMessage_t *messages, size_t count);
+
+/**
+ * Decrypts and verifies a batch of independent ciphertexts with
+ * PAEF-Forkskinny-64-192, as forkae_c_paef_128_384_decrypt_many: the output
+ * buffers hold unverified plaintext until the function returns.
+ * key:       key schedule (see forkae_c_64_192_init_key)
+ * messages:  the ciphertexts; output, outlen and result are set for each of them as in forkae_c_paef_64_192_decrypt
+ * count:     the number of ciphertexts
+ */
+void forkae_c_paef_64_192_decrypt_many(const ForkAE64192Key_t *key, ForkAEMessage_t *messages, size_t count);
+
+/**
+ * Associated data of PAEF-Forkskinny-128-384 processed ahead of time: the
+ * tag contribution of all blocks but the last one, and the last block.
+ * It is immutable once initialized and may be shared between threads.
+ */
+typedef struct
+{
+    /** XOR of the left legs of all blocks but the last one */
+    uint8_t sum[FORKSKINNY128_BLOCK_SIZE];
+
+    /** The last block, unpadded */
+    uint8_t last[FORKSKINNY128_BLOCK_SIZE];
+    unsigned lastlen;
+
+    /** Block counter of the last block */
+    size_t counter;
+
+} ForkAEPAEF128384AD_t;
+
+/**
+ * Processes associated data for reuse by several messages, with any nonce.
+ * key:     key schedules (see forkae_c_128_384_init_key)
+ * state:   will contain the midstate of the associated data
+ * ad:      pointer to adlen bytes; the associated data
+ * adlen:   length of the associated data
+ * returns: 0 on success, -1 if the associated data has more than FORKAE_PAEF_128_384_MAX_BLOCKS blocks
+ */
+int forkae_c_paef_128_384_init_ad(const ForkAE128384Key_t *key, ForkAEPAEF128384AD_t *state, const uint8_t *ad, size_t adlen);
+
+/**
+ * Encrypts and authenticates a message with PAEF-Forkskinny-128-384, using
+ * associated data processed by forkae_c_paef_128_384_init_ad. The result is
+ * the same as for forkae_c_paef_128_384_encrypt.
+ * key:     key schedules (see forkae_c_128_384_init_key)
+ * ad:      midstate of the associated data
+ * Other parameters and return value as for forkae_c_paef_128_384_encrypt.
+ */
+int forkae_c_paef_128_384_encrypt_ad(const ForkAE128384Key_t *key, const ForkAEPAEF128384AD_t *ad, uint8_t *c, size_t *clen, const uint8_t *m, size_t mlen, const uint8_t *nonce);
+
+/**
+ * Decrypts and verifies a ciphertext with PAEF-Forkskinny-128-384, using
+ * associated data processed by forkae_c_paef_128_384_init_ad.
+ * key:     key schedules (see forkae_c_128_384_init_key)
+ * ad:      midstate of the associated data
+ * Other parameters and return value as for forkae_c_paef_128_384_decrypt.
+ */
+int forkae_c_paef_128_384_decrypt_ad(const ForkAE128384Key_t *key, const ForkAEPAEF128384AD_t *ad, uint8_t *m, size_t *mlen, const uint8_t *c, size_t clen, const uint8_t *nonce);
+
+/**
+ * Encrypts and authenticates a message with PAEF-Forkskinny-128-384.
+ * The tweak TK1 is the nonce followed by the flags (3 bits) and the block
+ * counter (29 bits, big-endian).
+ * key:     key schedules (see forkae_c_128_384_init_key)
+ * c:       pointer to FORKAE_PAEF_128_384_CIPHERTEXT_SIZE(mlen) bytes; will contain the ciphertext and tag; may be equal to m
+ * clen:    will contain the length of the ciphertext
+ * m:       pointer to mlen bytes; the message
+ * mlen:    length of the message
+ * ad:      pointer to adlen bytes; the associated data
+ * adlen:   length of the associated data
+ * nonce:   pointer to FORKAE_PAEF_128_384_NONCE_SIZE bytes; must be unique for each message under a key
+ * returns: 0 on success, -1 if the message or associated data has more than FORKAE_PAEF_128_384_MAX_BLOCKS blocks
+ */
+int forkae_c_paef_128_384_encrypt(const ForkAE128384Key_t *key, uint8_t *c, size_t *clen, const uint8_t *m, size_t mlen, const uint8_t *ad, size_t adlen, const uint8_t *nonce);
+
+/**
+ * Decrypts and verifies a ciphertext with PAEF-Forkskinny-128-384.
+ * key:     key schedules (see forkae_c_128_384_init_key)
+ * m:       pointer to clen - FORKAE_PAEF_128_384_TAG_SIZE bytes; will contain the message, or zeroes if verification fails; may be equal to c. Only the mlen bytes of the message are written.
+ * mlen:    will contain the length of the message
+ * c:       pointer to clen bytes; the ciphertext and tag
+ * clen:    length of the ciphertext
+ * ad:      pointer to adlen bytes; the associated data
+ * adlen:   length of the associated data
+ * nonce:   pointer to FORKAE_PAEF_128_384_NONCE_SIZE bytes
+ * returns: 0 on success, -1 if the ciphertext is not authentic or malformed
+ */
+int forkae_c_paef_128_384_decrypt(const ForkAE128384Key_t *key, uint8_t *m, size_t *mlen, const uint8_t *c, size_t clen, const uint8_t *ad, size_t adlen, const uint8_t *nonce);
+
+/**
+ * Encrypts and authenticates a message with PAEF-Forkskinny-128-384, reading
+ * associated data and message from scatter/gather lists and writing the
+ * ciphertext to another one. Blocks that straddle buffers are handled
+ * internally; runs of blocks that lie in one buffer are processed where they
+ * are, without copies. The output list may be the input list, extended with
+ * a buffer for the padding and the tag, to encrypt in place.
+ * key:     key schedules (see forkae_c_128_384_init_key)
+ * c:       ccount buffers of at least FORKAE_PAEF_128_384_CIPHERTEXT_SIZE(mlen) bytes in total; will contain the ciphertext and tag
+ * clen:    will contain the length of the ciphertext
+ * m:       mcount buffers; the message of mlen bytes in total
+ * ad:      adcount buffers; the associated data
+ * nonce:   pointer to FORKAE_PAEF_128_384_NONCE_SIZE bytes; must be unique for each message under a key
+ * returns: 0 on success, -1 if the output is too short or the message or associated data has more than FORKAE_PAEF_128_384_MAX_BLOCKS blocks
+ */
+int forkae_c_paef_128_384_encrypt_iov(const ForkAE128384Key_t *key, const ForkAEIOVec_t *c, size_t ccount, size_t *clen, const ForkAEIOVec_t *m, size_t mcount, const ForkAEIOVec_t *ad, size_t adcount, const uint8_t *nonce);
+
+/**
+ * Decrypts and verifies a ciphertext with PAEF-Forkskinny-128-384, using
+ * scatter/gather lists as forkae_c_paef_128_384_encrypt_iov. The output list
+ * may be the input list to decrypt in place.
+ * key:     key schedules (see forkae_c_128_384_init_key)
+ * m:       mcount buffers of at least clen - FORKAE_PAEF_128_384_TAG_SIZE bytes in total; will contain the message, or zeroes if verification fails; only the mlen bytes of the message are written
+ * mlen:    will contain the length of the message
+ * c:       ccount buffers; the ciphertext and tag of clen bytes in total
+ * ad:      adcount buffers; the associated data
+ * nonce:   pointer to FORKAE_PAEF_128_384_NONCE_SIZE bytes
+ * returns: 0 on success, -1 if the ciphertext is not authentic or malformed, or the output is too short
+ */
+int forkae_c_paef_128_384_decrypt_iov(const ForkAE128384Key_t *key, const ForkAEIOVec_t *m, size_t mcount, size_t *mlen, const ForkAEIOVec_t *c, size_t ccount, const ForkAEIOVec_t *ad, size_t adcount, const uint8_t *nonce);
+
+/**
+ * Encrypts and authenticates a batch of independent messages with
+ * PAEF-Forkskinny-128-384, interleaving their blocks into the lanes of the
+ * parallel kernel.
+ * key:       key schedules (see forkae_c_128_384_init_key)
+ * messages:  the messages; output, outlen and result are set for each of them as in forkae_c_paef_128_384_encrypt, so output holds FORKAE_PAEF_128_384_CIPHERTEXT_SIZE(inlen) bytes
+ * count:     the number of messages
+ */
+void forkae_c_paef_128_384_encrypt_many(const ForkAE128384Key_t *key, ForkAEMessage_t *messages, size_t count);
+
+/**
+ * Decrypts and verifies a batch of independent ciphertexts with
+ * PAEF-Forkskinny-128-384. Every kernel call computes the message blocks and
+ * the left legs for the tags of many blocks at once. The final block of
+ * each ciphertext is decrypted both as a full and as a padded block in the
+ * same calls; the full 16-byte tag decides which one was sent, and the
+ * padding of the latter is checked in constant time.
+ * The message blocks are written to the output buffers as they are
+ * decrypted, before the tags are checked, so that every ciphertext is read
+ * only once: the output buffers hold unverified plaintext until the
+ * function returns, and must not be read (e.g. by another thread) before.
+ * The output of a ciphertext that fails verification is wiped before the
+ * function returns, so only outputs with result 0 hold plaintext then.
+ * key:       key schedules (see forkae_c_128_384_init_key)
+ * messages:  the ciphertexts; output, outlen and result are set for each of them as in forkae_c_paef_128_384_decrypt, so output holds inlen - FORKAE_PAEF_128_384_TAG_SIZE bytes
+ * count:     the number of ciphertexts
+ */
+void forkae_c_paef_128_384_decrypt_many(const ForkAE128384Key_t *key, ForkAEMessage_t *messages, size_t count);
+
+/**
+ * Encrypts and authenticates a large message with PAEF-Forkskinny-128-384,
+ * spreading the message blocks over the threads of a pool (see
+ * forkae-pool.h). Each chunk of blocks is processed with its own counters
+ * and contributes a partial tag, so the result is the same as for
+ * forkae_c_paef_128_384_encrypt.
+ * pool:    the thread pool; if NULL, the calling thread does all the work
+ * Other parameters and return value as for forkae_c_paef_128_384_encrypt.
+ */
+int forkae_c_paef_128_384_encrypt_pool(ForkAEPool_t *pool, const ForkAE128384Key_t *key, uint8_t *c, size_t *clen, const uint8_t *m, size_t mlen, const uint8_t *ad, size_t adlen, const uint8_t *nonce);
+
+/**
+ * Decrypts and verifies a large ciphertext with PAEF-Forkskinny-128-384,
+ * spreading the blocks over the threads of a pool (see forkae-pool.h).
+ * pool:    the thread pool; if NULL, the calling thread does all the work
+ * Other parameters and return value as for forkae_c_paef_128_384_decrypt.
+ */
+int forkae_c_paef_128_384_decrypt_pool(ForkAEPool_t *pool, const ForkAE128384Key_t *key, uint8_t *m, size_t *mlen, const uint8_t *c, size_t clen, const uint8_t *ad, size_t adlen, const uint8_t *nonce);
+
+/*
+ * Job manager for PAEF-Forkskinny-128-384, in the style of multi-buffer
+ * crypto libraries: independent encryption and decryption jobs, each with
+ * its own key, are submitted one at a time and collected until
+ * FORKAE_PAEF_128_384_MB_JOBS jobs of the same direction are waiting. These
+ * are then processed together like a call of the *_many functions, with
+ * blocks under different keys sharing the SIMD lanes (see the *_multikey
+ * kernels in forkskinny128-parallel.h).
+ *
+ * Completed jobs are returned by forkae_c_paef_128_384_mb_submit and
+ * forkae_c_paef_128_384_mb_get_completed in the order in which they
+ * complete, which is not necessarily the order of submission. Partial
+ * batches are only processed by forkae_c_paef_128_384_mb_flush: to bound
+ * latency, call it when the oldest queued job has waited long enough, or
+ * at the end of each round of an event loop.
+ *
+ * The jobs and their buffers belong to the caller and must stay valid
+ * until they are returned. A manager must not be used by several threads
+ * at the same time.
+ */
+
+#define FORKAE_PAEF_128_384_MB_JOBS 16
+
+/**
+ * An encryption or decryption job for the job manager
+ */
+typedef struct ForkAEPAEF128384Job_s
+{
+    /** Key schedules of the job (see forkae_c_128_384_init_key) */
+    const ForkAE128384Key_t *key;
+
+    /** 0 to encrypt, 1 to decrypt and verify */
+    int decrypt;
+
+    /** Nonce, associated data, input and output of the job; outlen and
+        result are set on completion as for the *_many functions. The
+        ciphertext is that of forkae_c_paef_128_384_encrypt, with the full
+        tag: an encryption job needs an output of
+        FORKAE_PAEF_128_384_CIPHERTEXT_SIZE(inlen) bytes, a decryption job
+        one of inlen - FORKAE_PAEF_128_384_TAG_SIZE bytes. The output of a
+        decryption job holds unverified plaintext while the job is being
+        processed, and is wiped if verification fails. */
+    ForkAEMessage_t message;
+
+    /** Not used by the manager, e.g. to find the connection of a job */
+    void *user;
+
+    /** Used by the manager while it owns the job */
+    struct ForkAEPAEF128384Job_s *next;
+
+} ForkAEPAEF128384Job_t;
+
+/**
+ * State of a job manager
+ */
+typedef struct
+{
+    /** Jobs waiting for a batch, for encryption and for decryption */
+    ForkAEPAEF128384Job_t *queued[2][FORKAE_PAEF_128_384_MB_JOBS];
+    unsigned count[2];
+
+    /** Completed jobs not returned yet, in order of completion */
+    ForkAEPAEF128384Job_t *first;
+    ForkAEPAEF128384Job_t *last;
+
+} ForkAEPAEF128384Manager_t;
+
+/**
+ * Initializes an empty job manager.
+ * manager:  the manager to initialize
+ */
+void forkae_c_paef_128_384_mb_init(ForkAEPAEF128384Manager_t *manager);
+
+/**
+ * Submits a job; the batch of its direction is processed if it is full.
+ * manager:  the manager
+ * job:      the job
+ * returns:  a completed job, or NULL if there is none
+ */
+ForkAEPAEF128384Job_t *forkae_c_paef_128_384_mb_submit(ForkAEPAEF128384Manager_t *manager, ForkAEPAEF128384Job_t *job);
+
+/**
+ * Returns the next completed job without processing anything.
+ * manager:  the manager
+ * returns:  a completed job, or NULL if there is none
+ */
+ForkAEPAEF128384Job_t *forkae_c_paef_128_384_mb_get_completed(ForkAEPAEF128384Manager_t *manager);
+
+/**
+ * Processes the partial batches, then returns the next completed job.
+ * Call it until it returns NULL to drain the manager.
+ * manager:  the manager
+ * returns:  a completed job, or NULL if the manager is empty
+ */
+ForkAEPAEF128384Job_t *forkae_c_paef_128_384_mb_flush(ForkAEPAEF128384Manager_t *manager);
+
+/**
+ * Returns the number of submitted jobs that are not processed yet.
+ * manager:  the manager
+ */
+unsigned forkae_c_paef_128_384_mb_queued(const ForkAEPAEF128384Manager_t *manager);
+
+/*
+ * RPAEF (reduced PAEF) differs from PAEF in the message blocks: all but the
+ * last one compute only the right leg, which is the ciphertext block, and
+ * their plaintext is XORed into the tag instead of a left leg. Only the last
+ * message block computes both legs. Associated data, tweak and ciphertext
+ * format, with the full tag, are the same as for PAEF (see
+ * FORKAE_PAEF_128_384_CIPHERTEXT_SIZE).
+ */
+
+/**
+ * Encrypts and authenticates a message with RPAEF-Forkskinny-128-384.
+ * Parameters and return value are the same as for forkae_c_paef_128_384_encrypt.
+ */
+int forkae_c_rpaef_128_384_encrypt(const ForkAE128384Key_t *key, uint8_t *c, size_t *clen, const uint8_t *m, size_t mlen, const uint8_t *ad, size_t adlen, const uint8_t *nonce);
+
+/**
+ * Decrypts and verifies a ciphertext with RPAEF-Forkskinny-128-384.
+ * Parameters and return value are the same as for forkae_c_paef_128_384_decrypt.
+ */
+int forkae_c_rpaef_128_384_decrypt(const ForkAE128384Key_t *key, uint8_t *m, size_t *mlen, const uint8_t *c, size_t clen, const uint8_t *ad, size_t adlen, const uint8_t *nonce);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // FORKSKINNY_C_FORKAE_PAEF_H
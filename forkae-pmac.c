@@ -0,0 +1,144 @@
+#include "forkae-pmac.h"
+#include "forkskinny128-parallel.h"
+#include "forkae-internal.h"
+#include <pthread.h>
+#include <stdlib.h>
+
+#define PMAC_128_BLOCK_SIZE FORKSKINNY128_BLOCK_SIZE
+
+/* Flags in the first byte of TK1 */
+#define PMAC_FLAG_BLOCK     0x00
+#define PMAC_FLAG_FINAL     0x01 /* the last block was full */
+#define PMAC_FLAG_FINAL_PAD 0x02 /* the last block was padded */
+
+/* Below this number of blocks per thread, threads are not worth it */
+#define PMAC_MIN_THREAD_BLOCKS 256
+
+static void pmac_128_set_tweak(uint8_t *tweak, unsigned flags, uint64_t index)
+{
+    unsigned posn;
+    tweak[0] = (uint8_t)flags;
+    memset(tweak + 1, 0, 7);
+    for (posn = 0; posn < 8; ++posn)
+        tweak[PMAC_128_BLOCK_SIZE - 1 - posn] = (uint8_t)(index >> (8 * posn));
+}
+
+void forkae_c_pmac_128_384_absorb
+    (const ForkAE128384Key_t *key, uint64_t index, const uint8_t *blocks,
+     size_t count, uint8_t *sum)
+{
+    uint8_t tweaks[FORKAE_PARALLEL_BLOCKS * PMAC_128_BLOCK_SIZE];
+    uint8_t legs[FORKAE_PARALLEL_BLOCKS * PMAC_128_BLOCK_SIZE];
+    size_t batch, block;
+
+    while (count > 0) {
+        batch = count < FORKAE_PARALLEL_BLOCKS ? count : FORKAE_PARALLEL_BLOCKS;
+        for (block = 0; block < batch; ++block, ++index) {
+            pmac_128_set_tweak
+                (tweaks + block * PMAC_128_BLOCK_SIZE, PMAC_FLAG_BLOCK, index);
+        }
+        forkskinny_c_128_384_encrypt_parallel
+            (tweaks, &key->tks2, &key->tks3, NULL, legs, blocks, batch);
+        forkae_absorb(sum, legs, batch, PMAC_128_BLOCK_SIZE);
+        blocks += batch * PMAC_128_BLOCK_SIZE;
+        count -= batch;
+    }
+}
+
+void forkae_c_pmac_128_384_final
+    (const ForkAE128384Key_t *key, uint8_t *tag, const uint8_t *sum,
+     const uint8_t *last, size_t lastlen)
+{
+    uint8_t tweak[PMAC_128_BLOCK_SIZE];
+    uint8_t block[PMAC_128_BLOCK_SIZE];
+
+    if (lastlen == PMAC_128_BLOCK_SIZE) {
+        skinny128_xor(block, sum, last);
+        pmac_128_set_tweak(tweak, PMAC_FLAG_FINAL, 0);
+    } else {
+        forkae_pad(block, last, lastlen, PMAC_128_BLOCK_SIZE);
+        skinny128_xor(block, block, sum);
+        pmac_128_set_tweak(tweak, PMAC_FLAG_FINAL_PAD, 0);
+    }
+    forkskinny_c_128_384_encrypt_parallel
+        (tweak, &key->tks2, &key->tks3, NULL, tag, block, 1);
+}
+
+void forkae_c_pmac_128_384
+    (const ForkAE128384Key_t *key, uint8_t *tag, const uint8_t *data,
+     size_t len)
+{
+    forkae_c_pmac_128_384_threaded(key, tag, data, len, 1);
+}
+
+/* Range of blocks absorbed by one thread */
+typedef struct
+{
+    const ForkAE128384Key_t *key;
+    uint64_t index;
+    const uint8_t *blocks;
+    size_t count;
+    uint8_t sum[PMAC_128_BLOCK_SIZE];
+
+} PMAC128Range_t;
+
+static void *pmac_128_384_thread(void *arg)
+{
+    PMAC128Range_t *range = (PMAC128Range_t *)arg;
+    forkae_c_pmac_128_384_absorb
+        (range->key, range->index, range->blocks, range->count, range->sum);
+    return NULL;
+}
+
+void forkae_c_pmac_128_384_threaded
+    (const ForkAE128384Key_t *key, uint8_t *tag, const uint8_t *data,
+     size_t len, unsigned threads)
+{
+    PMAC128Range_t *ranges;
+    pthread_t *ids;
+    int *started;
+    uint8_t sum[PMAC_128_BLOCK_SIZE];
+    size_t count = len > 0 ? (len - 1) / PMAC_128_BLOCK_SIZE : 0;
+    size_t share, posn;
+    unsigned thread;
+
+    memset(sum, 0, sizeof(sum));
+    if (threads > count / PMAC_MIN_THREAD_BLOCKS)
+        threads = (unsigned)(count / PMAC_MIN_THREAD_BLOCKS);
+    ranges = NULL;
+    if (threads > 1) {
+        ranges = (PMAC128Range_t *)malloc
+            (threads * (sizeof(PMAC128Range_t) + sizeof(pthread_t) + sizeof(int)));
+    }
+    if (!ranges) {
+        forkae_c_pmac_128_384_absorb(key, 0, data, count, sum);
+    } else {
+        /* Range 0 is absorbed by the calling thread; a range whose thread
+           cannot be started is absorbed by the caller as well */
+        ids = (pthread_t *)(ranges + threads);
+        started = (int *)(ids + threads);
+        for (thread = 0, posn = 0; thread < threads; ++thread) {
+            share = count / threads + (thread < count % threads);
+            ranges[thread].key = key;
+            ranges[thread].index = posn;
+            ranges[thread].blocks = data + posn * PMAC_128_BLOCK_SIZE;
+            ranges[thread].count = share;
+            memset(ranges[thread].sum, 0, PMAC_128_BLOCK_SIZE);
+            started[thread] = thread > 0 &&
+                pthread_create(&ids[thread], NULL, pmac_128_384_thread,
+                               &ranges[thread]) == 0;
+            posn += share;
+        }
+        for (thread = 0; thread < threads; ++thread) {
+            if (started[thread])
+                pthread_join(ids[thread], NULL);
+            else
+                pmac_128_384_thread(&ranges[thread]);
+            skinny128_xor(sum, sum, ranges[thread].sum);
+        }
+        free(ranges);
+    }
+    forkae_c_pmac_128_384_final
+        (key, tag, sum, data + count * PMAC_128_BLOCK_SIZE,
+         len - count * PMAC_128_BLOCK_SIZE);
+}
@@ -0,0 +1,71 @@
+#ifndef FORKSKINNY_C_FORKAE_PMAC_H
+#define FORKSKINNY_C_FORKAE_PMAC_H
+
+#include "forkae.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * PMAC-style parallel MAC on Forkskinny-128-384.
+ *
+ * Every block of the message but the last one is encrypted independently
+ * with only the right leg of the forkcipher; TK1 holds the index of the
+ * block (64 bits, big-endian, in the last 8 bytes) and TK2/TK3 the key. The
+ * outputs are XORed together with the (padded) last block, and the sum is
+ * encrypted once more with a final tweak to give the tag.
+ *
+ * As the blocks are independent, a message can be split into ranges that
+ * are absorbed separately (e.g. by several threads) with
+ * forkae_c_pmac_128_384_absorb; the sums are combined by XOR and passed to
+ * forkae_c_pmac_128_384_final together with the last block.
+ */
+
+#define FORKAE_PMAC_128_384_TAG_SIZE FORKSKINNY128_BLOCK_SIZE
+
+/**
+ * Absorbs a range of full blocks of a message into a partial sum.
+ * key:     key schedules (see forkae_c_128_384_init_key)
+ * index:   index of the first block of the range in the message (starting at 0)
+ * blocks:  pointer to count*FORKSKINNY128_BLOCK_SIZE bytes; the blocks; must not include the last block of the message
+ * count:   the number of blocks
+ * sum:     pointer to FORKSKINNY128_BLOCK_SIZE bytes; the partial sum to update (initially zero)
+ */
+void forkae_c_pmac_128_384_absorb(const ForkAE128384Key_t *key, uint64_t index, const uint8_t *blocks, size_t count, uint8_t *sum);
+
+/**
+ * Computes the tag from the combined sum of all blocks but the last one.
+ * key:     key schedules (see forkae_c_128_384_init_key)
+ * tag:     pointer to FORKAE_PMAC_128_384_TAG_SIZE bytes; will contain the tag
+ * sum:     pointer to FORKSKINNY128_BLOCK_SIZE bytes; XOR of the partial sums
+ * last:    pointer to lastlen bytes; the last block of the message, which may be full
+ * lastlen: length of the last block, at most FORKSKINNY128_BLOCK_SIZE (0 only for an empty message)
+ */
+void forkae_c_pmac_128_384_final(const ForkAE128384Key_t *key, uint8_t *tag, const uint8_t *sum, const uint8_t *last, size_t lastlen);
+
+/**
+ * Computes the tag of a message.
+ * key:     key schedules (see forkae_c_128_384_init_key)
+ * tag:     pointer to FORKAE_PMAC_128_384_TAG_SIZE bytes; will contain the tag
+ * data:    pointer to len bytes; the message
+ * len:     length of the message
+ */
+void forkae_c_pmac_128_384(const ForkAE128384Key_t *key, uint8_t *tag, const uint8_t *data, size_t len);
+
+/**
+ * Computes the tag of a message, splitting the blocks over several threads.
+ * The result is the same as for forkae_c_pmac_128_384.
+ * key:     key schedules (see forkae_c_128_384_init_key)
+ * tag:     pointer to FORKAE_PMAC_128_384_TAG_SIZE bytes; will contain the tag
+ * data:    pointer to len bytes; the message
+ * len:     length of the message
+ * threads: the number of threads to use, including the calling one
+ */
+void forkae_c_pmac_128_384_threaded(const ForkAE128384Key_t *key, uint8_t *tag, const uint8_t *data, size_t len, unsigned threads);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // FORKSKINNY_C_FORKAE_PMAC_H
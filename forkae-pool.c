@@ -0,0 +1,246 @@
+#include "forkae-pool.h"
+#include "forkae-internal.h"
+#include <pthread.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+/* Keeps the data of different threads on different cache lines */
+#define POOL_CACHE_LINE 64
+
+/* A thread of the pool with its range of chunks; slot 0 is the caller */
+typedef struct
+{
+    /** Protects next and end against thieves */
+    pthread_mutex_t lock;
+
+    /** Chunks [next, end) are still to be done by this thread */
+    size_t next;
+    size_t end;
+
+    uint8_t scratch[FORKAE_POOL_SCRATCH_SIZE];
+
+    ForkAEPool_t *pool;
+    pthread_t id;
+    unsigned index;
+
+    uint8_t padding[POOL_CACHE_LINE];
+
+} PoolWorker_t;
+
+struct ForkAEPool_s
+{
+    /** Serializes the bulk calls of different threads */
+    pthread_mutex_t run;
+
+    /** Protects the fields below; wake starts a run, done ends it */
+    pthread_mutex_t lock;
+    pthread_cond_t wake;
+    pthread_cond_t done;
+    unsigned generation;
+    unsigned active;
+    int stop;
+
+    /** The current run */
+    void (*chunk)(void *ctx, size_t index, uint8_t *scratch);
+    void *ctx;
+
+    unsigned threads;
+    PoolWorker_t *workers;
+};
+
+/* Takes the next chunk of the own range */
+static int pool_pop(PoolWorker_t *worker, size_t *index)
+{
+    int found = 0;
+    pthread_mutex_lock(&worker->lock);
+    if (worker->next < worker->end) {
+        *index = worker->next++;
+        found = 1;
+    }
+    pthread_mutex_unlock(&worker->lock);
+    return found;
+}
+
+/* Moves the second half of the range of another thread to this thread
+   and takes its first chunk */
+static int pool_steal(ForkAEPool_t *pool, PoolWorker_t *worker, size_t *index)
+{
+    PoolWorker_t *victim;
+    size_t start, end, take;
+    unsigned posn;
+
+    for (posn = 1; posn < pool->threads; ++posn) {
+        victim = &pool->workers[(worker->index + posn) % pool->threads];
+        pthread_mutex_lock(&victim->lock);
+        take = (victim->end - victim->next + 1) / 2;
+        end = victim->end;
+        victim->end -= take;
+        pthread_mutex_unlock(&victim->lock);
+        if (take > 0) {
+            start = end - take;
+            pthread_mutex_lock(&worker->lock);
+            worker->next = start + 1;
+            worker->end = end;
+            pthread_mutex_unlock(&worker->lock);
+            *index = start;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static void pool_work(ForkAEPool_t *pool, PoolWorker_t *worker)
+{
+    size_t index;
+    while (pool_pop(worker, &index) || pool_steal(pool, worker, &index))
+        (*pool->chunk)(pool->ctx, index, worker->scratch);
+}
+
+static void *pool_thread(void *arg)
+{
+    PoolWorker_t *worker = (PoolWorker_t *)arg;
+    ForkAEPool_t *pool = worker->pool;
+    unsigned generation = 0;
+
+    for (;;) {
+        pthread_mutex_lock(&pool->lock);
+        while (pool->generation == generation && !pool->stop)
+            pthread_cond_wait(&pool->wake, &pool->lock);
+        if (pool->stop) {
+            pthread_mutex_unlock(&pool->lock);
+            break;
+        }
+        generation = pool->generation;
+        pthread_mutex_unlock(&pool->lock);
+
+        pool_work(pool, worker);
+
+        pthread_mutex_lock(&pool->lock);
+        if (--(pool->active) == 0)
+            pthread_cond_signal(&pool->done);
+        pthread_mutex_unlock(&pool->lock);
+    }
+    return NULL;
+}
+
+ForkAEPool_t *forkae_c_pool_create(unsigned threads)
+{
+    ForkAEPool_t *pool;
+    PoolWorker_t *worker;
+    unsigned index;
+
+    if (threads == 0) {
+        long online = sysconf(_SC_NPROCESSORS_ONLN);
+        threads = online > 0 ? (unsigned)online : 1;
+    }
+    pool = (ForkAEPool_t *)malloc(sizeof(ForkAEPool_t));
+    if (!pool)
+        return NULL;
+    pool->workers = (PoolWorker_t *)malloc(threads * sizeof(PoolWorker_t));
+    if (!pool->workers) {
+        free(pool);
+        return NULL;
+    }
+    pthread_mutex_init(&pool->run, NULL);
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->wake, NULL);
+    pthread_cond_init(&pool->done, NULL);
+    pool->generation = 0;
+    pool->active = 0;
+    pool->stop = 0;
+
+    /* Slot 0 is the calling thread; keep the threads that could be started */
+    pool->threads = 0;
+    for (index = 0; index < threads; ++index) {
+        worker = &pool->workers[index];
+        pthread_mutex_init(&worker->lock, NULL);
+        worker->pool = pool;
+        worker->index = index;
+        if (index > 0 &&
+                pthread_create(&worker->id, NULL, pool_thread, worker) != 0) {
+            pthread_mutex_destroy(&worker->lock);
+            break;
+        }
+        pool->threads = index + 1;
+    }
+    return pool;
+}
+
+void forkae_c_pool_destroy(ForkAEPool_t *pool)
+{
+    unsigned index;
+
+    if (!pool)
+        return;
+    pthread_mutex_lock(&pool->lock);
+    pool->stop = 1;
+    pthread_cond_broadcast(&pool->wake);
+    pthread_mutex_unlock(&pool->lock);
+    for (index = 0; index < pool->threads; ++index) {
+        if (index > 0)
+            pthread_join(pool->workers[index].id, NULL);
+        pthread_mutex_destroy(&pool->workers[index].lock);
+    }
+    pthread_cond_destroy(&pool->done);
+    pthread_cond_destroy(&pool->wake);
+    pthread_mutex_destroy(&pool->lock);
+    pthread_mutex_destroy(&pool->run);
+    free(pool->workers);
+    free(pool);
+}
+
+unsigned forkae_c_pool_threads(const ForkAEPool_t *pool)
+{
+    return pool->threads;
+}
+
+void forkae_pool_run
+    (ForkAEPool_t *pool, size_t count,
+     void (*chunk)(void *ctx, size_t index, uint8_t *scratch),
+     void (*combine)(void *ctx, const uint8_t *scratch), void *ctx)
+{
+    uint8_t scratch[FORKAE_POOL_SCRATCH_SIZE];
+    PoolWorker_t *worker;
+    unsigned index;
+    size_t posn;
+
+    if (!pool || pool->threads == 1 || count < 2) {
+        memset(scratch, 0, sizeof(scratch));
+        for (posn = 0; posn < count; ++posn)
+            (*chunk)(ctx, posn, scratch);
+        if (combine)
+            (*combine)(ctx, scratch);
+        return;
+    }
+
+    pthread_mutex_lock(&pool->run);
+
+    /* Contiguous ranges of chunks, one per thread */
+    for (index = 0; index < pool->threads; ++index) {
+        worker = &pool->workers[index];
+        worker->next = count * index / pool->threads;
+        worker->end = count * (index + 1) / pool->threads;
+        memset(worker->scratch, 0, FORKAE_POOL_SCRATCH_SIZE);
+    }
+
+    pthread_mutex_lock(&pool->lock);
+    pool->chunk = chunk;
+    pool->ctx = ctx;
+    pool->active = pool->threads - 1;
+    ++(pool->generation);
+    pthread_cond_broadcast(&pool->wake);
+    pthread_mutex_unlock(&pool->lock);
+
+    pool_work(pool, &pool->workers[0]);
+
+    pthread_mutex_lock(&pool->lock);
+    while (pool->active > 0)
+        pthread_cond_wait(&pool->done, &pool->lock);
+    pthread_mutex_unlock(&pool->lock);
+
+    if (combine) {
+        for (index = 0; index < pool->threads; ++index)
+            (*combine)(ctx, pool->workers[index].scratch);
+    }
+    pthread_mutex_unlock(&pool->run);
+}
@@ -0,0 +1,55 @@
+#ifndef FORKSKINNY_C_FORKAE_POOL_H
+#define FORKSKINNY_C_FORKAE_POOL_H
+
+#include "forkae.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Thread pool for the bulk functions of the modes, e.g.
+ * forkae_c_ctr_128_384_xor_pool and forkae_c_paef_128_384_encrypt_pool.
+ *
+ * A bulk call splits its input into chunks of FORKAE_POOL_CHUNK_SIZE bytes,
+ * each with the counters (or keystream offsets) it has in the sequential
+ * computation, so the result is identical to that of the single-threaded
+ * function. Every thread starts on its own contiguous range of chunks,
+ * which keeps the memory a thread touches together (and on its NUMA node
+ * when pages are placed on first touch); a thread that runs out of work
+ * steals half of the remaining range of another thread.
+ *
+ * The calling thread takes part in the work. A pool may be shared by
+ * several threads; their bulk calls are run one after the other.
+ */
+
+/** Bytes of input per chunk; a multiple of the page size */
+#ifndef FORKAE_POOL_CHUNK_SIZE
+#define FORKAE_POOL_CHUNK_SIZE (256*1024)
+#endif
+
+/**
+ * Creates a thread pool.
+ * threads: the number of threads, including the calling one; 0 for the number of online processors
+ * returns: the pool, or NULL if it cannot be allocated
+ */
+ForkAEPool_t *forkae_c_pool_create(unsigned threads);
+
+/**
+ * Stops the threads of a pool and frees it.
+ * pool:    the pool; may be NULL
+ */
+void forkae_c_pool_destroy(ForkAEPool_t *pool);
+
+/**
+ * Returns the number of threads of a pool, including the calling one.
+ * This may be lower than requested if not all threads could be started.
+ * pool:    the pool
+ */
+unsigned forkae_c_pool_threads(const ForkAEPool_t *pool);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // FORKSKINNY_C_FORKAE_POOL_H
@@ -0,0 +1,223 @@
+#include "forkae-ring.h"
+#include "forkae-internal.h"
+
+/* Writes a 32-bit big-endian value */
+STATIC_INLINE void ring_write_be32(uint8_t *ptr, uint32_t value)
+{
+    ptr[0] = (uint8_t)(value >> 24);
+    ptr[1] = (uint8_t)(value >> 16);
+    ptr[2] = (uint8_t)(value >> 8);
+    ptr[3] = (uint8_t)value;
+}
+
+/* Reads a 32-bit big-endian value */
+STATIC_INLINE uint32_t ring_read_be32(const uint8_t *ptr)
+{
+    return ((uint32_t)ptr[0] << 24) | ((uint32_t)ptr[1] << 16) |
+           ((uint32_t)ptr[2] << 8) | ptr[3];
+}
+
+/* The nonce of a record is the ring id and its sequence number */
+STATIC_INLINE void ring_nonce(const ForkAERing_t *ring, uint8_t *nonce)
+{
+    uint64_t position = ring->position;
+    unsigned posn;
+    memcpy(nonce, ring->id, sizeof(ring->id));
+    for (posn = 0; posn < 8; ++posn)
+        nonce[FORKAE_PAEF_128_384_NONCE_SIZE - 1 - posn] =
+            (uint8_t)(position >> (8 * posn));
+}
+
+STATIC_INLINE uint8_t *ring_slot(const ForkAERing_t *ring)
+{
+    return ring->slots +
+           (size_t)(ring->position & (ring->count - 1)) * ring->slot_size;
+}
+
+/* The length of a record is stored in the last bytes of its slot, so that
+   the record starts at the start of the slot */
+STATIC_INLINE uint8_t *ring_slot_length(const ForkAERing_t *ring)
+{
+    return ring_slot(ring) + ring->slot_size - 4;
+}
+
+size_t forkae_c_ring_size(size_t count, size_t slot_size)
+{
+    return FORKAE_RING_CONTROL_SIZE + count * slot_size;
+}
+
+int forkae_c_ring_attach(ForkAERing_t *ring, const ForkAE128384Key_t *key, void *memory, size_t count, size_t slot_size, uint32_t id)
+{
+    uint8_t *control = (uint8_t *)memory;
+    if (count == 0 || (count & (count - 1)) != 0 ||
+            slot_size <= FORKAE_RING_SLOT_OVERHEAD ||
+            (uint64_t)slot_size - 4 > 0xFFFFFFFFU)
+        return -1;
+    ring->key = key;
+    ring->tail = (uint64_t *)control;
+    ring->head = (uint64_t *)(control + FORKAE_RING_ALIGN);
+    ring->slots = control + FORKAE_RING_CONTROL_SIZE;
+    ring->count = count;
+    ring->slot_size = slot_size;
+    ring_write_be32(ring->id, id);
+    ring->position = 0;
+    ring->limit = 0;
+    ring->busy = 0;
+    return 0;
+}
+
+int forkae_c_ring_create(ForkAERing_t *ring, const ForkAE128384Key_t *key, void *memory, size_t count, size_t slot_size, uint32_t id)
+{
+    if (forkae_c_ring_attach(ring, key, memory, count, slot_size, id))
+        return -1;
+    __atomic_store_n(ring->tail, 0, __ATOMIC_RELEASE);
+    __atomic_store_n(ring->head, 0, __ATOMIC_RELEASE);
+    return 0;
+}
+
+size_t forkae_c_ring_capacity(const ForkAERing_t *ring)
+{
+    /* Records are sealed padded to whole blocks */
+    return (ring->slot_size - FORKAE_RING_SLOT_OVERHEAD) &
+           ~(size_t)(FORKSKINNY128_BLOCK_SIZE - 1);
+}
+
+uint8_t *forkae_c_ring_reserve(ForkAERing_t *ring)
+{
+    /* The limit of the writer is the read position of the reader; a
+       position that is not within the last count records means full */
+    if (!ring->busy) {
+        if (ring->position - ring->limit >= ring->count) {
+            ring->limit = __atomic_load_n(ring->head, __ATOMIC_ACQUIRE);
+            if (ring->position - ring->limit >= ring->count)
+                return 0;
+        }
+        ring->busy = 1;
+    }
+    return ring_slot(ring);
+}
+
+int forkae_c_ring_commit(ForkAERing_t *ring, size_t len)
+{
+    uint8_t nonce[FORKAE_PAEF_128_384_NONCE_SIZE];
+    uint8_t *slot = ring_slot(ring);
+    size_t clen;
+    if (!ring->busy || len > forkae_c_ring_capacity(ring))
+        return -1;
+    ring_write_be32(ring_slot_length(ring), (uint32_t)len);
+    ring_nonce(ring, nonce);
+    forkae_c_paef_128_384_encrypt
+        (ring->key, slot, &clen, slot, len, 0, 0, nonce);
+    ring->busy = 0;
+    ++(ring->position);
+    __atomic_store_n(ring->tail, ring->position, __ATOMIC_RELEASE);
+    return 0;
+}
+
+int forkae_c_ring_send(ForkAERing_t *ring, const uint8_t *data, size_t len)
+{
+    uint8_t *record;
+    if (len > forkae_c_ring_capacity(ring))
+        return -1;
+    record = forkae_c_ring_reserve(ring);
+    if (!record)
+        return -1;
+    memcpy(record, data, len);
+    return forkae_c_ring_commit(ring, len);
+}
+
+/* Returns zero if the reader has no next record, or reads its length;
+   the length and the write position come from the writer and are checked
+   (a length that is too long makes the record fail). The length only
+   locates the tag: the length returned to the caller is the one that
+   decryption recovers from the authenticated record. */
+static int ring_next(ForkAERing_t *ring, size_t *len)
+{
+    if (ring->position == ring->limit) {
+        ring->limit = __atomic_load_n(ring->tail, __ATOMIC_ACQUIRE);
+        if (ring->limit - ring->position > ring->count)
+            ring->limit = ring->position;
+        if (ring->position == ring->limit)
+            return 0;
+    }
+    *len = ring_read_be32(ring_slot_length(ring));
+    return 1;
+}
+
+int forkae_c_ring_peek(ForkAERing_t *ring, uint8_t **data, size_t *len)
+{
+    uint8_t nonce[FORKAE_PAEF_128_384_NONCE_SIZE];
+    uint8_t *record = ring_slot(ring);
+    size_t clen;
+    if (!ring->busy) {
+        if (!ring_next(ring, &clen))
+            return 0;
+
+        /* Decryption overwrites the record in its slot, and wipes it if
+           verification fails; a record that fails can never verify
+           again, so it is consumed */
+        ring->busy = 1;
+        ring_nonce(ring, nonce);
+        if (clen > forkae_c_ring_capacity(ring) ||
+                forkae_c_paef_128_384_decrypt
+                    (ring->key, record, &ring->length, record,
+                     FORKAE_PAEF_128_384_CIPHERTEXT_SIZE(clen), 0, 0,
+                     nonce)) {
+            forkae_c_ring_release(ring);
+            return -1;
+        }
+    }
+    *data = record;
+    *len = ring->length;
+    return 1;
+}
+
+void forkae_c_ring_release(ForkAERing_t *ring)
+{
+    if (!ring->busy)
+        return;
+    ring->busy = 0;
+    ++(ring->position);
+    __atomic_store_n(ring->head, ring->position, __ATOMIC_RELEASE);
+}
+
+int forkae_c_ring_receive(ForkAERing_t *ring, uint8_t *data, size_t *len)
+{
+    uint8_t nonce[FORKAE_PAEF_128_384_NONCE_SIZE];
+    uint8_t tag[FORKAE_RING_TAG_SIZE];
+    ForkAEIOVec_t c[2];
+    ForkAEIOVec_t m;
+    size_t clen;
+
+    if (ring->busy) {
+        /* The record was opened in place by forkae_c_ring_peek */
+        uint8_t *record;
+        forkae_c_ring_peek(ring, &record, len);
+        memcpy(data, record, *len);
+        forkae_c_ring_release(ring);
+        return 1;
+    }
+    if (!ring_next(ring, &clen))
+        return 0;
+    if (clen > forkae_c_ring_capacity(ring))
+        return -1;
+
+    /* Take a snapshot of the padded record and its tag, then decrypt in
+       place */
+    clen = FORKAE_PAEF_128_384_CIPHERTEXT_SIZE(clen) - sizeof(tag);
+    memcpy(data, ring_slot(ring), clen);
+    memcpy(tag, ring_slot(ring) + clen, sizeof(tag));
+    c[0].iov_base = data;
+    c[0].iov_len = clen;
+    c[1].iov_base = tag;
+    c[1].iov_len = sizeof(tag);
+    m.iov_base = data;
+    m.iov_len = clen;
+    ring_nonce(ring, nonce);
+    if (forkae_c_paef_128_384_decrypt_iov
+            (ring->key, &m, 1, len, c, 2, 0, 0, nonce))
+        return -1;
+    ring->busy = 1;
+    forkae_c_ring_release(ring);
+    return 1;
+}
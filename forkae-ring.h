@@ -0,0 +1,174 @@
+#ifndef FORKSKINNY_C_FORKAE_RING_H
+#define FORKSKINNY_C_FORKAE_RING_H
+
+#include "forkae-paef.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Encrypted single-producer/single-consumer ring in shared memory.
+ *
+ * The ring lives in memory shared by a writer and a reader, e.g. a
+ * MAP_SHARED mapping of a shm_open object in two processes: a control
+ * block with the write and read positions on separate cache lines,
+ * followed by a power-of-two number of fixed-size slots. Every record is
+ * sealed in place in its slot with PAEF-Forkskinny-128-384: the nonce is
+ * the id of the ring and the sequence number of the record, so a record
+ * only verifies at its own position in its own ring, and records cannot
+ * be replayed, reordered or dropped unnoticed. A slot holds the record
+ * padded to whole blocks and the full tag from its start, so records are
+ * as aligned as the slots, and the length of the record (32 bits,
+ * big-endian) in its last 4 bytes.
+ *
+ * Writer and reader each keep their own handle, with private copies of
+ * the geometry of the ring; nothing read from the shared memory is used
+ * without checking it, and the length of a record is the one recovered
+ * from its full tag, so a misbehaving peer can only make records fail to
+ * verify. The key schedules hold no pointers, so both sides can use
+ * one ForkAE128384Key_t placed in a read-only shared mapping.
+ *
+ * Sending and receiving make no system calls and, with
+ * forkae_c_ring_reserve/commit and forkae_c_ring_peek/release, no copies;
+ * the positions are published with release/acquire atomics (GCC/clang
+ * builtins). A side that finds the ring full or empty polls again, or
+ * waits on a mechanism of its own choice.
+ */
+
+#define FORKAE_RING_TAG_SIZE FORKAE_PAEF_128_384_TAG_SIZE
+
+/** Alignment of the shared memory and size of the control block */
+#define FORKAE_RING_ALIGN 64
+#define FORKAE_RING_CONTROL_SIZE (2*FORKAE_RING_ALIGN)
+
+/** Bytes of a slot that do not hold the record */
+#define FORKAE_RING_SLOT_OVERHEAD (4 + FORKAE_RING_TAG_SIZE)
+
+/**
+ * Handle of one side of a ring, kept in private memory
+ */
+typedef struct
+{
+    /** Key schedules; may be in shared read-only memory */
+    const ForkAE128384Key_t *key;
+
+    /** Positions in the shared memory: records written and read */
+    uint64_t *tail;
+    uint64_t *head;
+
+    /** Slots in the shared memory, their number and size */
+    uint8_t *slots;
+    size_t count;
+    size_t slot_size;
+
+    /** Id of the ring, the first bytes of every nonce */
+    uint8_t id[4];
+
+    /** Position of this side, and the last known position of the other */
+    uint64_t position;
+    uint64_t limit;
+
+    /** Non-zero if the record at position is reserved or opened */
+    int busy;
+
+    /** Length of the record opened by forkae_c_ring_peek */
+    size_t length;
+
+} ForkAERing_t;
+
+/**
+ * Returns the size of the shared memory of a ring.
+ * count:     number of slots; a power of two
+ * slot_size: size of a slot, FORKAE_RING_SLOT_OVERHEAD bytes more than the longest record rounded up to whole blocks; preferably a multiple of FORKAE_RING_ALIGN, so that every record is aligned to it
+ */
+size_t forkae_c_ring_size(size_t count, size_t slot_size);
+
+/**
+ * Sets up a ring in shared memory and a handle on it. This is done by
+ * one side, before the other attaches.
+ * ring:      the handle to initialize
+ * key:       key schedules (see forkae_c_128_384_init_key); must stay valid while the ring is used
+ * memory:    forkae_c_ring_size(count, slot_size) bytes aligned to FORKAE_RING_ALIGN
+ * count:     number of slots; a power of two
+ * slot_size: size of a slot; more than FORKAE_RING_SLOT_OVERHEAD bytes
+ * id:        id of the ring; must be unique for each ring under the key
+ * returns:   0 on success, -1 if the parameters are invalid
+ */
+int forkae_c_ring_create(ForkAERing_t *ring, const ForkAE128384Key_t *key, void *memory, size_t count, size_t slot_size, uint32_t id);
+
+/**
+ * Attaches a handle to a ring set up by forkae_c_ring_create, with the
+ * same parameters.
+ * Parameters and return value as for forkae_c_ring_create.
+ */
+int forkae_c_ring_attach(ForkAERing_t *ring, const ForkAE128384Key_t *key, void *memory, size_t count, size_t slot_size, uint32_t id);
+
+/**
+ * Returns the length of the longest record of a ring, a multiple of the
+ * block size so that the padded record fits into its slot.
+ * ring:    the handle
+ */
+size_t forkae_c_ring_capacity(const ForkAERing_t *ring);
+
+/**
+ * Reserves the next slot of the writer, in which a record can be written
+ * in place. Calling it again before forkae_c_ring_commit returns the same
+ * slot.
+ * ring:    the handle of the writer
+ * returns: pointer to forkae_c_ring_capacity() bytes, or NULL if the ring is full
+ */
+uint8_t *forkae_c_ring_reserve(ForkAERing_t *ring);
+
+/**
+ * Seals the record in the reserved slot in place and publishes it.
+ * ring:    the handle of the writer
+ * len:     length of the record
+ * returns: 0 on success, -1 if no slot is reserved or len is too long
+ */
+int forkae_c_ring_commit(ForkAERing_t *ring, size_t len);
+
+/**
+ * Copies a record into the next slot, seals and publishes it.
+ * ring:    the handle of the writer
+ * data:    pointer to len bytes; the record
+ * len:     length of the record
+ * returns: 0 on success, -1 if the ring is full or len is too long
+ */
+int forkae_c_ring_send(ForkAERing_t *ring, const uint8_t *data, size_t len);
+
+/**
+ * Verifies and decrypts the next record in place in its slot. Calling it
+ * again before forkae_c_ring_release returns the same record. The record
+ * stays in shared memory, where the writer could still change it; a
+ * reader that does not trust the writer uses forkae_c_ring_receive.
+ * A record that is not authentic is wiped in its slot and consumed, and
+ * the next call goes on with the record after it.
+ * ring:    the handle of the reader
+ * data:    will point to the record
+ * len:     will contain the length of the record
+ * returns: 1 if there is a record, 0 if the ring is empty, -1 if the next record is not authentic; it is then consumed
+ */
+int forkae_c_ring_peek(ForkAERing_t *ring, uint8_t **data, size_t *len);
+
+/**
+ * Frees the slot of the record returned by forkae_c_ring_peek.
+ * ring:    the handle of the reader
+ */
+void forkae_c_ring_release(ForkAERing_t *ring);
+
+/**
+ * Copies the next record into private memory, then verifies and decrypts
+ * it there and frees its slot.
+ * ring:    the handle of the reader
+ * data:    pointer to forkae_c_ring_capacity() bytes; will contain the record, or zeroes if verification fails
+ * len:     will contain the length of the record
+ * returns: 1 if there is a record, 0 if the ring is empty, -1 if the next record is not authentic; it is then not consumed
+ */
+int forkae_c_ring_receive(ForkAERing_t *ring, uint8_t *data, size_t *len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // FORKSKINNY_C_FORKAE_RING_H
@@ -0,0 +1,387 @@
+#include "forkae-saef.h"
+#include "forkae-internal.h"
+
+#define SAEF_128_BLOCK_SIZE FORKSKINNY128_BLOCK_SIZE
+
+/* Marks the tweak of the first block, which holds the nonce */
+#define SAEF_FLAG_FIRST 0x08
+
+/* Status flags of the state */
+#define SAEF_STATUS_FIRST   0x01 /* the first block is not processed yet */
+#define SAEF_STATUS_AD      0x02 /* associated data has been absorbed */
+#define SAEF_STATUS_MESSAGE 0x04 /* the associated data is finished */
+#define SAEF_STATUS_TK1_AD  0x08 /* tks1_ad is computed */
+#define SAEF_STATUS_TK1_M   0x10 /* tks1_m is computed */
+
+static void saef_128_init_tk1
+    (const ForkAESAEF128State_t *state, ForkSkinny128Key_t *ks,
+     const uint8_t *nonce, unsigned flags)
+{
+    uint8_t tweak[SAEF_128_BLOCK_SIZE];
+
+    if (nonce)
+        memcpy(tweak, nonce, FORKAE_SAEF_128_NONCE_SIZE);
+    else
+        memset(tweak, 0, FORKAE_SAEF_128_NONCE_SIZE);
+    tweak[FORKAE_SAEF_128_NONCE_SIZE] = (uint8_t)flags;
+    if (state->tks3) {
+        forkskinny_c_128_384_init_tk1
+            (ks, tweak, FORKSKINNY_128_384_ROUNDS_BEFORE +
+                        2 * FORKSKINNY_128_384_ROUNDS_AFTER);
+    } else {
+        forkskinny_c_128_256_init_tk1
+            (ks, tweak, FORKSKINNY_128_256_ROUNDS_BEFORE +
+                        2 * FORKSKINNY_128_256_ROUNDS_AFTER);
+    }
+}
+
+/* Returns the TK1 schedule of the next block. The inner blocks of the
+   associated data and of the message share one schedule each, so only the
+   first and the last blocks need their own */
+static const ForkSkinny128Key_t *saef_128_tk1
+    (ForkAESAEF128State_t *state, ForkSkinny128Key_t *ks, unsigned flags)
+{
+    if (state->status & SAEF_STATUS_FIRST) {
+        state->status &= ~SAEF_STATUS_FIRST;
+        saef_128_init_tk1(state, ks, state->nonce, flags | SAEF_FLAG_FIRST);
+        return ks;
+    }
+    if (flags == FORKAE_FLAG_AD) {
+        if (!(state->status & SAEF_STATUS_TK1_AD)) {
+            saef_128_init_tk1(state, &state->tks1_ad, NULL, flags);
+            state->status |= SAEF_STATUS_TK1_AD;
+        }
+        return &state->tks1_ad;
+    }
+    if (flags == FORKAE_FLAG_M) {
+        if (!(state->status & SAEF_STATUS_TK1_M)) {
+            saef_128_init_tk1(state, &state->tks1_m, NULL, flags);
+            state->status |= SAEF_STATUS_TK1_M;
+        }
+        return &state->tks1_m;
+    }
+    saef_128_init_tk1(state, ks, NULL, flags);
+    return ks;
+}
+
+/* Processes one block of associated data (output == NULL) or message */
+static void saef_128_encrypt_block
+    (ForkAESAEF128State_t *state, unsigned flags, uint8_t *output,
+     const uint8_t *input)
+{
+    ForkSkinny128Key_t tks1;
+    const ForkSkinny128Key_t *ks1 = saef_128_tk1(state, &tks1, flags);
+    uint8_t block[SAEF_128_BLOCK_SIZE];
+    uint8_t chain[SAEF_128_BLOCK_SIZE];
+
+    skinny128_xor(block, input, state->chain);
+    memcpy(chain, state->chain, SAEF_128_BLOCK_SIZE);
+    if (state->tks3) {
+        forkskinny_c_128_384_encrypt
+            (ks1, state->tks2, state->tks3, state->chain, output, block);
+    } else {
+        forkskinny_c_128_256_encrypt
+            (ks1, state->tks2, state->chain, output, block);
+    }
+    if (output)
+        skinny128_xor(output, output, chain);
+}
+
+/* Inverts one message block */
+static void saef_128_decrypt_block
+    (ForkAESAEF128State_t *state, unsigned flags, uint8_t *output,
+     const uint8_t *input)
+{
+    ForkSkinny128Key_t tks1;
+    const ForkSkinny128Key_t *ks1 = saef_128_tk1(state, &tks1, flags);
+    uint8_t block[SAEF_128_BLOCK_SIZE];
+    uint8_t chain[SAEF_128_BLOCK_SIZE];
+
+    skinny128_xor(block, input, state->chain);
+    memcpy(chain, state->chain, SAEF_128_BLOCK_SIZE);
+    if (state->tks3) {
+        forkskinny_c_128_384_decrypt
+            (ks1, state->tks2, state->tks3, state->chain, output, block);
+    } else {
+        forkskinny_c_128_256_decrypt
+            (ks1, state->tks2, state->chain, output, block);
+    }
+    skinny128_xor(output, output, chain);
+}
+
+/* Processes the held back associated data once it is known whether the
+   message is empty (final) */
+static void saef_128_finish_ad(ForkAESAEF128State_t *state, int final)
+{
+    uint8_t block[SAEF_128_BLOCK_SIZE];
+
+    if (state->status & SAEF_STATUS_MESSAGE)
+        return;
+    state->status |= SAEF_STATUS_MESSAGE;
+
+    /* An empty message is authenticated by the associated data alone,
+       which then consists of at least one (padded) block */
+    if (!(state->status & SAEF_STATUS_AD) && !final)
+        return;
+    if (state->adlen == SAEF_128_BLOCK_SIZE) {
+        saef_128_encrypt_block
+            (state, final ? FORKAE_FLAG_AD_FINAL : FORKAE_FLAG_AD_LAST,
+             NULL, state->ad);
+    } else {
+        forkae_pad(block, state->ad, state->adlen, SAEF_128_BLOCK_SIZE);
+        saef_128_encrypt_block
+            (state, final ? FORKAE_FLAG_AD_FINAL_PAD : FORKAE_FLAG_AD_LAST_PAD,
+             NULL, block);
+    }
+}
+
+static void saef_128_init
+    (ForkAESAEF128State_t *state, const ForkSkinny128Key_t *tks2,
+     const ForkSkinny128Key_t *tks3, const uint8_t *nonce)
+{
+    state->tks2 = tks2;
+    state->tks3 = tks3;
+    memcpy(state->nonce, nonce, FORKAE_SAEF_128_NONCE_SIZE);
+    memset(state->chain, 0, SAEF_128_BLOCK_SIZE);
+    state->adlen = 0;
+    state->buflen = 0;
+    state->status = SAEF_STATUS_FIRST;
+}
+
+void forkae_c_saef_128_256_init
+    (ForkAESAEF128State_t *state, const ForkAE128256Key_t *key,
+     const uint8_t *nonce)
+{
+    saef_128_init(state, &key->tks2, NULL, nonce);
+}
+
+void forkae_c_saef_128_384_init
+    (ForkAESAEF128State_t *state, const ForkAE128384Key_t *key,
+     const uint8_t *nonce)
+{
+    saef_128_init(state, &key->tks2, &key->tks3, nonce);
+}
+
+void forkae_c_saef_128_update_ad
+    (ForkAESAEF128State_t *state, const uint8_t *ad, size_t adlen)
+{
+    size_t len;
+
+    if (adlen == 0)
+        return;
+    state->status |= SAEF_STATUS_AD;
+
+    /* The last block is held back until its flags are known */
+    while (state->adlen + adlen > SAEF_128_BLOCK_SIZE) {
+        if (state->adlen == 0) {
+            saef_128_encrypt_block(state, FORKAE_FLAG_AD, NULL, ad);
+            ad += SAEF_128_BLOCK_SIZE;
+            adlen -= SAEF_128_BLOCK_SIZE;
+            continue;
+        }
+        len = SAEF_128_BLOCK_SIZE - state->adlen;
+        memcpy(state->ad + state->adlen, ad, len);
+        saef_128_encrypt_block(state, FORKAE_FLAG_AD, NULL, state->ad);
+        ad += len;
+        adlen -= len;
+        state->adlen = 0;
+    }
+    memcpy(state->ad + state->adlen, ad, adlen);
+    state->adlen += (unsigned)adlen;
+}
+
+/* Processes all blocks of the input except the last held bytes, which may
+   belong to the final block (and the tag). Once bytes are buffered, the
+   output runs ahead of the input by the buffered length; every output block
+   is therefore only written after the input bytes it covers have been read
+   into the buffer, so that the output may be the input. */
+static size_t saef_128_update
+    (ForkAESAEF128State_t *state, uint8_t *output, const uint8_t *input,
+     size_t len, unsigned held, int decrypt)
+{
+    size_t written = 0;
+    size_t consumed = 0;
+    size_t fill;
+
+    while (state->buflen + len > held) {
+        saef_128_finish_ad(state, 0);
+        if (state->buflen == 0) {
+            /* Process directly from the input */
+            if (decrypt)
+                saef_128_decrypt_block(state, FORKAE_FLAG_M, output, input);
+            else
+                saef_128_encrypt_block(state, FORKAE_FLAG_M, output, input);
+            input += SAEF_128_BLOCK_SIZE;
+            len -= SAEF_128_BLOCK_SIZE;
+            consumed += SAEF_128_BLOCK_SIZE;
+        } else {
+            if (consumed < written + SAEF_128_BLOCK_SIZE) {
+                fill = written + SAEF_128_BLOCK_SIZE - consumed;
+                if (fill > len)
+                    fill = len;
+                memcpy(state->buffer + state->buflen, input, fill);
+                state->buflen += (unsigned)fill;
+                input += fill;
+                len -= fill;
+                consumed += fill;
+            }
+            if (decrypt)
+                saef_128_decrypt_block(state, FORKAE_FLAG_M, output, state->buffer);
+            else
+                saef_128_encrypt_block(state, FORKAE_FLAG_M, output, state->buffer);
+            state->buflen -= SAEF_128_BLOCK_SIZE;
+            memmove(state->buffer, state->buffer + SAEF_128_BLOCK_SIZE,
+                    state->buflen);
+        }
+        output += SAEF_128_BLOCK_SIZE;
+        written += SAEF_128_BLOCK_SIZE;
+    }
+    memcpy(state->buffer + state->buflen, input, len);
+    state->buflen += (unsigned)len;
+    return written;
+}
+
+size_t forkae_c_saef_128_encrypt_update
+    (ForkAESAEF128State_t *state, uint8_t *c, const uint8_t *m, size_t mlen)
+{
+    return saef_128_update(state, c, m, mlen, SAEF_128_BLOCK_SIZE, 0);
+}
+
+size_t forkae_c_saef_128_encrypt_final(ForkAESAEF128State_t *state, uint8_t *c)
+{
+    uint8_t block[SAEF_128_BLOCK_SIZE];
+    unsigned last = state->buflen;
+
+    saef_128_finish_ad(state, last == 0);
+    if (last == 0) {
+        memcpy(c, state->chain, FORKAE_SAEF_128_TAG_SIZE);
+        return FORKAE_SAEF_128_TAG_SIZE;
+    }
+
+    /* The last message block is output in full, followed by as much of
+       the tag as the block had message bytes */
+    if (last == SAEF_128_BLOCK_SIZE) {
+        saef_128_encrypt_block(state, FORKAE_FLAG_M_LAST, c, state->buffer);
+    } else {
+        forkae_pad(block, state->buffer, last, SAEF_128_BLOCK_SIZE);
+        saef_128_encrypt_block(state, FORKAE_FLAG_M_LAST_PAD, c, block);
+    }
+    memcpy(c + SAEF_128_BLOCK_SIZE, state->chain, last);
+    return SAEF_128_BLOCK_SIZE + last;
+}
+
+size_t forkae_c_saef_128_decrypt_update
+    (ForkAESAEF128State_t *state, uint8_t *m, const uint8_t *c, size_t clen)
+{
+    return saef_128_update
+        (state, m, c, clen, SAEF_128_BLOCK_SIZE + FORKAE_SAEF_128_TAG_SIZE, 1);
+}
+
+int forkae_c_saef_128_decrypt_final
+    (ForkAESAEF128State_t *state, uint8_t *m, size_t *mlen)
+{
+    uint8_t block[SAEF_128_BLOCK_SIZE];
+    unsigned last;
+    uint8_t diff;
+
+    *mlen = 0;
+    if (state->buflen < FORKAE_SAEF_128_TAG_SIZE)
+        return -1;
+    if (state->buflen == FORKAE_SAEF_128_TAG_SIZE) {
+        saef_128_finish_ad(state, 1);
+        diff = forkae_compare
+            (state->chain, state->buffer, FORKAE_SAEF_128_TAG_SIZE);
+        return diff ? -1 : 0;
+    }
+
+    /* The last ciphertext block is followed by the truncated tag */
+    last = state->buflen - SAEF_128_BLOCK_SIZE;
+    saef_128_finish_ad(state, 0);
+    saef_128_decrypt_block
+        (state, last == SAEF_128_BLOCK_SIZE ? FORKAE_FLAG_M_LAST
+                                           : FORKAE_FLAG_M_LAST_PAD,
+         block, state->buffer);
+    diff = forkae_compare
+        (state->chain, state->buffer + SAEF_128_BLOCK_SIZE, last);
+    if (last < SAEF_128_BLOCK_SIZE)
+        diff |= forkae_check_pad(block, last, SAEF_128_BLOCK_SIZE);
+    if (diff) {
+        memset(m, 0, last);
+        return -1;
+    }
+    memcpy(m, block, last);
+    *mlen = last;
+    return 0;
+}
+
+static void saef_128_encrypt
+    (ForkAESAEF128State_t *state, uint8_t *c, size_t *clen,
+     const uint8_t *m, size_t mlen, const uint8_t *ad, size_t adlen)
+{
+    size_t len;
+
+    forkae_c_saef_128_update_ad(state, ad, adlen);
+    len = forkae_c_saef_128_encrypt_update(state, c, m, mlen);
+    *clen = len + forkae_c_saef_128_encrypt_final(state, c + len);
+}
+
+static int saef_128_decrypt
+    (ForkAESAEF128State_t *state, uint8_t *m, size_t *mlen,
+     const uint8_t *c, size_t clen, const uint8_t *ad, size_t adlen)
+{
+    size_t len, last;
+    int result;
+
+    forkae_c_saef_128_update_ad(state, ad, adlen);
+    len = forkae_c_saef_128_decrypt_update(state, m, c, clen);
+    result = forkae_c_saef_128_decrypt_final(state, m + len, &last);
+    if (result != 0) {
+        /* Retract the plaintext released by the update */
+        *mlen = clen >= FORKAE_SAEF_128_TAG_SIZE
+              ? clen - FORKAE_SAEF_128_TAG_SIZE : 0;
+        memset(m, 0, *mlen);
+        return result;
+    }
+    *mlen = len + last;
+    return 0;
+}
+
+void forkae_c_saef_128_256_encrypt
+    (const ForkAE128256Key_t *key, uint8_t *c, size_t *clen,
+     const uint8_t *m, size_t mlen, const uint8_t *ad, size_t adlen,
+     const uint8_t *nonce)
+{
+    ForkAESAEF128State_t state;
+    forkae_c_saef_128_256_init(&state, key, nonce);
+    saef_128_encrypt(&state, c, clen, m, mlen, ad, adlen);
+}
+
+int forkae_c_saef_128_256_decrypt
+    (const ForkAE128256Key_t *key, uint8_t *m, size_t *mlen,
+     const uint8_t *c, size_t clen, const uint8_t *ad, size_t adlen,
+     const uint8_t *nonce)
+{
+    ForkAESAEF128State_t state;
+    forkae_c_saef_128_256_init(&state, key, nonce);
+    return saef_128_decrypt(&state, m, mlen, c, clen, ad, adlen);
+}
+
+void forkae_c_saef_128_384_encrypt
+    (const ForkAE128384Key_t *key, uint8_t *c, size_t *clen,
+     const uint8_t *m, size_t mlen, const uint8_t *ad, size_t adlen,
+     const uint8_t *nonce)
+{
+    ForkAESAEF128State_t state;
+    forkae_c_saef_128_384_init(&state, key, nonce);
+    saef_128_encrypt(&state, c, clen, m, mlen, ad, adlen);
+}
+
+int forkae_c_saef_128_384_decrypt
+    (const ForkAE128384Key_t *key, uint8_t *m, size_t *mlen,
+     const uint8_t *c, size_t clen, const uint8_t *ad, size_t adlen,
+     const uint8_t *nonce)
+{
+    ForkAESAEF128State_t state;
+    forkae_c_saef_128_384_init(&state, key, nonce);
+    return saef_128_decrypt(&state, m, mlen, c, clen, ad, adlen);
+}
@@ -0,0 +1,196 @@
+#ifndef FORKSKINNY_C_FORKAE_SAEF_H
+#define FORKSKINNY_C_FORKAE_SAEF_H
+
+#include "forkae.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * SAEF (sequential ForkAE) authenticated encryption.
+ *
+ * The blocks of associated data and message are chained: the input of every
+ * forkcipher call is XORed with the left leg of the previous call (zero for
+ * the first block), and the left leg of the final call is the tag. Message
+ * blocks produce the ciphertext block in the right leg, XORed with the same
+ * chaining value. The tweak TK1 of the first block is the nonce followed by
+ * the flags, all later blocks use a zero nonce. There is no block counter,
+ * so the length of a message is not limited.
+ *
+ * The ciphertext is exactly FORKAE_SAEF_128_TAG_SIZE bytes longer than the
+ * message: the last message block is output padded to a whole block, and
+ * is followed by as many bytes of the tag as it has message bytes. An
+ * empty message gives the full tag alone.
+ *
+ * Besides the one-shot functions, the mode offers a streaming interface:
+ * forkae_c_saef_128_*_init, then any number of forkae_c_saef_128_update_ad,
+ * then any number of forkae_c_saef_128_encrypt_update (or _decrypt_update)
+ * and finally forkae_c_saef_128_encrypt_final (or _decrypt_final). The
+ * state keeps at most three blocks of input, so payloads of any size can be
+ * processed in chunks of any size. Each chunk may be encrypted or decrypted
+ * in place, whatever the sizes of the earlier chunks.
+ */
+
+#define FORKAE_SAEF_128_NONCE_SIZE 15
+
+#define FORKAE_SAEF_128_TAG_SIZE FORKSKINNY128_BLOCK_SIZE
+
+/**
+ * State of a streaming SAEF encryption or decryption on Forkskinny-128-256
+ * or Forkskinny-128-384. The key must stay valid while the state is in use.
+ */
+typedef struct
+{
+    /** Key schedules for TK2 and TK3 (NULL for Forkskinny-128-256) */
+    const ForkSkinny128Key_t *tks2;
+    const ForkSkinny128Key_t *tks3;
+
+    /** TK1 schedules of the blocks after the first one, computed on use */
+    ForkSkinny128Key_t tks1_ad;
+    ForkSkinny128Key_t tks1_m;
+
+    /** The nonce, used for the first block */
+    uint8_t nonce[FORKAE_SAEF_128_NONCE_SIZE];
+
+    /** Left leg of the previous block */
+    uint8_t chain[FORKSKINNY128_BLOCK_SIZE];
+
+    /** Input not processed yet, held back until it is known whether it
+        contains the last block (and the tag when decrypting), and input
+        read ahead of the output of an update */
+    uint8_t ad[FORKSKINNY128_BLOCK_SIZE];
+    uint8_t buffer[3*FORKSKINNY128_BLOCK_SIZE];
+    unsigned adlen;
+    unsigned buflen;
+
+    /** Internal status flags */
+    unsigned status;
+
+} ForkAESAEF128State_t;
+
+/**
+ * Starts a streaming SAEF-Forkskinny-128-256 encryption or decryption.
+ * state:   the state to initialize
+ * key:     key schedule (see forkae_c_128_256_init_key)
+ * nonce:   pointer to FORKAE_SAEF_128_NONCE_SIZE bytes; must be unique for each message under a key
+ */
+void forkae_c_saef_128_256_init(ForkAESAEF128State_t *state, const ForkAE128256Key_t *key, const uint8_t *nonce);
+
+/**
+ * Starts a streaming SAEF-Forkskinny-128-384 encryption or decryption.
+ * state:   the state to initialize
+ * key:     key schedules (see forkae_c_128_384_init_key)
+ * nonce:   pointer to FORKAE_SAEF_128_NONCE_SIZE bytes; must be unique for each message under a key
+ */
+void forkae_c_saef_128_384_init(ForkAESAEF128State_t *state, const ForkAE128384Key_t *key, const uint8_t *nonce);
+
+/**
+ * Absorbs the next chunk of associated data. Must not be called after the
+ * first message or ciphertext chunk.
+ * state:   the state
+ * ad:      pointer to adlen bytes; the associated data
+ * adlen:   length of the chunk
+ */
+void forkae_c_saef_128_update_ad(ForkAESAEF128State_t *state, const uint8_t *ad, size_t adlen);
+
+/**
+ * Encrypts the next chunk of the message. The last block seen so far is
+ * held back, so the output may lag the input by up to one block.
+ * state:   the state
+ * c:       pointer to mlen + FORKSKINNY128_BLOCK_SIZE - 1 bytes; will contain the next bytes of the ciphertext; may be equal to m (an output block is written only after the input it covers has been read)
+ * m:       pointer to mlen bytes; the message
+ * mlen:    length of the chunk
+ * returns: the number of ciphertext bytes written (a multiple of FORKSKINNY128_BLOCK_SIZE)
+ */
+size_t forkae_c_saef_128_encrypt_update(ForkAESAEF128State_t *state, uint8_t *c, const uint8_t *m, size_t mlen);
+
+/**
+ * Finishes an encryption, writing the last ciphertext block and the tag.
+ * state:   the state; must be initialized again before it is reused
+ * c:       pointer to 2*FORKSKINNY128_BLOCK_SIZE bytes; will contain the rest of the ciphertext
+ * returns: the number of ciphertext bytes written
+ */
+size_t forkae_c_saef_128_encrypt_final(ForkAESAEF128State_t *state, uint8_t *c);
+
+/**
+ * Decrypts the next chunk of the ciphertext. The last two blocks seen so far
+ * are held back, as they may contain the tag.
+ * The plaintext is released before the tag is verified: it must not be used
+ * until forkae_c_saef_128_decrypt_final succeeds.
+ * state:   the state
+ * m:       pointer to clen + FORKSKINNY128_BLOCK_SIZE - 1 bytes; will contain the next bytes of the message; may be equal to c (an output block is written only after the input it covers has been read)
+ * c:       pointer to clen bytes; the ciphertext
+ * clen:    length of the chunk
+ * returns: the number of message bytes written (a multiple of FORKSKINNY128_BLOCK_SIZE)
+ */
+size_t forkae_c_saef_128_decrypt_update(ForkAESAEF128State_t *state, uint8_t *m, const uint8_t *c, size_t clen);
+
+/**
+ * Finishes a decryption, writing the last message bytes and verifying the tag.
+ * state:   the state; must be initialized again before it is reused
+ * m:       pointer to FORKSKINNY128_BLOCK_SIZE bytes; will contain the rest of the message, or zeroes if verification fails
+ * mlen:    will contain the number of message bytes written
+ * returns: 0 on success, -1 if the ciphertext is not authentic or malformed
+ */
+int forkae_c_saef_128_decrypt_final(ForkAESAEF128State_t *state, uint8_t *m, size_t *mlen);
+
+/**
+ * Encrypts and authenticates a message with SAEF-Forkskinny-128-256.
+ * key:     key schedule (see forkae_c_128_256_init_key)
+ * c:       pointer to mlen + FORKAE_SAEF_128_TAG_SIZE bytes; will contain the ciphertext and tag; may be equal to m
+ * clen:    will contain the length of the ciphertext
+ * m:       pointer to mlen bytes; the message
+ * mlen:    length of the message
+ * ad:      pointer to adlen bytes; the associated data
+ * adlen:   length of the associated data
+ * nonce:   pointer to FORKAE_SAEF_128_NONCE_SIZE bytes; must be unique for each message under a key
+ */
+void forkae_c_saef_128_256_encrypt(const ForkAE128256Key_t *key, uint8_t *c, size_t *clen, const uint8_t *m, size_t mlen, const uint8_t *ad, size_t adlen, const uint8_t *nonce);
+
+/**
+ * Decrypts and verifies a ciphertext with SAEF-Forkskinny-128-256.
+ * key:     key schedule (see forkae_c_128_256_init_key)
+ * m:       pointer to clen - FORKAE_SAEF_128_TAG_SIZE bytes; will contain the message, or zeroes if verification fails; may be equal to c
+ * mlen:    will contain the length of the message
+ * c:       pointer to clen bytes; the ciphertext and tag
+ * clen:    length of the ciphertext
+ * ad:      pointer to adlen bytes; the associated data
+ * adlen:   length of the associated data
+ * nonce:   pointer to FORKAE_SAEF_128_NONCE_SIZE bytes
+ * returns: 0 on success, -1 if the ciphertext is not authentic or malformed
+ */
+int forkae_c_saef_128_256_decrypt(const ForkAE128256Key_t *key, uint8_t *m, size_t *mlen, const uint8_t *c, size_t clen, const uint8_t *ad, size_t adlen, const uint8_t *nonce);
+
+/**
+ * Encrypts and authenticates a message with SAEF-Forkskinny-128-384.
+ * key:     key schedules (see forkae_c_128_384_init_key)
+ * c:       pointer to mlen + FORKAE_SAEF_128_TAG_SIZE bytes; will contain the ciphertext and tag; may be equal to m
+ * clen:    will contain the length of the ciphertext
+ * m:       pointer to mlen bytes; the message
+ * mlen:    length of the message
+ * ad:      pointer to adlen bytes; the associated data
+ * adlen:   length of the associated data
+ * nonce:   pointer to FORKAE_SAEF_128_NONCE_SIZE bytes; must be unique for each message under a key
+ */
+void forkae_c_saef_128_384_encrypt(const ForkAE128384Key_t *key, uint8_t *c, size_t *clen, const uint8_t *m, size_t mlen, const uint8_t *ad, size_t adlen, const uint8_t *nonce);
+
+/**
+ * Decrypts and verifies a ciphertext with SAEF-Forkskinny-128-384.
+ * key:     key schedules (see forkae_c_128_384_init_key)
+ * m:       pointer to clen - FORKAE_SAEF_128_TAG_SIZE bytes; will contain the message, or zeroes if verification fails; may be equal to c
+ * mlen:    will contain the length of the message
+ * c:       pointer to clen bytes; the ciphertext and tag
+ * clen:    length of the ciphertext
+ * ad:      pointer to adlen bytes; the associated data
+ * adlen:   length of the associated data
+ * nonce:   pointer to FORKAE_SAEF_128_NONCE_SIZE bytes
+ * returns: 0 on success, -1 if the ciphertext is not authentic or malformed
+ */
+int forkae_c_saef_128_384_decrypt(const ForkAE128384Key_t *key, uint8_t *m, size_t *mlen, const uint8_t *c, size_t clen, const uint8_t *ad, size_t adlen, const uint8_t *nonce);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // FORKSKINNY_C_FORKAE_SAEF_H
@@ -0,0 +1,90 @@
+#include "forkae-sector.h"
+#include "forkskinny128-parallel.h"
+#include "forkae-internal.h"
+
+#define SECTOR_PAGE_BLOCKS (FORKAE_SECTOR_PAGE_SIZE / FORKAE_SECTOR_BLOCK_SIZE)
+
+/* Writes a 64-bit big-endian value */
+STATIC_INLINE void sector_write_be64(uint8_t *ptr, uint64_t value)
+{
+    unsigned posn;
+    for (posn = 0; posn < 8; ++posn)
+        ptr[7 - posn] = (uint8_t)(value >> (8 * posn));
+}
+
+static int sector_128_process
+    (const ForkSkinny128Key_t *tks2, const ForkSkinny128Key_t *tks3,
+     uint64_t sector, uint8_t *output, const uint8_t *input, size_t len,
+     int decrypt)
+{
+    uint8_t tweaks[SECTOR_PAGE_BLOCKS * FORKAE_SECTOR_BLOCK_SIZE];
+    uint64_t index = 0;
+    size_t count, block;
+
+    if (len % FORKAE_SECTOR_BLOCK_SIZE)
+        return -1;
+    count = len / FORKAE_SECTOR_BLOCK_SIZE;
+    if (count > SECTOR_PAGE_BLOCKS)
+        count = SECTOR_PAGE_BLOCKS;
+
+    /* The sector number is the same in all tweaks */
+    for (block = 0; block < count; ++block)
+        sector_write_be64(tweaks + block * FORKAE_SECTOR_BLOCK_SIZE, sector);
+
+    while (len > 0) {
+        count = len / FORKAE_SECTOR_BLOCK_SIZE;
+        if (count > SECTOR_PAGE_BLOCKS)
+            count = SECTOR_PAGE_BLOCKS;
+        for (block = 0; block < count; ++block, ++index) {
+            sector_write_be64
+                (tweaks + block * FORKAE_SECTOR_BLOCK_SIZE + 8, index);
+        }
+        if (tks3 && decrypt) {
+            forkskinny_c_128_384_decrypt_parallel
+                (tweaks, tks2, tks3, NULL, output, input, count);
+        } else if (tks3) {
+            forkskinny_c_128_384_encrypt_parallel
+                (tweaks, tks2, tks3, NULL, output, input, count);
+        } else if (decrypt) {
+            forkskinny_c_128_256_decrypt_parallel
+                (tweaks, tks2, NULL, output, input, count);
+        } else {
+            forkskinny_c_128_256_encrypt_parallel
+                (tweaks, tks2, NULL, output, input, count);
+        }
+        output += count * FORKAE_SECTOR_BLOCK_SIZE;
+        input += count * FORKAE_SECTOR_BLOCK_SIZE;
+        len -= count * FORKAE_SECTOR_BLOCK_SIZE;
+    }
+    return 0;
+}
+
+int forkae_c_sector_128_256_encrypt
+    (const ForkAE128256Key_t *key, uint64_t sector, uint8_t *output,
+     const uint8_t *input, size_t len)
+{
+    return sector_128_process(&key->tks2, NULL, sector, output, input, len, 0);
+}
+
+int forkae_c_sector_128_256_decrypt
+    (const ForkAE128256Key_t *key, uint64_t sector, uint8_t *output,
+     const uint8_t *input, size_t len)
+{
+    return sector_128_process(&key->tks2, NULL, sector, output, input, len, 1);
+}
+
+int forkae_c_sector_128_384_encrypt
+    (const ForkAE128384Key_t *key, uint64_t sector, uint8_t *output,
+     const uint8_t *input, size_t len)
+{
+    return sector_128_process
+        (&key->tks2, &key->tks3, sector, output, input, len, 0);
+}
+
+int forkae_c_sector_128_384_decrypt
+    (const ForkAE128384Key_t *key, uint64_t sector, uint8_t *output,
+     const uint8_t *input, size_t len)
+{
+    return sector_128_process
+        (&key->tks2, &key->tks3, sector, output, input, len, 1);
+}
@@ -0,0 +1,77 @@
+#ifndef FORKSKINNY_C_FORKAE_SECTOR_H
+#define FORKSKINNY_C_FORKAE_SECTOR_H
+
+#include "forkae.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Length-preserving sector (page) encryption for block storage.
+ *
+ * Every 16-byte block of a sector is encrypted with its own tweak TK1: the
+ * sector number followed by the index of the block within the sector (both
+ * 64 bits, big-endian). Only the right leg of the forkcipher is computed,
+ * so this is a plain tweakable block cipher and the ciphertext has the
+ * same length as the plaintext. There is no authentication, and equal
+ * blocks at the same position of the same sector encrypt equally.
+ *
+ * All blocks of a page of up to FORKAE_SECTOR_PAGE_SIZE bytes are handed to
+ * the parallel kernel in one call; only the block index part of the tweaks
+ * changes from block to block.
+ */
+
+#define FORKAE_SECTOR_BLOCK_SIZE FORKSKINNY128_BLOCK_SIZE
+
+#define FORKAE_SECTOR_PAGE_SIZE 4096
+
+/**
+ * Encrypts a sector with Forkskinny-128-256.
+ * key:     key schedule (see forkae_c_128_256_init_key)
+ * sector:  the logical sector number
+ * output:  pointer to len bytes; will contain the ciphertext; may be equal to input
+ * input:   pointer to len bytes; the plaintext
+ * len:     length of the sector; a multiple of FORKAE_SECTOR_BLOCK_SIZE
+ * returns: 0 on success, -1 if len is not a multiple of FORKAE_SECTOR_BLOCK_SIZE
+ */
+int forkae_c_sector_128_256_encrypt(const ForkAE128256Key_t *key, uint64_t sector, uint8_t *output, const uint8_t *input, size_t len);
+
+/**
+ * Decrypts a sector with Forkskinny-128-256.
+ * key:     key schedule (see forkae_c_128_256_init_key)
+ * sector:  the logical sector number
+ * output:  pointer to len bytes; will contain the plaintext; may be equal to input
+ * input:   pointer to len bytes; the ciphertext
+ * len:     length of the sector; a multiple of FORKAE_SECTOR_BLOCK_SIZE
+ * returns: 0 on success, -1 if len is not a multiple of FORKAE_SECTOR_BLOCK_SIZE
+ */
+int forkae_c_sector_128_256_decrypt(const ForkAE128256Key_t *key, uint64_t sector, uint8_t *output, const uint8_t *input, size_t len);
+
+/**
+ * Encrypts a sector with Forkskinny-128-384.
+ * key:     key schedules (see forkae_c_128_384_init_key)
+ * sector:  the logical sector number
+ * output:  pointer to len bytes; will contain the ciphertext; may be equal to input
+ * input:   pointer to len bytes; the plaintext
+ * len:     length of the sector; a multiple of FORKAE_SECTOR_BLOCK_SIZE
+ * returns: 0 on success, -1 if len is not a multiple of FORKAE_SECTOR_BLOCK_SIZE
+ */
+int forkae_c_sector_128_384_encrypt(const ForkAE128384Key_t *key, uint64_t sector, uint8_t *output, const uint8_t *input, size_t len);
+
+/**
+ * Decrypts a sector with Forkskinny-128-384.
+ * key:     key schedules (see forkae_c_128_384_init_key)
+ * sector:  the logical sector number
+ * output:  pointer to len bytes; will contain the plaintext; may be equal to input
+ * input:   pointer to len bytes; the ciphertext
+ * len:     length of the sector; a multiple of FORKAE_SECTOR_BLOCK_SIZE
+ * returns: 0 on success, -1 if len is not a multiple of FORKAE_SECTOR_BLOCK_SIZE
+ */
+int forkae_c_sector_128_384_decrypt(const ForkAE128384Key_t *key, uint64_t sector, uint8_t *output, const uint8_t *input, size_t len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // FORKSKINNY_C_FORKAE_SECTOR_H
@@ -0,0 +1,559 @@
+/*
+ * Streaming encryption of files and pipes with PAEF-Forkskinny-128-384
+ * over io_uring.
+ *
+ *   forkae-stream.x -e|-d -k keyfile [-c shift] [-q depth] [input [output]]
+ *
+ * The key file holds FORKAE_128_384_KEY_SIZE bytes. Input and output
+ * default to stdin and stdout ("-" also selects them). Throughput is
+ * reported on stderr.
+ *
+ * Stream format: a header of STREAM_HEADER_SIZE bytes (magic "FkSt",
+ * version, chunk shift, two zero bytes, random 8-byte stream id) and then
+ * one record per chunk of 2^shift bytes: the chunk sealed with the nonce
+ * (stream id, 32-bit big-endian chunk index) and the header as associated
+ * data, i.e. the chunk padded to whole blocks and the full tag. The last
+ * chunk is always shorter than 2^shift bytes, possibly empty, and must be
+ * the last record, so a stream cut at a record boundary or extended does
+ * not verify. Its record is still full-size if the chunk is less than a
+ * block short; the decryptor then finds the end of the input right after
+ * it. As the stream id is random, a key should seal far fewer than 2^32
+ * streams.
+ *
+ * A fixed set of buffers is registered with the ring and cycled through
+ * read, encryption or decryption of all buffers read so far as one batch
+ * (forkae_c_paef_128_384_*_many), and write. Regular files are read and
+ * written at explicit offsets with all buffers in flight; pipes are read
+ * and written in order, one request at a time.
+ */
+
+#define _GNU_SOURCE
+#include "forkae-paef.h"
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#ifndef __NR_io_uring_setup
+#define __NR_io_uring_setup 425
+#endif
+#ifndef __NR_io_uring_enter
+#define __NR_io_uring_enter 426
+#endif
+#ifndef __NR_io_uring_register
+#define __NR_io_uring_register 427
+#endif
+
+#define STREAM_HEADER_SIZE 16
+#define STREAM_ID_SIZE 8
+#define STREAM_VERSION 2
+
+#define STREAM_MIN_SHIFT 10
+#define STREAM_MAX_SHIFT 24
+#define STREAM_DEFAULT_SHIFT 16
+
+/* No chunk index, e.g. while the last chunk is not known */
+#define STREAM_NO_CHUNK (~(uint64_t)0)
+
+#define STREAM_MAX_DEPTH 64
+#define STREAM_DEFAULT_DEPTH 16
+
+/* Marks the completion of a write in the user data of a request */
+#define STREAM_WRITE 0x100
+
+static const uint8_t stream_magic[4] = {'F', 'k', 'S', 't'};
+
+/* States of a buffer */
+#define SLOT_FREE       0
+#define SLOT_READING    1
+#define SLOT_READ       2
+#define SLOT_SEALED     3
+#define SLOT_WRITING    4
+
+typedef struct
+{
+    uint8_t *data;
+    size_t len;     /* bytes read, then bytes to write */
+    size_t done;    /* bytes written */
+    uint64_t index; /* chunk index */
+    int state;
+    uint8_t nonce[FORKAE_PAEF_128_384_NONCE_SIZE];
+
+} StreamSlot_t;
+
+typedef struct
+{
+    int fd;
+    int seekable;
+    uint64_t base;  /* offset of the first record */
+
+} StreamFile_t;
+
+typedef struct
+{
+    int fd;
+    unsigned *sq_tail, *sq_mask, *sq_array;
+    struct io_uring_sqe *sqes;
+    unsigned *cq_head, *cq_tail, *cq_mask;
+    struct io_uring_cqe *cqes;
+    unsigned queued;
+
+} StreamRing_t;
+
+static void stream_fail(const char *message)
+{
+    fprintf(stderr, "forkae-stream: %s\n", message);
+    exit(1);
+}
+
+static void stream_fail_errno(const char *message, int error)
+{
+    fprintf(stderr, "forkae-stream: %s: %s\n", message, strerror(error));
+    exit(1);
+}
+
+/* Maps the rings of a new io_uring instance */
+static void ring_init(StreamRing_t *ring, unsigned entries)
+{
+    struct io_uring_params params;
+    size_t sq_size, cq_size;
+    uint8_t *sq, *cq;
+    void *sqes;
+
+    memset(&params, 0, sizeof(params));
+    ring->fd = (int)syscall(__NR_io_uring_setup, entries, &params);
+    if (ring->fd < 0)
+        stream_fail_errno("io_uring_setup", errno);
+
+    sq_size = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    cq_size = params.cq_off.cqes +
+              params.cq_entries * sizeof(struct io_uring_cqe);
+    if ((params.features & IORING_FEAT_SINGLE_MMAP) && cq_size > sq_size)
+        sq_size = cq_size;
+    sq = (uint8_t *)mmap(0, sq_size, PROT_READ | PROT_WRITE,
+                         MAP_SHARED | MAP_POPULATE, ring->fd,
+                         IORING_OFF_SQ_RING);
+    if (sq == MAP_FAILED)
+        stream_fail_errno("mmap", errno);
+    if (params.features & IORING_FEAT_SINGLE_MMAP) {
+        cq = sq;
+    } else {
+        cq = (uint8_t *)mmap(0, cq_size, PROT_READ | PROT_WRITE,
+                             MAP_SHARED | MAP_POPULATE, ring->fd,
+                             IORING_OFF_CQ_RING);
+        if (cq == MAP_FAILED)
+            stream_fail_errno("mmap", errno);
+    }
+    sqes = mmap(0, params.sq_entries * sizeof(struct io_uring_sqe),
+                PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                ring->fd, IORING_OFF_SQES);
+    if (sqes == MAP_FAILED)
+        stream_fail_errno("mmap", errno);
+
+    ring->sq_tail = (unsigned *)(sq + params.sq_off.tail);
+    ring->sq_mask = (unsigned *)(sq + params.sq_off.ring_mask);
+    ring->sq_array = (unsigned *)(sq + params.sq_off.array);
+    ring->sqes = (struct io_uring_sqe *)sqes;
+    ring->cq_head = (unsigned *)(cq + params.cq_off.head);
+    ring->cq_tail = (unsigned *)(cq + params.cq_off.tail);
+    ring->cq_mask = (unsigned *)(cq + params.cq_off.ring_mask);
+    ring->cqes = (struct io_uring_cqe *)(cq + params.cq_off.cqes);
+    ring->queued = 0;
+}
+
+/* Queues a fixed-buffer read or write; the ring has room for one request
+   per buffer and direction, so it never overflows */
+static void ring_queue
+    (StreamRing_t *ring, uint8_t opcode, int fd, uint8_t *data, size_t len,
+     uint64_t offset, unsigned buffer, uint64_t user_data)
+{
+    unsigned tail = *ring->sq_tail;
+    unsigned index = tail & *ring->sq_mask;
+    struct io_uring_sqe *sqe = &ring->sqes[index];
+
+    memset(sqe, 0, sizeof(*sqe));
+    sqe->opcode = opcode;
+    sqe->fd = fd;
+    sqe->addr = (uint64_t)(uintptr_t)data;
+    sqe->len = (uint32_t)len;
+    sqe->off = offset;
+    sqe->buf_index = (uint16_t)buffer;
+    sqe->user_data = user_data;
+    ring->sq_array[index] = index;
+    __atomic_store_n(ring->sq_tail, tail + 1, __ATOMIC_RELEASE);
+    ++(ring->queued);
+}
+
+/* Submits the queued requests and waits for at least one completion */
+static void ring_enter(StreamRing_t *ring)
+{
+    long result;
+    do {
+        result = syscall(__NR_io_uring_enter, ring->fd, ring->queued, 1,
+                         IORING_ENTER_GETEVENTS, NULL, 0);
+    } while (result < 0 && errno == EINTR);
+    if (result < 0)
+        stream_fail_errno("io_uring_enter", errno);
+    ring->queued -= (unsigned)result;
+}
+
+/* Reads or writes len bytes with plain system calls, for the key and
+   the header */
+static void stream_read_all(int fd, uint8_t *data, size_t len)
+{
+    while (len > 0) {
+        ssize_t result = read(fd, data, len);
+        if (result < 0 && errno == EINTR)
+            continue;
+        if (result < 0)
+            stream_fail_errno("read", errno);
+        if (result == 0)
+            stream_fail("unexpected end of file");
+        data += result;
+        len -= (size_t)result;
+    }
+}
+
+static void stream_write_all(int fd, const uint8_t *data, size_t len)
+{
+    while (len > 0) {
+        ssize_t result = write(fd, data, len);
+        if (result < 0 && errno == EINTR)
+            continue;
+        if (result < 0)
+            stream_fail_errno("write", errno);
+        data += result;
+        len -= (size_t)result;
+    }
+}
+
+/* Regular files not opened for appending are accessed at offsets from
+   the current position */
+static void stream_file_init(StreamFile_t *file, int fd)
+{
+    struct stat st;
+    off_t position;
+    file->fd = fd;
+    file->seekable = 0;
+    file->base = 0;
+    if (fstat(fd, &st) < 0 || !S_ISREG(st.st_mode) ||
+            (fcntl(fd, F_GETFL) & O_APPEND))
+        return;
+    position = lseek(fd, 0, SEEK_CUR);
+    if (position < 0)
+        return;
+    file->seekable = 1;
+    file->base = (uint64_t)position;
+}
+
+static void stream_read
+    (StreamRing_t *ring, const StreamFile_t *in, StreamSlot_t *slot,
+     unsigned buffer, size_t record)
+{
+    ring_queue(ring, IORING_OP_READ_FIXED, in->fd, slot->data + slot->len,
+               record - slot->len,
+               in->seekable ? in->base + slot->index * record + slot->len
+                            : (uint64_t)-1,
+               buffer, buffer);
+}
+
+static void stream_write
+    (StreamRing_t *ring, const StreamFile_t *out, StreamSlot_t *slot,
+     unsigned buffer, size_t record)
+{
+    ring_queue(ring, IORING_OP_WRITE_FIXED, out->fd,
+               slot->data + slot->done, slot->len - slot->done,
+               out->seekable ? out->base + slot->index * record + slot->done
+                             : (uint64_t)-1,
+               buffer, buffer | STREAM_WRITE);
+}
+
+static void stream_usage(void)
+{
+    fprintf(stderr, "usage: forkae-stream.x -e|-d -k keyfile [-c shift] "
+                    "[-q depth] [input [output]]\n");
+    exit(2);
+}
+
+static int stream_open(const char *name, int output)
+{
+    int fd;
+    if (!name || strcmp(name, "-") == 0)
+        return output ? 1 : 0;
+    if (output)
+        fd = open(name, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    else
+        fd = open(name, O_RDONLY);
+    if (fd < 0)
+        stream_fail_errno(name, errno);
+    return fd;
+}
+
+int main(int argc, char *argv[])
+{
+    int decrypt = -1;
+    const char *key_name = 0;
+    unsigned shift = STREAM_DEFAULT_SHIFT;
+    unsigned depth = STREAM_DEFAULT_DEPTH;
+    uint8_t header[STREAM_HEADER_SIZE];
+    uint8_t k[FORKAE_128_384_KEY_SIZE];
+    ForkAE128384Key_t key;
+    StreamFile_t in, out;
+    StreamRing_t ring;
+    StreamSlot_t slots[STREAM_MAX_DEPTH];
+    ForkAEMessage_t messages[STREAM_MAX_DEPTH];
+    unsigned batch[STREAM_MAX_DEPTH];
+    struct iovec buffers[STREAM_MAX_DEPTH];
+    size_t chunk, record_in, record_out;
+    uint64_t next_chunk = 0, next_write = 0, written = 0;
+    uint64_t final = 0;
+    uint64_t last = STREAM_NO_CHUNK, records_end = 0;
+    uint64_t in_size = 0, total_in = 0, total_out = 0;
+    unsigned reads = 0, writes = 0, count, buffer;
+    struct timespec start, end;
+    double seconds;
+    uint8_t *memory;
+    int eof = 0, fd, opt;
+
+    while ((opt = getopt(argc, argv, "edk:c:q:")) != -1) {
+        switch (opt) {
+        case 'e': decrypt = 0; break;
+        case 'd': decrypt = 1; break;
+        case 'k': key_name = optarg; break;
+        case 'c': shift = (unsigned)atoi(optarg); break;
+        case 'q': depth = (unsigned)atoi(optarg); break;
+        default: stream_usage();
+        }
+    }
+    if (decrypt < 0 || !key_name || argc - optind > 2 ||
+            shift < STREAM_MIN_SHIFT || shift > STREAM_MAX_SHIFT ||
+            depth < 1 || depth > STREAM_MAX_DEPTH)
+        stream_usage();
+
+    /* Key */
+    fd = stream_open(key_name, 0);
+    stream_read_all(fd, k, sizeof(k));
+    close(fd);
+    forkae_c_128_384_init_key(&key, k);
+    memset(k, 0, sizeof(k));
+
+    in.fd = stream_open(optind < argc ? argv[optind] : 0, 0);
+    out.fd = stream_open(optind + 1 < argc ? argv[optind + 1] : 0, 1);
+
+    /* Header, written or read before the records */
+    if (!decrypt) {
+        memcpy(header, stream_magic, sizeof(stream_magic));
+        header[4] = STREAM_VERSION;
+        header[5] = (uint8_t)shift;
+        header[6] = 0;
+        header[7] = 0;
+        fd = open("/dev/urandom", O_RDONLY);
+        if (fd < 0)
+            stream_fail_errno("/dev/urandom", errno);
+        stream_read_all(fd, header + STREAM_HEADER_SIZE - STREAM_ID_SIZE,
+                        STREAM_ID_SIZE);
+        close(fd);
+        stream_write_all(out.fd, header, sizeof(header));
+    } else {
+        stream_read_all(in.fd, header, sizeof(header));
+        shift = header[5];
+        if (memcmp(header, stream_magic, sizeof(stream_magic)) != 0 ||
+                header[4] != STREAM_VERSION || header[6] || header[7] ||
+                shift < STREAM_MIN_SHIFT || shift > STREAM_MAX_SHIFT)
+            stream_fail("not a stream of this version");
+    }
+    stream_file_init(&in, in.fd);
+    stream_file_init(&out, out.fd);
+    if (in.seekable) {
+        struct stat st;
+        fstat(in.fd, &st);
+        in_size = (uint64_t)st.st_size;
+    }
+    chunk = (size_t)1 << shift;
+    record_in = decrypt ? chunk + FORKAE_PAEF_128_384_TAG_SIZE : chunk;
+    record_out = decrypt ? chunk : chunk + FORKAE_PAEF_128_384_TAG_SIZE;
+
+    /* Buffers, registered once */
+    ring_init(&ring, 2 * depth);
+    memory = (uint8_t *)mmap(0, depth * (chunk + FORKAE_PAEF_128_384_TAG_SIZE),
+                             PROT_READ | PROT_WRITE,
+                             MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (memory == MAP_FAILED)
+        stream_fail_errno("mmap", errno);
+    for (buffer = 0; buffer < depth; ++buffer) {
+        slots[buffer].data =
+            memory + buffer * (chunk + FORKAE_PAEF_128_384_TAG_SIZE);
+        slots[buffer].state = SLOT_FREE;
+        memcpy(slots[buffer].nonce,
+               header + STREAM_HEADER_SIZE - STREAM_ID_SIZE, STREAM_ID_SIZE);
+        buffers[buffer].iov_base = slots[buffer].data;
+        buffers[buffer].iov_len = chunk + FORKAE_PAEF_128_384_TAG_SIZE;
+    }
+    if (syscall(__NR_io_uring_register, ring.fd, IORING_REGISTER_BUFFERS,
+                buffers, depth) < 0)
+        stream_fail_errno("io_uring_register", errno);
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (;;) {
+        unsigned head, tail;
+        int progress;
+
+        /* Reads into the free buffers */
+        for (buffer = 0; buffer < depth && !eof; ++buffer) {
+            StreamSlot_t *slot = &slots[buffer];
+            if (slot->state != SLOT_FREE)
+                continue;
+            if (!in.seekable && reads > 0)
+                break;
+            if (in.seekable && in.base + next_chunk * record_in > in_size)
+                break;
+            if (next_chunk > 0xFFFFFFFFU)
+                stream_fail("stream too long");
+            slot->index = next_chunk++;
+            slot->len = 0;
+            slot->state = SLOT_READING;
+            stream_read(&ring, &in, slot, buffer, record_in);
+            ++reads;
+        }
+
+        /* All buffers read so far as one batch */
+        for (buffer = 0, count = 0; buffer < depth; ++buffer) {
+            StreamSlot_t *slot = &slots[buffer];
+            uint8_t *index = slot->nonce + STREAM_ID_SIZE;
+            if (slot->state != SLOT_READ)
+                continue;
+            if (decrypt && slot->len == 0) {
+                /* The end of the input, right after a full-size record */
+                slot->done = 0;
+                slot->state = SLOT_SEALED;
+                continue;
+            }
+            index[0] = (uint8_t)(slot->index >> 24);
+            index[1] = (uint8_t)(slot->index >> 16);
+            index[2] = (uint8_t)(slot->index >> 8);
+            index[3] = (uint8_t)slot->index;
+            messages[count].nonce = slot->nonce;
+            messages[count].ad = header;
+            messages[count].adlen = sizeof(header);
+            messages[count].input = slot->data;
+            messages[count].inlen = slot->len;
+            messages[count].output = slot->data;
+            batch[count++] = buffer;
+        }
+        if (decrypt)
+            forkae_c_paef_128_384_decrypt_many(&key, messages, count);
+        else
+            forkae_c_paef_128_384_encrypt_many(&key, messages, count);
+        while (count > 0) {
+            StreamSlot_t *slot = &slots[batch[--count]];
+            if (messages[count].result != 0) {
+                fprintf(stderr, "forkae-stream: chunk %lu: "
+                        "authentication failed\n", (unsigned long)slot->index);
+                return 1;
+            }
+            if (decrypt) {
+                /* The first short chunk must be the last record */
+                if (messages[count].outlen < chunk && slot->index < last)
+                    last = slot->index;
+                if (slot->index >= records_end)
+                    records_end = slot->index + 1;
+            }
+            slot->len = messages[count].outlen;
+            slot->done = 0;
+            slot->state = SLOT_SEALED;
+        }
+
+        /* Writes, in order for pipes */
+        do {
+            progress = 0;
+            for (buffer = 0; buffer < depth; ++buffer) {
+                StreamSlot_t *slot = &slots[buffer];
+                if (slot->state != SLOT_SEALED)
+                    continue;
+                if (!out.seekable &&
+                        (writes > 0 || slot->index != next_write))
+                    continue;
+                if (slot->len == 0) {
+                    /* Empty last chunk, or end of the input, when
+                       decrypting */
+                    slot->state = SLOT_FREE;
+                    ++next_write;
+                    ++written;
+                    progress = 1;
+                    continue;
+                }
+                slot->state = SLOT_WRITING;
+                stream_write(&ring, &out, slot, buffer, record_out);
+                ++writes;
+            }
+        } while (progress);
+
+        if (eof && reads == 0 && written == final + 1)
+            break;
+        if (reads == 0 && writes == 0)
+            stream_fail("truncated input");
+        ring_enter(&ring);
+
+        /* Completions */
+        head = *ring.cq_head;
+        tail = __atomic_load_n(ring.cq_tail, __ATOMIC_ACQUIRE);
+        for (; head != tail; ++head) {
+            struct io_uring_cqe *cqe = &ring.cqes[head & *ring.cq_mask];
+            StreamSlot_t *slot;
+            buffer = (unsigned)(cqe->user_data & (STREAM_WRITE - 1));
+            slot = &slots[buffer];
+            if (cqe->res < 0) {
+                stream_fail_errno((cqe->user_data & STREAM_WRITE)
+                                    ? "write" : "read", -cqe->res);
+            }
+            if (cqe->user_data & STREAM_WRITE) {
+                slot->done += (size_t)cqe->res;
+                if (slot->done < slot->len) {
+                    stream_write(&ring, &out, slot, buffer, record_out);
+                    continue;
+                }
+                total_out += slot->len;
+                slot->state = SLOT_FREE;
+                --writes;
+                ++next_write;
+                ++written;
+            } else {
+                slot->len += (size_t)cqe->res;
+                if (cqe->res > 0 && slot->len < record_in) {
+                    stream_read(&ring, &in, slot, buffer, record_in);
+                    continue;
+                }
+                total_in += slot->len;
+                slot->state = SLOT_READ;
+                --reads;
+                if (slot->len < record_in) {
+                    /* The last chunk is the first short one */
+                    final = slot->index;
+                    eof = 1;
+                }
+            }
+        }
+        __atomic_store_n(ring.cq_head, head, __ATOMIC_RELEASE);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    if (decrypt && last == STREAM_NO_CHUNK)
+        stream_fail("truncated input");
+    if (decrypt && last + 1 != records_end)
+        stream_fail("records after the last chunk");
+
+    seconds = (double)(end.tv_sec - start.tv_sec) +
+              (double)(end.tv_nsec - start.tv_nsec) / 1e9;
+    fprintf(stderr, "forkae-stream: %s %llu bytes to %llu bytes "
+            "in %.3f s, %.1f MiB/s\n", decrypt ? "decrypted" : "encrypted",
+            (unsigned long long)total_in, (unsigned long long)total_out,
+            seconds, seconds > 0 ? (double)total_in / seconds / 1048576 : 0);
+    return 0;
+}
@@ -0,0 +1,18 @@
+#include "forkae.h"
+
+void forkae_c_128_256_init_key(ForkAE128256Key_t *key, const uint8_t *k)
+{
+    forkskinny_c_128_256_init_tk2(&key->tks2, k, FORKSKINNY128_MAX_ROUNDS);
+}
+
+void forkae_c_128_384_init_key(ForkAE128384Key_t *key, const uint8_t *k)
+{
+    forkskinny_c_128_384_init_tk2(&key->tks2, k, FORKSKINNY128_MAX_ROUNDS);
+    forkskinny_c_128_384_init_tk3
+        (&key->tks3, k + FORKSKINNY128_BLOCK_SIZE, FORKSKINNY128_MAX_ROUNDS);
+}
+
+void forkae_c_64_192_init_key(ForkAE64192Key_t *key, const uint8_t *k)
+{
+    forkskinny_c_64_192_init_tk2_tk3(&key->tks23, k, FORKSKINNY64_MAX_ROUNDS);
+}
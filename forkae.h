@@ -0,0 +1,139 @@
+#ifndef FORKSKINNY_C_FORKAE_H
+#define FORKSKINNY_C_FORKAE_H
+
+#include "forkskinny128-cipher.h"
+#include "forkskinny64-cipher.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/uio.h>
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Common definitions for the ForkAE modes built on top of the forkciphers.
+ *
+ * All modes use TK1 as the tweak (nonce, flags and block counter) and the
+ * remaining tweakey material as the key. The key schedules therefore only
+ * need to be computed once per key; see forkae_c_*_init_key.
+ */
+
+#define FORKAE_128_256_KEY_SIZE FORKSKINNY128_BLOCK_SIZE
+
+#define FORKAE_128_384_KEY_SIZE (2*FORKSKINNY128_BLOCK_SIZE)
+
+#define FORKAE_64_192_KEY_SIZE (2*FORKSKINNY64_BLOCK_SIZE)
+
+/**
+ * Key for the ForkAE modes on Forkskinny-128-256 (TK2)
+ */
+typedef struct
+{
+    /** Key schedule for TK2 */
+    ForkSkinny128Key_t tks2;
+
+} ForkAE128256Key_t;
+
+/**
+ * Key for the ForkAE modes on Forkskinny-128-384 (TK2 and TK3)
+ */
+typedef struct
+{
+    /** Key schedule for TK2 */
+    ForkSkinny128Key_t tks2;
+
+    /** Key schedule for TK3 */
+    ForkSkinny128Key_t tks3;
+
+} ForkAE128384Key_t;
+
+/**
+ * Key for the ForkAE modes on Forkskinny-64-192 (TK2 and TK3)
+ */
+typedef struct
+{
+    /** Key schedule for TK2 and TK3 */
+    ForkSkinny64Key_t tks23;
+
+} ForkAE64192Key_t;
+
+/**
+ * One message of a batch of independent messages (see the *_many functions)
+ */
+typedef struct
+{
+    /** Nonce of the message */
+    const uint8_t *nonce;
+
+    /** Associated data and its length */
+    const uint8_t *ad;
+    size_t adlen;
+
+    /** Message when encrypting, ciphertext and tag when decrypting */
+    const uint8_t *input;
+    size_t inlen;
+
+    /** Ciphertext and tag when encrypting, message when decrypting;
+        may be equal to input */
+    uint8_t *output;
+
+    /** Will contain the length of the output */
+    size_t outlen;
+
+    /** Will contain 0 on success or -1 on failure */
+    int result;
+
+} ForkAEMessage_t;
+
+/**
+ * One buffer of a scatter/gather list (see the *_iov functions). This is
+ * struct iovec where the platform has it, so existing I/O vectors can be
+ * passed as they are.
+ */
+#if defined(__unix__) || defined(__APPLE__)
+typedef struct iovec ForkAEIOVec_t;
+#else
+typedef struct
+{
+    /** Start of the buffer */
+    void *iov_base;
+
+    /** Length of the buffer */
+    size_t iov_len;
+
+} ForkAEIOVec_t;
+#endif
+
+/**
+ * Thread pool for the bulk functions of the modes (see forkae-pool.h)
+ */
+typedef struct ForkAEPool_s ForkAEPool_t;
+
+/**
+ * Pre-computes the key schedule for the ForkAE modes on Forkskinny-128-256
+ * key:  the key to initialize
+ * k:    pointer to key bytes; reads FORKAE_128_256_KEY_SIZE bytes (TK2)
+ */
+void forkae_c_128_256_init_key(ForkAE128256Key_t *key, const uint8_t *k);
+
+/**
+ * Pre-computes the key schedules for the ForkAE modes on Forkskinny-128-384
+ * key:  the key to initialize
+ * k:    pointer to key bytes; reads FORKAE_128_384_KEY_SIZE bytes (TK2 followed by TK3)
+ */
+void forkae_c_128_384_init_key(ForkAE128384Key_t *key, const uint8_t *k);
+
+/**
+ * Pre-computes the key schedule for the ForkAE modes on Forkskinny-64-192
+ * key:  the key to initialize
+ * k:    pointer to key bytes; reads FORKAE_64_192_KEY_SIZE bytes (TK2 followed by TK3)
+ */
+void forkae_c_64_192_init_key(ForkAE64192Key_t *key, const uint8_t *k);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // FORKSKINNY_C_FORKAE_H
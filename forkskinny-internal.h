@@ -23,6 +23,7 @@
 #ifndef FORKSKINNY_C_FORKSKINNY_INTERNAL_H
 #define FORKSKINNY_C_FORKSKINNY_INTERNAL_H
 
+#include "forkskinny-stats.h"
 #include <stdint.h>
 #include <string.h>
 
@@ -194,6 +195,24 @@ STATIC_INLINE void skinny64_xor
      (((uint8_t *)(ptr))[(offset) + 7] = (uint8_t)((value) >> 56)))
 
 
+/* Operation counters (see forkskinny-stats.h); unless the library is
+   built with FORKSKINNY_STATS defined to 1, they compile to nothing */
+#ifndef FORKSKINNY_STATS
+#define FORKSKINNY_STATS 0
+#endif
+#if FORKSKINNY_STATS
+void forkskinny_stats_batch(unsigned variant, unsigned direction, unsigned kernel, int left, int right, size_t count, unsigned lanes);
+void forkskinny_stats_init(unsigned variant, unsigned tk);
+#define FORKSKINNY_STATS_BATCH(variant, direction, kernel, left, right, count, lanes) \
+    forkskinny_stats_batch((variant), (direction), (kernel), (left) != 0, \
+                           (right) != 0, (count), (lanes))
+#define FORKSKINNY_STATS_INIT(variant, tk) forkskinny_stats_init((variant), (tk))
+#else
+#define FORKSKINNY_STATS_BATCH(variant, direction, kernel, left, right, count, lanes) \
+    do { } while (0)
+#define FORKSKINNY_STATS_INIT(variant, tk) do { } while (0)
+#endif
+
 static uint8_t const RC[87] = {
     0x01, 0x03, 0x07, 0x0f, 0x1f, 0x3f, 0x7e, 0x7d,
     0x7b, 0x77, 0x6f, 0x5f, 0x3e, 0x7c, 0x79, 0x73,
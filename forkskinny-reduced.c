@@ -0,0 +1,363 @@
+#include "forkskinny-reduced.h"
+#include "forkae-internal.h"
+
+/* Pairs per kernel call */
+#define REDUCED_BATCH 64
+
+typedef struct ReducedRun_s ReducedRun_t;
+
+struct ReducedRun_s
+{
+    const ForkSkinnyDifferential_t *experiment;
+    const ForkSkinnyBoomerang_t *boomerang;
+    unsigned before;
+    unsigned after;
+    const void *ks2;
+    const void *ks3;
+    size_t block;
+    void (*kernel)
+        (const ReducedRun_t *run, int decrypt, const uint8_t *tk1,
+         uint8_t *left, uint8_t *right, const uint8_t *input, size_t count);
+    uint64_t pairs;
+    uint64_t right_pairs;
+};
+
+/* Word index of the splitmix64 generator */
+STATIC_INLINE uint64_t reduced_random_word(uint64_t seed, uint64_t index)
+{
+    uint64_t z = seed + (index + 1) * 0x9E3779B97F4A7C15ULL;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+void forkskinny_c_reduced_random(uint8_t *output, size_t len, uint64_t seed, uint64_t index)
+{
+    while (len > 0) {
+        uint64_t word = reduced_random_word(seed, index++);
+        size_t size = len < 8 ? len : 8;
+        size_t posn;
+        for (posn = 0; posn < size; ++posn)
+            output[posn] = (uint8_t)(word >> (8 * posn));
+        output += size;
+        len -= size;
+    }
+}
+
+/* Runs the pairs of one unit; the two blocks of every pair are processed
+   with one kernel call, the second ones after the first ones */
+static void reduced_unit(void *ctx, size_t unit, uint8_t *scratch)
+{
+    ReducedRun_t *run = (ReducedRun_t *)ctx;
+    const ForkSkinnyDifferential_t *experiment = run->experiment;
+    size_t block = run->block;
+    uint64_t words = block / 8 * (experiment->tk1 ? 1 : 2);
+    uint8_t input[2 * REDUCED_BATCH * FORKSKINNY128_BLOCK_SIZE];
+    uint8_t tk1[2 * REDUCED_BATCH * FORKSKINNY128_BLOCK_SIZE];
+    uint8_t left[2 * REDUCED_BATCH * FORKSKINNY128_BLOCK_SIZE];
+    uint8_t right[2 * REDUCED_BATCH * FORKSKINNY128_BLOCK_SIZE];
+    uint64_t start = (uint64_t)unit * FORKSKINNY_REDUCED_UNIT;
+    uint64_t end = start + FORKSKINNY_REDUCED_UNIT;
+    uint64_t count = 0, sum;
+    size_t size, index, half;
+
+    if (end > run->pairs)
+        end = run->pairs;
+    for (; start < end; start += size) {
+        size = end - start < REDUCED_BATCH ? (size_t)(end - start)
+                                           : REDUCED_BATCH;
+        half = size * block;
+
+        /* Random inputs (and TK1) of the pairs */
+        for (index = 0; index < size; ++index) {
+            uint64_t pair = experiment->first + start + index;
+            uint8_t *in = input + index * block;
+            uint8_t *tk = tk1 + index * block;
+            forkskinny_c_reduced_random
+                (in, block, experiment->seed, pair * words);
+            if (experiment->tk1) {
+                memcpy(tk, experiment->tk1, block);
+            } else {
+                forkskinny_c_reduced_random
+                    (tk, block, experiment->seed, pair * words + block / 8);
+            }
+            forkae_xor(in + half, in, experiment->input_difference, block);
+            if (experiment->tk1_difference)
+                forkae_xor(tk + half, tk, experiment->tk1_difference, block);
+            else
+                memcpy(tk + half, tk, block);
+        }
+
+        run->kernel
+            (run, experiment->decrypt, tk1,
+             experiment->left_difference ? left : 0,
+             experiment->right_difference ? right : 0, input, 2 * size);
+
+        /* Count the right pairs */
+        for (index = 0; index < size; ++index) {
+            uint8_t diff = 0;
+            if (experiment->left_difference) {
+                forkae_xor(left + index * block, left + index * block,
+                           left + half + index * block, block);
+                diff |= forkae_compare(left + index * block,
+                                       experiment->left_difference, block);
+            }
+            if (experiment->right_difference) {
+                forkae_xor(right + index * block, right + index * block,
+                           right + half + index * block, block);
+                diff |= forkae_compare(right + index * block,
+                                       experiment->right_difference, block);
+            }
+            count += (diff == 0);
+        }
+    }
+    memcpy(&sum, scratch, sizeof(sum));
+    sum += count;
+    memcpy(scratch, &sum, sizeof(sum));
+}
+
+/* Runs the quartets of one unit: the first pairs of all quartets go
+   through one kernel call, and the second pairs come back through
+   another one in the other direction */
+static void reduced_boomerang_unit(void *ctx, size_t unit, uint8_t *scratch)
+{
+    ReducedRun_t *run = (ReducedRun_t *)ctx;
+    const ForkSkinnyBoomerang_t *experiment = run->boomerang;
+    size_t block = run->block;
+    uint64_t words = block / 8 * (experiment->tk1 ? 1 : 2);
+    uint8_t input[2 * REDUCED_BATCH * FORKSKINNY128_BLOCK_SIZE];
+    uint8_t tk1[2 * REDUCED_BATCH * FORKSKINNY128_BLOCK_SIZE];
+    uint8_t output[2 * REDUCED_BATCH * FORKSKINNY128_BLOCK_SIZE];
+    uint64_t start = (uint64_t)unit * FORKSKINNY_REDUCED_UNIT;
+    uint64_t end = start + FORKSKINNY_REDUCED_UNIT;
+    uint64_t count = 0, sum;
+    size_t size, index, half;
+
+    if (end > run->pairs)
+        end = run->pairs;
+    for (; start < end; start += size) {
+        size = end - start < REDUCED_BATCH ? (size_t)(end - start)
+                                           : REDUCED_BATCH;
+        half = size * block;
+
+        /* Random inputs (and TK1) of the first pairs */
+        for (index = 0; index < size; ++index) {
+            uint64_t quartet = experiment->first + start + index;
+            uint8_t *in = input + index * block;
+            uint8_t *tk = tk1 + index * block;
+            forkskinny_c_reduced_random
+                (in, block, experiment->seed, quartet * words);
+            if (experiment->tk1) {
+                memcpy(tk, experiment->tk1, block);
+            } else {
+                forkskinny_c_reduced_random
+                    (tk, block, experiment->seed, quartet * words + block / 8);
+            }
+            forkae_xor(in + half, in, experiment->input_difference, block);
+            if (experiment->tk1_difference)
+                forkae_xor(tk + half, tk, experiment->tk1_difference, block);
+            else
+                memcpy(tk + half, tk, block);
+        }
+
+        run->kernel
+            (run, experiment->decrypt, tk1, 0, output, input, 2 * size);
+
+        /* The second pairs: every output (and TK1) moved by the output
+           difference, then run back to the inputs */
+        for (index = 0; index < 2 * size; ++index) {
+            forkae_xor(output + index * block, output + index * block,
+                       experiment->output_difference, block);
+            if (experiment->tk1_output_difference) {
+                forkae_xor(tk1 + index * block, tk1 + index * block,
+                           experiment->tk1_output_difference, block);
+            }
+        }
+
+        run->kernel
+            (run, !experiment->decrypt, tk1, 0, input, output, 2 * size);
+
+        /* Count the quartets whose second pair has the input difference */
+        for (index = 0; index < size; ++index) {
+            forkae_xor(input + index * block, input + index * block,
+                       input + half + index * block, block);
+            count += (forkae_compare(input + index * block,
+                                     experiment->input_difference,
+                                     block) == 0);
+        }
+    }
+    memcpy(&sum, scratch, sizeof(sum));
+    sum += count;
+    memcpy(scratch, &sum, sizeof(sum));
+}
+
+static void reduced_combine(void *ctx, const uint8_t *scratch)
+{
+    uint64_t count;
+    memcpy(&count, scratch, sizeof(count));
+    ((ReducedRun_t *)ctx)->right_pairs += count;
+}
+
+/* Runs the units of pairs (or quartets) of an experiment on the pool */
+static int reduced_run
+    (ForkAEPool_t *pool, ReducedRun_t *run, unsigned max_rounds,
+     void (*unit)(void *ctx, size_t index, uint8_t *scratch),
+     uint64_t pairs, uint64_t *right_pairs)
+{
+    if (run->before > max_rounds ||
+            run->after > (max_rounds - run->before) / 2)
+        return -1;
+    run->pairs = pairs;
+    run->right_pairs = 0;
+    forkae_pool_run
+        (pool, (size_t)(pairs / FORKSKINNY_REDUCED_UNIT +
+                        (pairs % FORKSKINNY_REDUCED_UNIT != 0)),
+         unit, reduced_combine, run);
+    *right_pairs = run->right_pairs;
+    return 0;
+}
+
+static int reduced_differential
+    (ForkAEPool_t *pool, ReducedRun_t *run, unsigned max_rounds,
+     const ForkSkinnyDifferential_t *experiment, uint64_t pairs,
+     uint64_t *right_pairs)
+{
+    if (!experiment->left_difference && !experiment->right_difference)
+        return -1;
+    run->experiment = experiment;
+    run->boomerang = 0;
+    run->before = experiment->before;
+    run->after = experiment->after;
+    return reduced_run
+        (pool, run, max_rounds, reduced_unit, pairs, right_pairs);
+}
+
+static int reduced_boomerang
+    (ForkAEPool_t *pool, ReducedRun_t *run, unsigned max_rounds,
+     const ForkSkinnyBoomerang_t *experiment, uint64_t quartets,
+     uint64_t *right_quartets)
+{
+    run->experiment = 0;
+    run->boomerang = experiment;
+    run->before = experiment->before;
+    run->after = experiment->after;
+    return reduced_run
+        (pool, run, max_rounds, reduced_boomerang_unit, quartets,
+         right_quartets);
+}
+
+static void reduced_64_192
+    (const ReducedRun_t *run, int decrypt, const uint8_t *tk1,
+     uint8_t *left, uint8_t *right, const uint8_t *input, size_t count)
+{
+    if (decrypt) {
+        forkskinny_c_64_192_decrypt_reduced
+            (tk1, (const ForkSkinny64Key_t *)run->ks2, run->before,
+             run->after, left, right, input, count);
+    } else {
+        forkskinny_c_64_192_encrypt_reduced
+            (tk1, (const ForkSkinny64Key_t *)run->ks2, run->before,
+             run->after, left, right, input, count);
+    }
+}
+
+static void reduced_128_256
+    (const ReducedRun_t *run, int decrypt, const uint8_t *tk1,
+     uint8_t *left, uint8_t *right, const uint8_t *input, size_t count)
+{
+    if (decrypt) {
+        forkskinny_c_128_256_decrypt_reduced
+            (tk1, (const ForkSkinny128Key_t *)run->ks2, run->before,
+             run->after, left, right, input, count);
+    } else {
+        forkskinny_c_128_256_encrypt_reduced
+            (tk1, (const ForkSkinny128Key_t *)run->ks2, run->before,
+             run->after, left, right, input, count);
+    }
+}
+
+static void reduced_128_384
+    (const ReducedRun_t *run, int decrypt, const uint8_t *tk1,
+     uint8_t *left, uint8_t *right, const uint8_t *input, size_t count)
+{
+    if (decrypt) {
+        forkskinny_c_128_384_decrypt_reduced
+            (tk1, (const ForkSkinny128Key_t *)run->ks2,
+             (const ForkSkinny128Key_t *)run->ks3, run->before,
+             run->after, left, right, input, count);
+    } else {
+        forkskinny_c_128_384_encrypt_reduced
+            (tk1, (const ForkSkinny128Key_t *)run->ks2,
+             (const ForkSkinny128Key_t *)run->ks3, run->before,
+             run->after, left, right, input, count);
+    }
+}
+
+int forkskinny_c_64_192_differential(ForkAEPool_t *pool, const ForkSkinny64Key_t *tks2, const ForkSkinnyDifferential_t *experiment, uint64_t pairs, uint64_t *right_pairs)
+{
+    ReducedRun_t run;
+    run.ks2 = tks2;
+    run.ks3 = 0;
+    run.block = FORKSKINNY64_BLOCK_SIZE;
+    run.kernel = reduced_64_192;
+    return reduced_differential
+        (pool, &run, FORKSKINNY64_MAX_ROUNDS, experiment, pairs, right_pairs);
+}
+
+int forkskinny_c_128_256_differential(ForkAEPool_t *pool, const ForkSkinny128Key_t *ks2, const ForkSkinnyDifferential_t *experiment, uint64_t pairs, uint64_t *right_pairs)
+{
+    ReducedRun_t run;
+    run.ks2 = ks2;
+    run.ks3 = 0;
+    run.block = FORKSKINNY128_BLOCK_SIZE;
+    run.kernel = reduced_128_256;
+    return reduced_differential
+        (pool, &run, FORKSKINNY128_MAX_ROUNDS, experiment, pairs, right_pairs);
+}
+
+int forkskinny_c_128_384_differential(ForkAEPool_t *pool, const ForkSkinny128Key_t *ks2, const ForkSkinny128Key_t *ks3, const ForkSkinnyDifferential_t *experiment, uint64_t pairs, uint64_t *right_pairs)
+{
+    ReducedRun_t run;
+    run.ks2 = ks2;
+    run.ks3 = ks3;
+    run.block = FORKSKINNY128_BLOCK_SIZE;
+    run.kernel = reduced_128_384;
+    return reduced_differential
+        (pool, &run, FORKSKINNY128_MAX_ROUNDS, experiment, pairs, right_pairs);
+}
+
+int forkskinny_c_64_192_boomerang(ForkAEPool_t *pool, const ForkSkinny64Key_t *tks2, const ForkSkinnyBoomerang_t *experiment, uint64_t quartets, uint64_t *right_quartets)
+{
+    ReducedRun_t run;
+    run.ks2 = tks2;
+    run.ks3 = 0;
+    run.block = FORKSKINNY64_BLOCK_SIZE;
+    run.kernel = reduced_64_192;
+    return reduced_boomerang
+        (pool, &run, FORKSKINNY64_MAX_ROUNDS, experiment, quartets,
+         right_quartets);
+}
+
+int forkskinny_c_128_256_boomerang(ForkAEPool_t *pool, const ForkSkinny128Key_t *ks2, const ForkSkinnyBoomerang_t *experiment, uint64_t quartets, uint64_t *right_quartets)
+{
+    ReducedRun_t run;
+    run.ks2 = ks2;
+    run.ks3 = 0;
+    run.block = FORKSKINNY128_BLOCK_SIZE;
+    run.kernel = reduced_128_256;
+    return reduced_boomerang
+        (pool, &run, FORKSKINNY128_MAX_ROUNDS, experiment, quartets,
+         right_quartets);
+}
+
+int forkskinny_c_128_384_boomerang(ForkAEPool_t *pool, const ForkSkinny128Key_t *ks2, const ForkSkinny128Key_t *ks3, const ForkSkinnyBoomerang_t *experiment, uint64_t quartets, uint64_t *right_quartets)
+{
+    ReducedRun_t run;
+    run.ks2 = ks2;
+    run.ks3 = ks3;
+    run.block = FORKSKINNY128_BLOCK_SIZE;
+    run.kernel = reduced_128_384;
+    return reduced_boomerang
+        (pool, &run, FORKSKINNY128_MAX_ROUNDS, experiment, quartets,
+         right_quartets);
+}
@@ -0,0 +1,192 @@
+#ifndef FORKSKINNY_C_FORKSKINNY_REDUCED_H
+#define FORKSKINNY_C_FORKSKINNY_REDUCED_H
+
+#include "forkskinny64-parallel.h"
+#include "forkskinny128-parallel.h"
+#include "forkae.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Batch experiments on reduced-round Forkskinny, for cryptanalysis.
+ *
+ * The experiments run the *_reduced kernels of forkskinny64-parallel.h and
+ * forkskinny128-parallel.h on large numbers of random inputs, generated in
+ * small batches right before each kernel call, so no input is ever stored.
+ * Every TK1 is per block (per SIMD lane), either fixed or random.
+ *
+ * The random inputs come from a counter-based generator (splitmix64 of the
+ * seed and the word index), so the inputs of a pair depend only on the seed
+ * and the index of the pair: an experiment gives the same result with any
+ * number of threads, and can be split into ranges of pairs over machines.
+ * This generator is fast but not cryptographic.
+ *
+ * With a thread pool (see forkae-pool.h), the pairs are spread over its
+ * threads in units of FORKSKINNY_REDUCED_UNIT pairs (or quartets).
+ */
+
+/** Pairs of a unit of work */
+#define FORKSKINNY_REDUCED_UNIT 4096
+
+/**
+ * A differential experiment: the number of random pairs of inputs with a
+ * given difference (and TK1 difference) whose outputs have the expected
+ * differences.
+ */
+typedef struct
+{
+    /** Rounds before the forking point and of each leg */
+    unsigned before;
+    unsigned after;
+
+    /** If non-zero, the pairs are inputs of the inverse direction (from the
+        right leg), and the outputs are the left leg and the input */
+    int decrypt;
+
+    /** TK1 of all pairs, or NULL for a random TK1 for each pair */
+    const uint8_t *tk1;
+
+    /** Difference of the inputs of a pair */
+    const uint8_t *input_difference;
+
+    /** Difference of TK1 within a pair, or NULL for none */
+    const uint8_t *tk1_difference;
+
+    /** Expected difference of the left outputs, or NULL to not compute the
+        left leg */
+    const uint8_t *left_difference;
+
+    /** Expected difference of the right outputs (the inputs when
+        decrypting), or NULL to not compute them */
+    const uint8_t *right_difference;
+
+    /** Seed of the random inputs */
+    uint64_t seed;
+
+    /** Index of the first pair; the pairs of an experiment can be split
+        into ranges with the same seed */
+    uint64_t first;
+
+} ForkSkinnyDifferential_t;
+
+/**
+ * A boomerang experiment on the right leg, which is the path from the
+ * input through before + after rounds to the right output (C0). A random
+ * pair with the input difference is run through, both outputs are moved
+ * by the output difference, and the new pair is run back; the experiment
+ * counts the quartets whose new pair has the input difference again.
+ * With TK1 differences, the four blocks of a quartet have TK1, TK1 ^ a,
+ * TK1 ^ b and TK1 ^ a ^ b, for a related-tweakey boomerang.
+ */
+typedef struct
+{
+    /** Rounds before the forking point and of each leg; only the right
+        leg is computed, but the rounds are those of the full kernel */
+    unsigned before;
+    unsigned after;
+
+    /** If non-zero, the quartets start from the right leg: the first pair
+        is decrypted and the second one encrypted */
+    int decrypt;
+
+    /** TK1 of the first block of all quartets, or NULL for a random TK1 for
+        each quartet */
+    const uint8_t *tk1;
+
+    /** Difference of the inputs of each pair (of the right outputs when
+        decrypting) */
+    const uint8_t *input_difference;
+
+    /** Difference of TK1 within each pair, or NULL for none */
+    const uint8_t *tk1_difference;
+
+    /** Difference between the outputs of the first pair and the inputs of
+        the second pair, on the other side of the cipher */
+    const uint8_t *output_difference;
+
+    /** Difference of TK1 between the two pairs, or NULL for none */
+    const uint8_t *tk1_output_difference;
+
+    /** Seed of the random inputs */
+    uint64_t seed;
+
+    /** Index of the first quartet; the quartets of an experiment can be
+        split into ranges with the same seed */
+    uint64_t first;
+
+} ForkSkinnyBoomerang_t;
+
+/**
+ * Generates bytes of the random stream of the experiments.
+ * output:  pointer to len bytes; will contain the bytes of the stream from 8*index
+ * len:     number of bytes
+ * seed:    seed of the stream
+ * index:   index of the first 64-bit word
+ */
+void forkskinny_c_reduced_random(uint8_t *output, size_t len, uint64_t seed, uint64_t index);
+
+/**
+ * Runs a differential experiment on Forkskinny-64-192. Blocks and
+ * differences are FORKSKINNY64_BLOCK_SIZE bytes.
+ * pool:        thread pool, or NULL to run on the calling thread
+ * tks2:        key schedule for TK2 and TK3, covering before + 2*after rounds
+ * experiment:  the experiment
+ * pairs:       the number of pairs
+ * right_pairs: will contain the number of pairs with the expected output differences
+ * returns:     0 on success, -1 if the round numbers are out of range or no output is checked
+ */
+int forkskinny_c_64_192_differential(ForkAEPool_t *pool, const ForkSkinny64Key_t *tks2, const ForkSkinnyDifferential_t *experiment, uint64_t pairs, uint64_t *right_pairs);
+
+/**
+ * Runs a differential experiment on Forkskinny-128-256. Blocks and
+ * differences are FORKSKINNY128_BLOCK_SIZE bytes.
+ * ks2:         key schedule for TK2, covering before + 2*after rounds
+ * Other parameters and return value as for forkskinny_c_64_192_differential.
+ */
+int forkskinny_c_128_256_differential(ForkAEPool_t *pool, const ForkSkinny128Key_t *ks2, const ForkSkinnyDifferential_t *experiment, uint64_t pairs, uint64_t *right_pairs);
+
+/**
+ * Runs a differential experiment on Forkskinny-128-384. Blocks and
+ * differences are FORKSKINNY128_BLOCK_SIZE bytes.
+ * ks2:         key schedule for TK2, covering before + 2*after rounds
+ * ks3:         key schedule for TK3, covering before + 2*after rounds
+ * Other parameters and return value as for forkskinny_c_64_192_differential.
+ */
+int forkskinny_c_128_384_differential(ForkAEPool_t *pool, const ForkSkinny128Key_t *ks2, const ForkSkinny128Key_t *ks3, const ForkSkinnyDifferential_t *experiment, uint64_t pairs, uint64_t *right_pairs);
+
+/**
+ * Runs a boomerang experiment on Forkskinny-64-192. Blocks and
+ * differences are FORKSKINNY64_BLOCK_SIZE bytes.
+ * pool:           thread pool, or NULL to run on the calling thread
+ * tks2:           key schedule for TK2 and TK3, covering before + 2*after rounds
+ * experiment:     the experiment
+ * quartets:       the number of quartets
+ * right_quartets: will contain the number of quartets whose second pair has the input difference
+ * returns:        0 on success, -1 if the round numbers are out of range
+ */
+int forkskinny_c_64_192_boomerang(ForkAEPool_t *pool, const ForkSkinny64Key_t *tks2, const ForkSkinnyBoomerang_t *experiment, uint64_t quartets, uint64_t *right_quartets);
+
+/**
+ * Runs a boomerang experiment on Forkskinny-128-256. Blocks and
+ * differences are FORKSKINNY128_BLOCK_SIZE bytes.
+ * ks2:            key schedule for TK2, covering before + 2*after rounds
+ * Other parameters and return value as for forkskinny_c_64_192_boomerang.
+ */
+int forkskinny_c_128_256_boomerang(ForkAEPool_t *pool, const ForkSkinny128Key_t *ks2, const ForkSkinnyBoomerang_t *experiment, uint64_t quartets, uint64_t *right_quartets);
+
+/**
+ * Runs a boomerang experiment on Forkskinny-128-384. Blocks and
+ * differences are FORKSKINNY128_BLOCK_SIZE bytes.
+ * ks2:            key schedule for TK2, covering before + 2*after rounds
+ * ks3:            key schedule for TK3, covering before + 2*after rounds
+ * Other parameters and return value as for forkskinny_c_64_192_boomerang.
+ */
+int forkskinny_c_128_384_boomerang(ForkAEPool_t *pool, const ForkSkinny128Key_t *ks2, const ForkSkinny128Key_t *ks3, const ForkSkinnyBoomerang_t *experiment, uint64_t quartets, uint64_t *right_quartets);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // FORKSKINNY_C_FORKSKINNY_REDUCED_H
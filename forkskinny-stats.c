@@ -0,0 +1,196 @@
+#include "forkskinny-stats.h"
+#include "forkskinny-internal.h"
+
+int forkskinny_c_stats_enabled(void)
+{
+    return FORKSKINNY_STATS;
+}
+
+#if FORKSKINNY_STATS
+
+#include <pthread.h>
+#include <stdlib.h>
+
+#define STATS_WORDS (sizeof(ForkSkinnyStats_t) / sizeof(uint64_t))
+
+/* The counters of one thread, in the list of all live threads */
+typedef struct StatsBlock_s
+{
+    ForkSkinnyStats_t stats;
+    struct StatsBlock_s *next;
+
+} StatsBlock_t;
+
+static pthread_mutex_t stats_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_once_t stats_once = PTHREAD_ONCE_INIT;
+static pthread_key_t stats_key;
+static StatsBlock_t *stats_threads;
+
+/* Counters of the threads that have exited, and the totals at the last
+   reset; both are protected by stats_lock */
+static ForkSkinnyStats_t stats_retired;
+static ForkSkinnyStats_t stats_baseline;
+
+/* Counters of threads that could not allocate their own; they are not
+   reported */
+static StatsBlock_t stats_discard;
+
+static __thread StatsBlock_t *stats_local;
+
+/* Only the owning thread writes its counters, so a relaxed load and store
+   is enough for other threads to read them untorn */
+STATIC_INLINE void stats_add(uint64_t *counter, uint64_t value)
+{
+    __atomic_store_n(counter, __atomic_load_n(counter, __ATOMIC_RELAXED) + value,
+                     __ATOMIC_RELAXED);
+}
+
+/* Folds the counters of an exiting thread into stats_retired */
+static void stats_exit(void *data)
+{
+    StatsBlock_t *block = (StatsBlock_t *)data;
+    StatsBlock_t **link;
+    const uint64_t *from = (const uint64_t *)&block->stats;
+    uint64_t *to = (uint64_t *)&stats_retired;
+    uint64_t lanes[FORKSKINNY_STATS_VARIANTS];
+    unsigned variant;
+    size_t posn;
+
+    pthread_mutex_lock(&stats_lock);
+    memcpy(lanes, stats_retired.lanes, sizeof(lanes));
+    for (link = &stats_threads; *link; link = &(*link)->next) {
+        if (*link == block) {
+            *link = block->next;
+            break;
+        }
+    }
+    for (posn = 0; posn < STATS_WORDS; ++posn)
+        to[posn] += from[posn];
+    for (variant = 0; variant < FORKSKINNY_STATS_VARIANTS; ++variant)
+        stats_retired.lanes[variant] = lanes[variant] > block->stats.lanes[variant] ?
+                                       lanes[variant] : block->stats.lanes[variant];
+    pthread_mutex_unlock(&stats_lock);
+    free(block);
+
+    /* Destructors of other keys may still count */
+    stats_local = 0;
+}
+
+static void stats_init_key(void)
+{
+    pthread_key_create(&stats_key, stats_exit);
+}
+
+static StatsBlock_t *stats_thread(void)
+{
+    StatsBlock_t *block = stats_local;
+    if (block)
+        return block;
+    pthread_once(&stats_once, stats_init_key);
+    block = (StatsBlock_t *)calloc(1, sizeof(StatsBlock_t));
+    if (!block)
+        return &stats_discard;
+    pthread_mutex_lock(&stats_lock);
+    block->next = stats_threads;
+    stats_threads = block;
+    pthread_mutex_unlock(&stats_lock);
+    pthread_setspecific(stats_key, block);
+    stats_local = block;
+    return block;
+}
+
+void forkskinny_stats_batch(unsigned variant, unsigned direction, unsigned kernel, int left, int right, size_t count, unsigned lanes)
+{
+    ForkSkinnyStats_t *stats = &stats_thread()->stats;
+    ForkSkinnyStatsCounts_t *ops = &stats->ops[variant][direction][kernel];
+    unsigned bucket = 0;
+    size_t size = count;
+
+    stats_add(&ops->calls, 1);
+    stats_add(&ops->blocks, count);
+    if (left)
+        stats_add(&ops->left_blocks, count);
+    if (right)
+        stats_add(&ops->right_blocks, count);
+    if (kernel == FORKSKINNY_STATS_SCALAR || count == 0)
+        return;
+
+    while (size > 1 && bucket < FORKSKINNY_STATS_BATCH_BUCKETS - 1) {
+        size >>= 1;
+        ++bucket;
+    }
+    stats_add(&stats->batches[variant][bucket], 1);
+    stats_add(&stats->full_groups[variant], count / lanes);
+    if (count % lanes)
+        stats_add(&stats->partial_groups[variant], 1);
+    __atomic_store_n(&stats->lanes[variant], lanes, __ATOMIC_RELAXED);
+}
+
+void forkskinny_stats_init(unsigned variant, unsigned tk)
+{
+    stats_add(&stats_thread()->stats.inits[variant][tk], 1);
+}
+
+/* Adds up all counters; called with stats_lock held */
+static void stats_total(ForkSkinnyStats_t *stats)
+{
+    uint64_t *to = (uint64_t *)stats;
+    const StatsBlock_t *block;
+    const uint64_t *from;
+    size_t posn;
+
+    *stats = stats_retired;
+    for (block = stats_threads; block; block = block->next) {
+        from = (const uint64_t *)&block->stats;
+        for (posn = 0; posn < STATS_WORDS; ++posn)
+            to[posn] += __atomic_load_n(&from[posn], __ATOMIC_RELAXED);
+    }
+}
+
+void forkskinny_c_stats_snapshot(ForkSkinnyStats_t *stats)
+{
+    uint64_t *to = (uint64_t *)stats;
+    const uint64_t *base = (const uint64_t *)&stats_baseline;
+    uint64_t lanes[FORKSKINNY_STATS_VARIANTS];
+    const StatsBlock_t *block;
+    unsigned variant;
+    size_t posn;
+
+    pthread_mutex_lock(&stats_lock);
+    stats_total(stats);
+
+    /* The lanes are a property of the build, not a count */
+    for (variant = 0; variant < FORKSKINNY_STATS_VARIANTS; ++variant) {
+        lanes[variant] = stats_retired.lanes[variant];
+        for (block = stats_threads; block; block = block->next) {
+            uint64_t value = __atomic_load_n(&block->stats.lanes[variant], __ATOMIC_RELAXED);
+            if (value > lanes[variant])
+                lanes[variant] = value;
+        }
+    }
+    for (posn = 0; posn < STATS_WORDS; ++posn)
+        to[posn] -= base[posn];
+    pthread_mutex_unlock(&stats_lock);
+    for (variant = 0; variant < FORKSKINNY_STATS_VARIANTS; ++variant)
+        stats->lanes[variant] = lanes[variant];
+}
+
+void forkskinny_c_stats_reset(void)
+{
+    pthread_mutex_lock(&stats_lock);
+    stats_total(&stats_baseline);
+    pthread_mutex_unlock(&stats_lock);
+}
+
+#else /* !FORKSKINNY_STATS */
+
+void forkskinny_c_stats_snapshot(ForkSkinnyStats_t *stats)
+{
+    memset(stats, 0, sizeof(ForkSkinnyStats_t));
+}
+
+void forkskinny_c_stats_reset(void)
+{
+}
+
+#endif /* !FORKSKINNY_STATS */
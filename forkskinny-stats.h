@@ -0,0 +1,116 @@
+#ifndef FORKSKINNY_C_FORKSKINNY_STATS_H
+#define FORKSKINNY_C_FORKSKINNY_STATS_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Operation counters of the forkcipher functions.
+ *
+ * When the library is built with FORKSKINNY_STATS defined to 1 (make
+ * STATS=1), every scalar and batch forkcipher call and every key schedule
+ * computation is counted: calls and blocks per variant, direction and
+ * kernel, the blocks for which each leg was computed, the batch sizes and
+ * how the batches filled the SIMD lanes. The modes are built on these
+ * functions, so their work shows up here too.
+ *
+ * Each thread counts into its own block of counters without atomic
+ * read-modify-write operations; forkskinny_c_stats_snapshot adds up the
+ * blocks of all threads, including threads that have exited. Without
+ * FORKSKINNY_STATS the functions below still exist, but the library
+ * counts nothing and snapshots are all zero.
+ */
+
+/** Variants */
+#define FORKSKINNY_STATS_64_192     0
+#define FORKSKINNY_STATS_128_256    1
+#define FORKSKINNY_STATS_128_384    2
+#define FORKSKINNY_STATS_VARIANTS   3
+
+/** Directions */
+#define FORKSKINNY_STATS_ENCRYPT    0
+#define FORKSKINNY_STATS_DECRYPT    1
+#define FORKSKINNY_STATS_DIRECTIONS 2
+
+/** Kernels: forkskinny_c_*_encrypt/decrypt, *_parallel, *_multikey and *_reduced */
+#define FORKSKINNY_STATS_SCALAR     0
+#define FORKSKINNY_STATS_PARALLEL   1
+#define FORKSKINNY_STATS_MULTIKEY   2
+#define FORKSKINNY_STATS_REDUCED    3
+#define FORKSKINNY_STATS_KERNELS    4
+
+/** Tweakey parts; forkskinny_c_64_192_init_tk2_tk3 counts as TK2 and TK3 */
+#define FORKSKINNY_STATS_TK1        0
+#define FORKSKINNY_STATS_TK2        1
+#define FORKSKINNY_STATS_TK3        2
+#define FORKSKINNY_STATS_TKS        3
+
+/** Batch sizes: bucket i counts batches of 2^i to 2^(i+1) - 1 blocks, the last bucket all larger ones */
+#define FORKSKINNY_STATS_BATCH_BUCKETS 17
+
+/**
+ * Counters of one kind of call
+ */
+typedef struct
+{
+    /** Number of calls */
+    uint64_t calls;
+
+    /** Number of blocks */
+    uint64_t blocks;
+
+    /** Blocks of which the left leg was computed */
+    uint64_t left_blocks;
+
+    /** Blocks of which the right leg (for decryption: the inverse, mode 'i') was computed */
+    uint64_t right_blocks;
+
+} ForkSkinnyStatsCounts_t;
+
+/**
+ * Snapshot of all counters
+ */
+typedef struct
+{
+    /** Forkcipher calls per variant, direction and kernel */
+    ForkSkinnyStatsCounts_t ops[FORKSKINNY_STATS_VARIANTS][FORKSKINNY_STATS_DIRECTIONS][FORKSKINNY_STATS_KERNELS];
+
+    /** Key schedule computations per variant and tweakey part */
+    uint64_t inits[FORKSKINNY_STATS_VARIANTS][FORKSKINNY_STATS_TKS];
+
+    /** Non-empty calls of the batch kernels by number of blocks */
+    uint64_t batches[FORKSKINNY_STATS_VARIANTS][FORKSKINNY_STATS_BATCH_BUCKETS];
+
+    /** Groups of blocks run by the batch kernels with all lanes used, and with some lanes unused */
+    uint64_t full_groups[FORKSKINNY_STATS_VARIANTS];
+    uint64_t partial_groups[FORKSKINNY_STATS_VARIANTS];
+
+    /** Number of SIMD lanes of the batch kernels, 0 if they have not run */
+    uint64_t lanes[FORKSKINNY_STATS_VARIANTS];
+
+} ForkSkinnyStats_t;
+
+/**
+ * Returns non-zero if the library was built with the counters.
+ */
+int forkskinny_c_stats_enabled(void);
+
+/**
+ * Adds up the counters of all threads since the last reset.
+ * stats:   will contain the counters
+ */
+void forkskinny_c_stats_snapshot(ForkSkinnyStats_t *stats);
+
+/**
+ * Starts counting from zero again, for all threads.
+ */
+void forkskinny_c_stats_reset(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // FORKSKINNY_C_FORKSKINNY_STATS_H
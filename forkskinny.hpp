@@ -0,0 +1,329 @@
+#ifndef FORKSKINNY_C_FORKSKINNY_HPP
+#define FORKSKINNY_C_FORKSKINNY_HPP
+
+#include "forkskinny64-parallel.h"
+#include "forkskinny128-parallel.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <stdexcept>
+
+/*
+ * Header-only C++20 layer over the forkskinny_c_* functions.
+ *
+ * The variant of the forkcipher is a template parameter: one of
+ * forkskinny::ForkSkinny64_192, ForkSkinny128_256 and ForkSkinny128_384.
+ * It fixes the block and key sizes, the round counts and the C functions
+ * that are called, all at compile time, so a Key<Variant> always holds
+ * schedules of the right kind and length for Cipher<Variant>.
+ *
+ * Batches are passed as spans of whole blocks and always go to the
+ * *_parallel kernels, which fill the widest SIMD registers available; a
+ * single block is a batch of one. An empty span for an output leg skips
+ * that leg, as NULL does in the C functions. Spans of the wrong size throw
+ * std::invalid_argument.
+ */
+
+namespace forkskinny {
+
+/**
+ * Forkskinny-64-192: 64-bit blocks, 64-bit TK1, TK2 and TK3 from a 128-bit key
+ */
+struct ForkSkinny64_192
+{
+    static constexpr std::size_t block_size = FORKSKINNY64_BLOCK_SIZE;
+    static constexpr std::size_t key_size = 2 * FORKSKINNY64_BLOCK_SIZE;
+    static constexpr unsigned rounds_before = FORKSKINNY_64_192_ROUNDS_BEFORE;
+    static constexpr unsigned rounds_after = FORKSKINNY_64_192_ROUNDS_AFTER;
+
+    struct Schedules
+    {
+        ForkSkinny64Key_t tks2;
+    };
+
+    static void init(Schedules &ks, const uint8_t *key, unsigned rounds)
+    {
+        forkskinny_c_64_192_init_tk2_tk3(&ks.tks2, key, rounds);
+    }
+
+    static void encrypt(const Schedules &ks, const uint8_t *tk1,
+                        uint8_t *left, uint8_t *right,
+                        const uint8_t *input, std::size_t count)
+    {
+        forkskinny_c_64_192_encrypt_parallel
+            (tk1, &ks.tks2, left, right, input, count);
+    }
+
+    static void decrypt(const Schedules &ks, const uint8_t *tk1,
+                        uint8_t *left, uint8_t *right,
+                        const uint8_t *input, std::size_t count)
+    {
+        forkskinny_c_64_192_decrypt_parallel
+            (tk1, &ks.tks2, left, right, input, count);
+    }
+};
+
+/**
+ * Forkskinny-128-256: 128-bit blocks, 128-bit TK1, TK2 from a 128-bit key
+ */
+struct ForkSkinny128_256
+{
+    static constexpr std::size_t block_size = FORKSKINNY128_BLOCK_SIZE;
+    static constexpr std::size_t key_size = FORKSKINNY128_BLOCK_SIZE;
+    static constexpr unsigned rounds_before = FORKSKINNY_128_256_ROUNDS_BEFORE;
+    static constexpr unsigned rounds_after = FORKSKINNY_128_256_ROUNDS_AFTER;
+
+    struct Schedules
+    {
+        ForkSkinny128Key_t ks2;
+    };
+
+    static void init(Schedules &ks, const uint8_t *key, unsigned rounds)
+    {
+        forkskinny_c_128_256_init_tk2(&ks.ks2, key, rounds);
+    }
+
+    static void encrypt(const Schedules &ks, const uint8_t *tk1,
+                        uint8_t *left, uint8_t *right,
+                        const uint8_t *input, std::size_t count)
+    {
+        forkskinny_c_128_256_encrypt_parallel
+            (tk1, &ks.ks2, left, right, input, count);
+    }
+
+    static void decrypt(const Schedules &ks, const uint8_t *tk1,
+                        uint8_t *left, uint8_t *right,
+                        const uint8_t *input, std::size_t count)
+    {
+        forkskinny_c_128_256_decrypt_parallel
+            (tk1, &ks.ks2, left, right, input, count);
+    }
+};
+
+/**
+ * Forkskinny-128-384: 128-bit blocks, 128-bit TK1, TK2 and TK3 from a
+ * 256-bit key
+ */
+struct ForkSkinny128_384
+{
+    static constexpr std::size_t block_size = FORKSKINNY128_BLOCK_SIZE;
+    static constexpr std::size_t key_size = 2 * FORKSKINNY128_BLOCK_SIZE;
+    static constexpr unsigned rounds_before = FORKSKINNY_128_384_ROUNDS_BEFORE;
+    static constexpr unsigned rounds_after = FORKSKINNY_128_384_ROUNDS_AFTER;
+
+    struct Schedules
+    {
+        ForkSkinny128Key_t ks2;
+        ForkSkinny128Key_t ks3;
+    };
+
+    static void init(Schedules &ks, const uint8_t *key, unsigned rounds)
+    {
+        forkskinny_c_128_384_init_tk2(&ks.ks2, key, rounds);
+        forkskinny_c_128_384_init_tk3(&ks.ks3, key + FORKSKINNY128_BLOCK_SIZE, rounds);
+    }
+
+    static void encrypt(const Schedules &ks, const uint8_t *tk1,
+                        uint8_t *left, uint8_t *right,
+                        const uint8_t *input, std::size_t count)
+    {
+        forkskinny_c_128_384_encrypt_parallel
+            (tk1, &ks.ks2, &ks.ks3, left, right, input, count);
+    }
+
+    static void decrypt(const Schedules &ks, const uint8_t *tk1,
+                        uint8_t *left, uint8_t *right,
+                        const uint8_t *input, std::size_t count)
+    {
+        forkskinny_c_128_384_decrypt_parallel
+            (tk1, &ks.ks2, &ks.ks3, left, right, input, count);
+    }
+};
+
+/**
+ * Key schedules of a variant, expanded for exactly the rounds of the
+ * variant. The schedules are kept on the heap, so moving a key is cheap;
+ * they are zeroed when the key is destroyed. A moved-from key is empty and
+ * may only be assigned to or destroyed.
+ */
+template <typename Variant>
+class Key
+{
+public:
+    using Schedules = typename Variant::Schedules;
+
+    static constexpr std::size_t size = Variant::key_size;
+    static constexpr unsigned rounds =
+        Variant::rounds_before + 2 * Variant::rounds_after;
+
+    /**
+     * Expands a key.
+     * key:     the TK2 (and TK3) bytes of the variant
+     */
+    explicit Key(std::span<const uint8_t, size> key)
+        : schedules_(new Schedules)
+    {
+        Variant::init(*schedules_, key.data(), rounds);
+    }
+
+    Key(Key &&) noexcept = default;
+    Key &operator=(Key &&) noexcept = default;
+    Key(const Key &) = delete;
+    Key &operator=(const Key &) = delete;
+
+    /** Returns true unless the key was moved from */
+    explicit operator bool() const noexcept
+    {
+        return schedules_ != nullptr;
+    }
+
+    /** Returns the schedules, for passing to the C functions */
+    const Schedules &schedules() const noexcept
+    {
+        return *schedules_;
+    }
+
+private:
+    struct Wipe
+    {
+        void operator()(Schedules *ks) const noexcept
+        {
+            volatile uint8_t *bytes = reinterpret_cast<volatile uint8_t *>(ks);
+            for (std::size_t posn = 0; posn < sizeof(Schedules); ++posn)
+                bytes[posn] = 0;
+            delete ks;
+        }
+    };
+
+    std::unique_ptr<Schedules, Wipe> schedules_;
+};
+
+/**
+ * The forkcipher of a variant under one key, for batches of blocks that
+ * each have their own TK1.
+ */
+template <typename Variant>
+class Cipher
+{
+public:
+    static constexpr std::size_t block_size = Variant::block_size;
+    static constexpr std::size_t tweak_size = Variant::block_size;
+    static constexpr std::size_t key_size = Variant::key_size;
+    static constexpr unsigned rounds_before = Variant::rounds_before;
+    static constexpr unsigned rounds_after = Variant::rounds_after;
+    static constexpr unsigned rounds = Key<Variant>::rounds;
+
+    using Block = std::array<uint8_t, block_size>;
+
+    /** Both output legs of one block */
+    struct Legs
+    {
+        Block left;
+        Block right;
+    };
+
+    explicit Cipher(std::span<const uint8_t, key_size> key)
+        : key_(key)
+    {
+    }
+
+    explicit Cipher(Key<Variant> key) noexcept
+        : key_(std::move(key))
+    {
+    }
+
+    const Key<Variant> &key() const noexcept
+    {
+        return key_;
+    }
+
+    /**
+     * Computes the forward direction for a batch of blocks.
+     * tk1:           the TK1 of each block
+     * output_left:   empty to skip the left legs, else as long as input; will contain the left output legs
+     * output_right:  empty to skip the right legs, else as long as input; will contain the right output legs
+     * input:         a whole number of blocks; inputs to the forkcipher
+     */
+    void encrypt(std::span<const uint8_t> tk1,
+                 std::span<uint8_t> output_left,
+                 std::span<uint8_t> output_right,
+                 std::span<const uint8_t> input) const
+    {
+        std::size_t count = check(tk1, output_left, output_right, input);
+        Variant::encrypt(key_.schedules(), tk1.data(),
+                         leg(output_left), leg(output_right),
+                         input.data(), count);
+    }
+
+    /**
+     * Computes the inverse direction for a batch of blocks.
+     * tk1:           the TK1 of each block
+     * output_left:   empty to skip the left legs, else as long as input_right; will contain the left output legs (i.e. mode 'o')
+     * output_right:  empty to skip the rounds before the forking point, else as long as input_right; will contain the inverted inputs (i.e. mode 'i')
+     * input_right:   a whole number of blocks; right legs to invert
+     */
+    void decrypt(std::span<const uint8_t> tk1,
+                 std::span<uint8_t> output_left,
+                 std::span<uint8_t> output_right,
+                 std::span<const uint8_t> input_right) const
+    {
+        std::size_t count = check(tk1, output_left, output_right, input_right);
+        Variant::decrypt(key_.schedules(), tk1.data(),
+                         leg(output_left), leg(output_right),
+                         input_right.data(), count);
+    }
+
+    /** Computes both legs of one block in the forward direction */
+    Legs encrypt_block(std::span<const uint8_t, tweak_size> tk1,
+                       std::span<const uint8_t, block_size> input) const
+    {
+        Legs legs;
+        Variant::encrypt(key_.schedules(), tk1.data(), legs.left.data(),
+                         legs.right.data(), input.data(), 1);
+        return legs;
+    }
+
+    /**
+     * Inverts the right leg of one block: the left leg and the input of
+     * the forward direction.
+     */
+    Legs decrypt_block(std::span<const uint8_t, tweak_size> tk1,
+                       std::span<const uint8_t, block_size> input_right) const
+    {
+        Legs legs;
+        Variant::decrypt(key_.schedules(), tk1.data(), legs.left.data(),
+                         legs.right.data(), input_right.data(), 1);
+        return legs;
+    }
+
+private:
+    static uint8_t *leg(std::span<uint8_t> output) noexcept
+    {
+        return output.empty() ? nullptr : output.data();
+    }
+
+    /* Returns the number of blocks of a batch, checking all sizes */
+    static std::size_t check(std::span<const uint8_t> tk1,
+                             std::span<uint8_t> output_left,
+                             std::span<uint8_t> output_right,
+                             std::span<const uint8_t> input)
+    {
+        if (input.size() % block_size != 0)
+            throw std::invalid_argument("forkskinny: input is not a whole number of blocks");
+        if (tk1.size() != input.size())
+            throw std::invalid_argument("forkskinny: tk1 does not match the input");
+        if ((!output_left.empty() && output_left.size() != input.size()) ||
+                (!output_right.empty() && output_right.size() != input.size()))
+            throw std::invalid_argument("forkskinny: output leg does not match the input");
+        return input.size() / block_size;
+    }
+
+    Key<Variant> key_;
+};
+
+} // namespace forkskinny
+
+#endif // FORKSKINNY_C_FORKSKINNY_HPP
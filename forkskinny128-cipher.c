@@ -64,6 +64,8 @@ void forkskinny_c_128_256_init_tk1(ForkSkinny128Key_t *ks, const uint8_t *key, u
     ForkSkinny128Cells_t tk;
     unsigned index;
 
+    FORKSKINNY_STATS_INIT(FORKSKINNY_STATS_128_256, FORKSKINNY_STATS_TK1);
+
     /* Unpack the key and convert from little-endian to host-endian */
     tk.row[0] = READ_WORD32(key, 0);
     tk.row[1] = READ_WORD32(key, 4);
@@ -90,6 +92,8 @@ void forkskinny_c_128_384_init_tk1(ForkSkinny128Key_t *ks, const uint8_t *key, u
     ForkSkinny128Cells_t tk;
     unsigned index;
 
+    FORKSKINNY_STATS_INIT(FORKSKINNY_STATS_128_384, FORKSKINNY_STATS_TK1);
+
     /* Unpack the key and convert from little-endian to host-endian */
     tk.row[0] = READ_WORD32(key, 0);
     tk.row[1] = READ_WORD32(key, 4);
@@ -115,6 +119,8 @@ void forkskinny_c_128_256_init_tk2(ForkSkinny128Key_t *ks, const uint8_t *key, u
     ForkSkinny128Cells_t tk;
     unsigned index;
 
+    FORKSKINNY_STATS_INIT(FORKSKINNY_STATS_128_256, FORKSKINNY_STATS_TK2);
+
     /* Unpack the key and convert from little-endian to host-endian */
     tk.row[0] = READ_WORD32(key, 0);
     tk.row[1] = READ_WORD32(key, 4);
@@ -157,6 +163,8 @@ void forkskinny_c_128_384_init_tk2
     unsigned index;
     // uint16_t word;
 
+    FORKSKINNY_STATS_INIT(FORKSKINNY_STATS_128_384, FORKSKINNY_STATS_TK2);
+
     /* Unpack the key and convert from little-endian to host-endian */
     tk.row[0] = READ_WORD32(key, 0);
     tk.row[1] = READ_WORD32(key, 4);
@@ -190,6 +198,8 @@ void forkskinny_c_128_384_init_tk3(ForkSkinny128Key_t *ks, const uint8_t *key, u
     ForkSkinny128Cells_t tk;
     unsigned index;
 
+    FORKSKINNY_STATS_INIT(FORKSKINNY_STATS_128_384, FORKSKINNY_STATS_TK3);
+
     tk.row[0] = READ_WORD32(key, 0);
     tk.row[1] = READ_WORD32(key, 4);
     tk.row[2] = READ_WORD32(key, 8);
@@ -502,6 +512,13 @@ void forkskinny_c_128_256_encrypt
 {
     ForkSkinny128Cells_t state;
 
+    /* Nothing to compute */
+    if (!output_left && !output_right)
+        return;
+
+    FORKSKINNY_STATS_BATCH(FORKSKINNY_STATS_128_256, FORKSKINNY_STATS_ENCRYPT,
+                           FORKSKINNY_STATS_SCALAR, output_left, output_right, 1, 1);
+
     /* Read the input buffer and convert little-endian to host-endian */
     state.row[0] = READ_WORD32(input, 0);
     state.row[1] = READ_WORD32(input, 4);
@@ -666,6 +683,13 @@ void forkskinny_c_128_256_decrypt
 {
     ForkSkinny128Cells_t state;
 
+    /* Nothing to compute */
+    if (!output_left && !output_right)
+        return;
+
+    FORKSKINNY_STATS_BATCH(FORKSKINNY_STATS_128_256, FORKSKINNY_STATS_DECRYPT,
+                           FORKSKINNY_STATS_SCALAR, output_left, output_right, 1, 1);
+
     /* Read the input buffer and convert little-endian to host-endian */
     state.row[0] = READ_WORD32(input_right, 0);
     state.row[1] = READ_WORD32(input_right, 4);
@@ -705,15 +729,17 @@ void forkskinny_c_128_256_decrypt
       WRITE_WORD32(output_left, 12, fstate.row[3]);
     }
 
-    /* Generate the right output block by going backward "before"
-     * rounds from the forking point */
-    state = forkskinny_128_decrypt_rounds
-        (state, tks1, tks2, FORKSKINNY_128_256_ROUNDS_BEFORE, 0);
-    /* Convert host-endian back into little-endian in the output buffer */
-    WRITE_WORD32(output_right, 0, state.row[0]);
-    WRITE_WORD32(output_right, 4, state.row[1]);
-    WRITE_WORD32(output_right, 8, state.row[2]);
-    WRITE_WORD32(output_right, 12, state.row[3]);
+    if (output_right) {
+        /* Generate the right output block by going backward "before"
+         * rounds from the forking point */
+        state = forkskinny_128_decrypt_rounds
+            (state, tks1, tks2, FORKSKINNY_128_256_ROUNDS_BEFORE, 0);
+        /* Convert host-endian back into little-endian in the output buffer */
+        WRITE_WORD32(output_right, 0, state.row[0]);
+        WRITE_WORD32(output_right, 4, state.row[1]);
+        WRITE_WORD32(output_right, 8, state.row[2]);
+        WRITE_WORD32(output_right, 12, state.row[3]);
+    }
 }
 
 void forkskinny_c_128_384_encrypt
@@ -725,6 +751,13 @@ void forkskinny_c_128_384_encrypt
 {
     ForkSkinny128Cells_t state;
 
+    /* Nothing to compute */
+    if (!output_left && !output_right)
+        return;
+
+    FORKSKINNY_STATS_BATCH(FORKSKINNY_STATS_128_384, FORKSKINNY_STATS_ENCRYPT,
+                           FORKSKINNY_STATS_SCALAR, output_left, output_right, 1, 1);
+
     /* Read the input buffer and convert little-endian to host-endian */
     state.row[0] = READ_WORD32(input, 0);
     state.row[1] = READ_WORD32(input, 4);
@@ -793,6 +826,13 @@ void forkskinny_c_128_384_decrypt
 {
     ForkSkinny128Cells_t state;
 
+    /* Nothing to compute */
+    if (!output_left && !output_right)
+        return;
+
+    FORKSKINNY_STATS_BATCH(FORKSKINNY_STATS_128_384, FORKSKINNY_STATS_DECRYPT,
+                           FORKSKINNY_STATS_SCALAR, output_left, output_right, 1, 1);
+
     /* Read the input buffer and convert little-endian to host-endian */
     state.row[0] = READ_WORD32(input_right, 0);
     state.row[1] = READ_WORD32(input_right, 4);
@@ -831,13 +871,15 @@ void forkskinny_c_128_384_decrypt
       WRITE_WORD32(output_left, 12, fstate.row[3]);
     }
 
-    /* Generate the right output block by going backward "before"
-     * rounds from the forking point */
-    state = forkskinny_128_384_decrypt_rounds
-        (state, tks1, tks2, tks3, FORKSKINNY_128_384_ROUNDS_BEFORE, 0);
-    /* Convert host-endian back into little-endian in the output buffer */
-    WRITE_WORD32(output_right, 0, state.row[0]);
-    WRITE_WORD32(output_right, 4, state.row[1]);
-    WRITE_WORD32(output_right, 8, state.row[2]);
-    WRITE_WORD32(output_right, 12, state.row[3]);
+    if (output_right) {
+        /* Generate the right output block by going backward "before"
+         * rounds from the forking point */
+        state = forkskinny_128_384_decrypt_rounds
+            (state, tks1, tks2, tks3, FORKSKINNY_128_384_ROUNDS_BEFORE, 0);
+        /* Convert host-endian back into little-endian in the output buffer */
+        WRITE_WORD32(output_right, 0, state.row[0]);
+        WRITE_WORD32(output_right, 4, state.row[1]);
+        WRITE_WORD32(output_right, 8, state.row[2]);
+        WRITE_WORD32(output_right, 12, state.row[3]);
+    }
 }
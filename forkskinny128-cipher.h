@@ -90,42 +90,46 @@ void forkskinny_c_128_384_init_tk3(ForkSkinny128Key_t *ks, const uint8_t *key, u
 
 /**
  * Computes the forward direction of Forkskinny-128-256.
+ * Nothing is computed if both outputs are NULL.
  * ks1:           key schedule for TK1 (see forkskinny_c_128_256_init_tk1)
  * ks2:           key schedule for TK2 (see forkskinny_c_128_256_init_tk2)
  * output_left:   if NULL, the left leg is not computed, else pointer to FORKSKINNY128_BLOCK_SIZE byte; will contain the left output leg of the forkcipher
- * output_right:  pointer to FORKSKINNY128_BLOCK_SIZE byte; will contain the right output leg of the forkcipher
+ * output_right:  if NULL, the right leg is not computed, else pointer to FORKSKINNY128_BLOCK_SIZE byte; will contain the right output leg of the forkcipher
  * input:         pointer to FORKSKINNY128_BLOCK_SIZE byte; input to the forkcipher
  */
 void forkskinny_c_128_256_encrypt(const ForkSkinny128Key_t *ks1, const ForkSkinny128Key_t *ks2, uint8_t *output_left, uint8_t *output_right, const uint8_t *input);
 
 /**
  * Computes the inverse direction of Forkskinny-128-256.
+ * Nothing is computed if both outputs are NULL.
  * ks1:           key schedule for TK1 (see forkskinny_c_128_256_init_tk1)
  * ks2:           key schedule for TK2 (see forkskinny_c_128_256_init_tk2)
  * output_left:   if NULL, the left leg is not computed, else pointer to FORKSKINNY128_BLOCK_SIZE byte; will contain the left output leg of the forkcipher (i.e. mode 'o')
- * output_right:  pointer to FORKSKINNY128_BLOCK_SIZE byte; will contain the inverted input of the forkcipher (i.e. mode 'i')
+ * output_right:  if NULL, the rounds before the forking point are not computed, else pointer to FORKSKINNY128_BLOCK_SIZE byte; will contain the inverted input of the forkcipher (i.e. mode 'i')
  * input_right:   pointer to FORKSKINNY128_BLOCK_SIZE byte; input to the inverse forkcipher
  */
 void forkskinny_c_128_256_decrypt(const ForkSkinny128Key_t *ks1, const ForkSkinny128Key_t *ks2, uint8_t *output_left, uint8_t *output_right, const uint8_t *input_right);
 
 /**
  * Computes the forward direction of Forkskinny-128-384.
+ * Nothing is computed if both outputs are NULL.
  * ks1:           key schedule for TK1 (see forkskinny_c_128_384_init_tk1)
  * ks2:           key schedule for TK2 (see forkskinny_c_128_384_init_tk2)
  * ks3:           key schedule for TK3 (see forkskinny_c_128_384_init_tk3)
  * output_left:   if NULL, the left leg is not computed, else pointer to FORKSKINNY128_BLOCK_SIZE byte; will contain the left output leg of the forkcipher
- * output_right:  pointer to FORKSKINNY128_BLOCK_SIZE byte; will contain the right output leg of the forkcipher
+ * output_right:  if NULL, the right leg is not computed, else pointer to FORKSKINNY128_BLOCK_SIZE byte; will contain the right output leg of the forkcipher
  * input:         pointer to FORKSKINNY128_BLOCK_SIZE byte; input to the forkcipher
  */
 void forkskinny_c_128_384_encrypt(const ForkSkinny128Key_t *ks1, const ForkSkinny128Key_t *ks2, const ForkSkinny128Key_t *ks3, uint8_t *output_left, uint8_t *output_right, const uint8_t *input);
 
 /**
  * Computes the inverse direction of Forkskinny-128-384.
+ * Nothing is computed if both outputs are NULL.
  * ks1:           key schedule for TK1 (see forkskinny_c_128_384_init_tk1)
  * ks2:           key schedule for TK2 (see forkskinny_c_128_384_init_tk2)
  * ks3:           key schedule for TK3 (see forkskinny_c_128_384_init_tk3)
  * output_left:   if NULL, the left leg is not computed, else pointer to FORKSKINNY128_BLOCK_SIZE byte; will contain the left output leg of the forkcipher (i.e. mode 'o')
- * output_right:  pointer to FORKSKINNY128_BLOCK_SIZE byte; will contain the inverted input of the forkcipher (i.e. mode 'i')
+ * output_right:  if NULL, the rounds before the forking point are not computed, else pointer to FORKSKINNY128_BLOCK_SIZE byte; will contain the inverted input of the forkcipher (i.e. mode 'i')
  * input_right:   pointer to FORKSKINNY128_BLOCK_SIZE byte; input to the inverse forkcipher
  */
 void forkskinny_c_128_384_decrypt(const ForkSkinny128Key_t *ks1, const ForkSkinny128Key_t *ks2, const ForkSkinny128Key_t *ks3, uint8_t *output_left, uint8_t *output_right, const uint8_t *input_right);
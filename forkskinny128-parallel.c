@@ -0,0 +1,620 @@
+#include "forkskinny128-parallel.h"
+#include "forkskinny-internal.h"
+
+/* Each lane of a vector holds the same 32-bit row of a different block.
+   Without vector support we fall back to a single lane per group. */
+#if SKINNY_VEC256_MATH
+#define FORKSKINNY128_LANES 8
+typedef uint32_t ForkSkinny128Lane_t SKINNY_VECTOR_ATTR(8, 32);
+#elif SKINNY_VEC128_MATH
+#define FORKSKINNY128_LANES 4
+typedef uint32_t ForkSkinny128Lane_t SKINNY_VECTOR_ATTR(4, 16);
+#else
+#define FORKSKINNY128_LANES 1
+typedef uint32_t ForkSkinny128Lane_t;
+#endif
+
+#if FORKSKINNY128_LANES > 1
+#define LANE(vec, lane) ((vec)[(lane)])
+#else
+#define LANE(vec, lane) (vec)
+#endif
+
+/**
+ * Rows of FORKSKINNY128_LANES states (or tweakeys), transposed so that
+ * every row holds one 32-bit row of each block.
+ */
+typedef struct
+{
+    ForkSkinny128Lane_t row[4];
+
+} ForkSkinny128Lanes_t;
+
+/**
+ * The first two rows of TK1 for FORKSKINNY128_TK1_PERIOD consecutive rounds.
+ */
+typedef struct
+{
+    ForkSkinny128Lane_t schedule[FORKSKINNY128_TK1_PERIOD][2];
+
+} ForkSkinny128LanesTK1_t;
+
+/**
+ * The first two rows of TK2 ^ TK3 of every lane for all rounds, for batches
+ * in which every block has its own key.
+ */
+typedef struct
+{
+    ForkSkinny128Lane_t schedule[FORKSKINNY128_MAX_ROUNDS][2];
+
+} ForkSkinny128LanesKey_t;
+
+STATIC_INLINE ForkSkinny128Lane_t skinny128_lanes_rotate_right
+    (ForkSkinny128Lane_t x, unsigned count)
+{
+    /* See skinny128_rotate_right() for the direction of the rotation */
+    return (x << count) | (x >> (32 - count));
+}
+
+STATIC_INLINE ForkSkinny128Lane_t skinny128_lanes_sbox(ForkSkinny128Lane_t x)
+{
+    /* Same bit-sliced S-box as the 32-bit version of skinny128_sbox() */
+    ForkSkinny128Lane_t y;
+
+    /* Mix the bits */
+    x = ~x;
+    x ^= (((x >> 2) & (x >> 3)) & 0x11111111U);
+    y  = (((x << 5) & (x << 1)) & 0x20202020U);
+    x ^= (((x << 5) & (x << 4)) & 0x40404040U) ^ y;
+    y  = (((x << 2) & (x << 1)) & 0x80808080U);
+    x ^= (((x >> 2) & (x << 1)) & 0x02020202U) ^ y;
+    y  = (((x >> 5) & (x << 1)) & 0x04040404U);
+    x ^= (((x >> 1) & (x >> 2)) & 0x08080808U) ^ y;
+    x = ~x;
+
+    /* The final permutation for each byte is [2 7 6 1 3 0 4 5] */
+    return ((x & 0x08080808U) << 1) |
+           ((x & 0x32323232U) << 2) |
+           ((x & 0x01010101U) << 5) |
+           ((x & 0x80808080U) >> 6) |
+           ((x & 0x40404040U) >> 4) |
+           ((x & 0x04040404U) >> 2);
+}
+
+STATIC_INLINE ForkSkinny128Lane_t skinny128_lanes_inv_sbox(ForkSkinny128Lane_t x)
+{
+    /* Same bit-sliced S-box as the 32-bit version of skinny128_inv_sbox() */
+    ForkSkinny128Lane_t y;
+
+    /* Mix the bits */
+    x = ~x;
+    y  = (((x >> 1) & (x >> 3)) & 0x01010101U);
+    x ^= (((x >> 2) & (x >> 3)) & 0x10101010U) ^ y;
+    y  = (((x >> 6) & (x >> 1)) & 0x02020202U);
+    x ^= (((x >> 1) & (x >> 2)) & 0x08080808U) ^ y;
+    y  = (((x << 2) & (x << 1)) & 0x80808080U);
+    x ^= (((x >> 1) & (x << 2)) & 0x04040404U) ^ y;
+    y  = (((x << 5) & (x << 1)) & 0x20202020U);
+    x ^= (((x << 4) & (x << 5)) & 0x40404040U) ^ y;
+    x = ~x;
+
+    /* The final permutation for each byte is [5 3 0 4 6 7 2 1] */
+    return ((x & 0x01010101U) << 2) |
+           ((x & 0x04040404U) << 4) |
+           ((x & 0x02020202U) << 6) |
+           ((x & 0x20202020U) >> 5) |
+           ((x & 0xC8C8C8C8U) >> 2) |
+           ((x & 0x10101010U) >> 1);
+}
+
+STATIC_INLINE void skinny128_lanes_permute_tk(ForkSkinny128Lanes_t *tk)
+{
+    /* PT = [9, 15, 8, 13, 10, 14, 12, 11, 0, 1, 2, 3, 4, 5, 6, 7] */
+    ForkSkinny128Lane_t row2 = tk->row[2];
+    ForkSkinny128Lane_t row3 = tk->row[3];
+    tk->row[2] = tk->row[0];
+    tk->row[3] = tk->row[1];
+    row3 = (row3 << 16) | (row3 >> 16);
+    tk->row[0] = ((row2 >>  8) & 0x000000FFU) |
+                 ((row2 << 16) & 0x00FF0000U) |
+                 ( row3        & 0xFF00FF00U);
+    tk->row[1] = ((row2 >> 16) & 0x000000FFU) |
+                  (row2        & 0xFF000000U) |
+                 ((row3 <<  8) & 0x0000FF00U) |
+                 ( row3        & 0x00FF0000U);
+}
+
+/* Reads count blocks into the lanes; the unused lanes are set to zero */
+STATIC_INLINE void forkskinny128_lanes_load
+    (ForkSkinny128Lanes_t *lanes, const uint8_t *input, unsigned count)
+{
+    unsigned lane;
+    memset(lanes, 0, sizeof(ForkSkinny128Lanes_t));
+    for (lane = 0; lane < count; ++lane, input += FORKSKINNY128_BLOCK_SIZE) {
+        LANE(lanes->row[0], lane) = READ_WORD32(input, 0);
+        LANE(lanes->row[1], lane) = READ_WORD32(input, 4);
+        LANE(lanes->row[2], lane) = READ_WORD32(input, 8);
+        LANE(lanes->row[3], lane) = READ_WORD32(input, 12);
+    }
+}
+
+/* Writes the first count lanes back into little-endian blocks */
+STATIC_INLINE void forkskinny128_lanes_store
+    (uint8_t *output, const ForkSkinny128Lanes_t *lanes, unsigned count)
+{
+    unsigned lane;
+    for (lane = 0; lane < count; ++lane, output += FORKSKINNY128_BLOCK_SIZE) {
+        WRITE_WORD32(output, 0, LANE(lanes->row[0], lane));
+        WRITE_WORD32(output, 4, LANE(lanes->row[1], lane));
+        WRITE_WORD32(output, 8, LANE(lanes->row[2], lane));
+        WRITE_WORD32(output, 12, LANE(lanes->row[3], lane));
+    }
+}
+
+/* Expands the TK1 of every lane for one period of the TK1 schedule */
+STATIC_INLINE void forkskinny128_lanes_init_tk1
+    (ForkSkinny128LanesTK1_t *ks, const uint8_t *tk1, unsigned count)
+{
+    ForkSkinny128Lanes_t tk;
+    unsigned index;
+
+    forkskinny128_lanes_load(&tk, tk1, count);
+    for (index = 0; index < FORKSKINNY128_TK1_PERIOD; ++index) {
+        ks->schedule[index][0] = tk.row[0];
+        ks->schedule[index][1] = tk.row[1];
+        skinny128_lanes_permute_tk(&tk);
+    }
+}
+
+/* Gathers the key schedules of every lane for rounds [0, rounds);
+   ks3 is NULL for Forkskinny-128-256 */
+STATIC_INLINE void forkskinny128_lanes_init_keys
+    (ForkSkinny128LanesKey_t *ks, const ForkSkinny128Key_t *const *ks2,
+     const ForkSkinny128Key_t *const *ks3, unsigned count, unsigned rounds)
+{
+    unsigned index, lane;
+
+    memset(ks->schedule, 0, rounds * sizeof(ks->schedule[0]));
+    for (lane = 0; lane < count; ++lane) {
+        for (index = 0; index < rounds; ++index) {
+            LANE(ks->schedule[index][0], lane) = ks2[lane]->schedule[index].row[0];
+            LANE(ks->schedule[index][1], lane) = ks2[lane]->schedule[index].row[1];
+        }
+        if (ks3) {
+            for (index = 0; index < rounds; ++index) {
+                LANE(ks->schedule[index][0], lane) ^= ks3[lane]->schedule[index].row[0];
+                LANE(ks->schedule[index][1], lane) ^= ks3[lane]->schedule[index].row[1];
+            }
+        }
+    }
+}
+
+STATIC_INLINE void forkskinny128_lanes_add_branch_constant(ForkSkinny128Lanes_t *state)
+{
+    state->row[0] ^= 0x08040201U; /* Branching constant */
+    state->row[1] ^= 0x82412010U;
+    state->row[2] ^= 0x28140a05U;
+    state->row[3] ^= 0x8844a251U;
+}
+
+/* ks3 is NULL for Forkskinny-128-256; if keys is not NULL, it holds the
+   key of every lane and ks2 and ks3 are ignored */
+STATIC_INLINE void forkskinny128_lanes_encrypt_rounds
+    (ForkSkinny128Lanes_t *state, const ForkSkinny128LanesTK1_t *ks1,
+     const ForkSkinny128Key_t *ks2, const ForkSkinny128Key_t *ks3,
+     const ForkSkinny128LanesKey_t *keys, unsigned from, unsigned to)
+{
+    ForkSkinny128Lane_t row0, row1, row2, row3, temp;
+    uint32_t key0, key1;
+    unsigned index;
+
+    row0 = state->row[0];
+    row1 = state->row[1];
+    row2 = state->row[2];
+    row3 = state->row[3];
+    for (index = from; index < to; ++index) {
+        /* Apply the S-box to all bytes in the state */
+        row0 = skinny128_lanes_sbox(row0);
+        row1 = skinny128_lanes_sbox(row1);
+        row2 = skinny128_lanes_sbox(row2);
+        row3 = skinny128_lanes_sbox(row3);
+
+        /* Apply the subkey for this round */
+        if (keys) {
+            row0 ^= ks1->schedule[index % FORKSKINNY128_TK1_PERIOD][0] ^
+                    keys->schedule[index][0];
+            row1 ^= ks1->schedule[index % FORKSKINNY128_TK1_PERIOD][1] ^
+                    keys->schedule[index][1];
+        } else {
+            key0 = ks2->schedule[index].row[0];
+            key1 = ks2->schedule[index].row[1];
+            if (ks3) {
+                key0 ^= ks3->schedule[index].row[0];
+                key1 ^= ks3->schedule[index].row[1];
+            }
+            row0 ^= ks1->schedule[index % FORKSKINNY128_TK1_PERIOD][0] ^ key0;
+            row1 ^= ks1->schedule[index % FORKSKINNY128_TK1_PERIOD][1] ^ key1;
+        }
+        row2 ^= 0x02;
+
+        /* Shift the rows */
+        row1 = skinny128_lanes_rotate_right(row1, 8);
+        row2 = skinny128_lanes_rotate_right(row2, 16);
+        row3 = skinny128_lanes_rotate_right(row3, 24);
+
+        /* Mix the columns */
+        row1 ^= row2;
+        row2 ^= row0;
+        temp = row3 ^ row2;
+        row3 = row2;
+        row2 = row1;
+        row1 = row0;
+        row0 = temp;
+    }
+    state->row[0] = row0;
+    state->row[1] = row1;
+    state->row[2] = row2;
+    state->row[3] = row3;
+}
+
+/* ks3 is NULL for Forkskinny-128-256; if keys is not NULL, it holds the
+   key of every lane and ks2 and ks3 are ignored */
+STATIC_INLINE void forkskinny128_lanes_decrypt_rounds
+    (ForkSkinny128Lanes_t *state, const ForkSkinny128LanesTK1_t *ks1,
+     const ForkSkinny128Key_t *ks2, const ForkSkinny128Key_t *ks3,
+     const ForkSkinny128LanesKey_t *keys, unsigned from, unsigned to)
+{
+    ForkSkinny128Lane_t row0, row1, row2, row3, temp;
+    uint32_t key0, key1;
+    unsigned index;
+
+    row0 = state->row[0];
+    row1 = state->row[1];
+    row2 = state->row[2];
+    row3 = state->row[3];
+    for (index = from; index > to; --index) {
+        /* Inverse mix of the columns */
+        temp = row3;
+        row3 = row0;
+        row0 = row1;
+        row1 = row2;
+        row3 ^= temp;
+        row2 = temp ^ row0;
+        row1 ^= row2;
+
+        /* Inverse shift of the rows */
+        row1 = skinny128_lanes_rotate_right(row1, 24);
+        row2 = skinny128_lanes_rotate_right(row2, 16);
+        row3 = skinny128_lanes_rotate_right(row3, 8);
+
+        /* Apply the subkey for this round */
+        if (keys) {
+            row0 ^= ks1->schedule[(index - 1) % FORKSKINNY128_TK1_PERIOD][0] ^
+                    keys->schedule[index - 1][0];
+            row1 ^= ks1->schedule[(index - 1) % FORKSKINNY128_TK1_PERIOD][1] ^
+                    keys->schedule[index - 1][1];
+        } else {
+            key0 = ks2->schedule[index - 1].row[0];
+            key1 = ks2->schedule[index - 1].row[1];
+            if (ks3) {
+                key0 ^= ks3->schedule[index - 1].row[0];
+                key1 ^= ks3->schedule[index - 1].row[1];
+            }
+            row0 ^= ks1->schedule[(index - 1) % FORKSKINNY128_TK1_PERIOD][0] ^ key0;
+            row1 ^= ks1->schedule[(index - 1) % FORKSKINNY128_TK1_PERIOD][1] ^ key1;
+        }
+        row2 ^= 0x02;
+
+        /* Apply the inverse of the S-box to all bytes in the state */
+        row0 = skinny128_lanes_inv_sbox(row0);
+        row1 = skinny128_lanes_inv_sbox(row1);
+        row2 = skinny128_lanes_inv_sbox(row2);
+        row3 = skinny128_lanes_inv_sbox(row3);
+    }
+    state->row[0] = row0;
+    state->row[1] = row1;
+    state->row[2] = row2;
+    state->row[3] = row3;
+}
+
+/* If keys2 is not NULL, block i uses the key schedules keys2[i] and
+   keys3[i] instead of ks2 and ks3 */
+STATIC_INLINE void forkskinny128_parallel_encrypt
+    (const uint8_t *tk1, const ForkSkinny128Key_t *ks2,
+     const ForkSkinny128Key_t *ks3, const ForkSkinny128Key_t *const *keys2,
+     const ForkSkinny128Key_t *const *keys3, unsigned before, unsigned after,
+     uint8_t *output_left, uint8_t *output_right,
+     const uint8_t *input, size_t count)
+{
+    ForkSkinny128LanesTK1_t ks1;
+    ForkSkinny128LanesKey_t keys;
+    const ForkSkinny128LanesKey_t *ks = keys2 ? &keys : 0;
+    ForkSkinny128Lanes_t state, fstate;
+    unsigned lanes;
+    size_t offset;
+
+    while (count > 0) {
+        lanes = count < FORKSKINNY128_LANES ? (unsigned)count : FORKSKINNY128_LANES;
+        forkskinny128_lanes_init_tk1(&ks1, tk1, lanes);
+        if (keys2) {
+            forkskinny128_lanes_init_keys
+                (&keys, keys2, keys3, lanes,
+                 before + after * (output_left ? 2 : 1));
+            keys2 += lanes;
+            if (keys3)
+                keys3 += lanes;
+        }
+        forkskinny128_lanes_load(&state, input, lanes);
+
+        /* Run all of the rounds before the forking point */
+        forkskinny128_lanes_encrypt_rounds
+            (&state, &ks1, ks2, ks3, ks, 0, before);
+
+        offset = lanes * FORKSKINNY128_BLOCK_SIZE;
+        if (output_right) {
+            /* Generate the right output blocks */
+            fstate = state;
+            forkskinny128_lanes_encrypt_rounds
+                (&fstate, &ks1, ks2, ks3, ks, before, before + after);
+            forkskinny128_lanes_store(output_right, &fstate, lanes);
+            output_right += offset;
+        }
+        if (output_left) {
+            /* Generate the left output blocks */
+            forkskinny128_lanes_add_branch_constant(&state);
+            forkskinny128_lanes_encrypt_rounds
+                (&state, &ks1, ks2, ks3, ks, before + after, before + after * 2);
+            forkskinny128_lanes_store(output_left, &state, lanes);
+            output_left += offset;
+        }
+        tk1 += offset;
+        input += offset;
+        count -= lanes;
+    }
+}
+
+/* If keys2 is not NULL, block i uses the key schedules keys2[i] and
+   keys3[i] instead of ks2 and ks3 */
+STATIC_INLINE void forkskinny128_parallel_decrypt
+    (const uint8_t *tk1, const ForkSkinny128Key_t *ks2,
+     const ForkSkinny128Key_t *ks3, const ForkSkinny128Key_t *const *keys2,
+     const ForkSkinny128Key_t *const *keys3, unsigned before, unsigned after,
+     uint8_t *output_left, uint8_t *output_right,
+     const uint8_t *input_right, size_t count)
+{
+    ForkSkinny128LanesTK1_t ks1;
+    ForkSkinny128LanesKey_t keys;
+    const ForkSkinny128LanesKey_t *ks = keys2 ? &keys : 0;
+    ForkSkinny128Lanes_t state, fstate;
+    unsigned lanes;
+    size_t offset;
+
+    while (count > 0) {
+        lanes = count < FORKSKINNY128_LANES ? (unsigned)count : FORKSKINNY128_LANES;
+        forkskinny128_lanes_init_tk1(&ks1, tk1, lanes);
+        if (keys2) {
+            forkskinny128_lanes_init_keys
+                (&keys, keys2, keys3, lanes,
+                 before + after * (output_left ? 2 : 1));
+            keys2 += lanes;
+            if (keys3)
+                keys3 += lanes;
+        }
+        forkskinny128_lanes_load(&state, input_right, lanes);
+
+        /* Perform the "after" rounds on the input to get back
+         * to the forking point in the cipher */
+        forkskinny128_lanes_decrypt_rounds
+            (&state, &ks1, ks2, ks3, ks, before + after, before);
+
+        offset = lanes * FORKSKINNY128_BLOCK_SIZE;
+        if (output_left) {
+            /* Generate the left output blocks after another "after" rounds */
+            fstate = state;
+            forkskinny128_lanes_add_branch_constant(&fstate);
+            forkskinny128_lanes_encrypt_rounds
+                (&fstate, &ks1, ks2, ks3, ks, before + after, before + after * 2);
+            forkskinny128_lanes_store(output_left, &fstate, lanes);
+            output_left += offset;
+        }
+        if (output_right) {
+            /* Generate the right output blocks by going backward "before"
+             * rounds from the forking point */
+            forkskinny128_lanes_decrypt_rounds
+                (&state, &ks1, ks2, ks3, ks, before, 0);
+            forkskinny128_lanes_store(output_right, &state, lanes);
+            output_right += offset;
+        }
+        tk1 += offset;
+        input_right += offset;
+        count -= lanes;
+    }
+}
+
+void forkskinny_c_128_256_encrypt_parallel
+    (const uint8_t *tk1, const ForkSkinny128Key_t *ks2,
+     uint8_t *output_left, uint8_t *output_right,
+     const uint8_t *input, size_t count)
+{
+    FORKSKINNY_STATS_BATCH(FORKSKINNY_STATS_128_256, FORKSKINNY_STATS_ENCRYPT,
+                           FORKSKINNY_STATS_PARALLEL, output_left, output_right,
+                           count, FORKSKINNY128_LANES);
+    forkskinny128_parallel_encrypt
+        (tk1, ks2, 0, 0, 0, FORKSKINNY_128_256_ROUNDS_BEFORE,
+         FORKSKINNY_128_256_ROUNDS_AFTER, output_left, output_right,
+         input, count);
+}
+
+void forkskinny_c_128_256_decrypt_parallel
+    (const uint8_t *tk1, const ForkSkinny128Key_t *ks2,
+     uint8_t *output_left, uint8_t *output_right,
+     const uint8_t *input_right, size_t count)
+{
+    FORKSKINNY_STATS_BATCH(FORKSKINNY_STATS_128_256, FORKSKINNY_STATS_DECRYPT,
+                           FORKSKINNY_STATS_PARALLEL, output_left, output_right,
+                           count, FORKSKINNY128_LANES);
+    forkskinny128_parallel_decrypt
+        (tk1, ks2, 0, 0, 0, FORKSKINNY_128_256_ROUNDS_BEFORE,
+         FORKSKINNY_128_256_ROUNDS_AFTER, output_left, output_right,
+         input_right, count);
+}
+
+void forkskinny_c_128_384_encrypt_parallel
+    (const uint8_t *tk1, const ForkSkinny128Key_t *ks2,
+     const ForkSkinny128Key_t *ks3,
+     uint8_t *output_left, uint8_t *output_right,
+     const uint8_t *input, size_t count)
+{
+    FORKSKINNY_STATS_BATCH(FORKSKINNY_STATS_128_384, FORKSKINNY_STATS_ENCRYPT,
+                           FORKSKINNY_STATS_PARALLEL, output_left, output_right,
+                           count, FORKSKINNY128_LANES);
+    forkskinny128_parallel_encrypt
+        (tk1, ks2, ks3, 0, 0, FORKSKINNY_128_384_ROUNDS_BEFORE,
+         FORKSKINNY_128_384_ROUNDS_AFTER, output_left, output_right,
+         input, count);
+}
+
+void forkskinny_c_128_384_decrypt_parallel
+    (const uint8_t *tk1, const ForkSkinny128Key_t *ks2,
+     const ForkSkinny128Key_t *ks3,
+     uint8_t *output_left, uint8_t *output_right,
+     const uint8_t *input_right, size_t count)
+{
+    FORKSKINNY_STATS_BATCH(FORKSKINNY_STATS_128_384, FORKSKINNY_STATS_DECRYPT,
+                           FORKSKINNY_STATS_PARALLEL, output_left, output_right,
+                           count, FORKSKINNY128_LANES);
+    forkskinny128_parallel_decrypt
+        (tk1, ks2, ks3, 0, 0, FORKSKINNY_128_384_ROUNDS_BEFORE,
+         FORKSKINNY_128_384_ROUNDS_AFTER, output_left, output_right,
+         input_right, count);
+}
+
+int forkskinny_c_128_256_encrypt_reduced
+    (const uint8_t *tk1, const ForkSkinny128Key_t *ks2,
+     unsigned before, unsigned after,
+     uint8_t *output_left, uint8_t *output_right,
+     const uint8_t *input, size_t count)
+{
+    if (before > FORKSKINNY128_MAX_ROUNDS ||
+            after > (FORKSKINNY128_MAX_ROUNDS - before) / 2)
+        return -1;
+    FORKSKINNY_STATS_BATCH(FORKSKINNY_STATS_128_256, FORKSKINNY_STATS_ENCRYPT,
+                           FORKSKINNY_STATS_REDUCED, output_left, output_right,
+                           count, FORKSKINNY128_LANES);
+    forkskinny128_parallel_encrypt
+        (tk1, ks2, 0, 0, 0, before, after, output_left, output_right,
+         input, count);
+    return 0;
+}
+
+int forkskinny_c_128_256_decrypt_reduced
+    (const uint8_t *tk1, const ForkSkinny128Key_t *ks2,
+     unsigned before, unsigned after,
+     uint8_t *output_left, uint8_t *output_right,
+     const uint8_t *input_right, size_t count)
+{
+    if (before > FORKSKINNY128_MAX_ROUNDS ||
+            after > (FORKSKINNY128_MAX_ROUNDS - before) / 2)
+        return -1;
+    FORKSKINNY_STATS_BATCH(FORKSKINNY_STATS_128_256, FORKSKINNY_STATS_DECRYPT,
+                           FORKSKINNY_STATS_REDUCED, output_left, output_right,
+                           count, FORKSKINNY128_LANES);
+    forkskinny128_parallel_decrypt
+        (tk1, ks2, 0, 0, 0, before, after, output_left, output_right,
+         input_right, count);
+    return 0;
+}
+
+int forkskinny_c_128_384_encrypt_reduced
+    (const uint8_t *tk1, const ForkSkinny128Key_t *ks2,
+     const ForkSkinny128Key_t *ks3, unsigned before, unsigned after,
+     uint8_t *output_left, uint8_t *output_right,
+     const uint8_t *input, size_t count)
+{
+    if (before > FORKSKINNY128_MAX_ROUNDS ||
+            after > (FORKSKINNY128_MAX_ROUNDS - before) / 2)
+        return -1;
+    FORKSKINNY_STATS_BATCH(FORKSKINNY_STATS_128_384, FORKSKINNY_STATS_ENCRYPT,
+                           FORKSKINNY_STATS_REDUCED, output_left, output_right,
+                           count, FORKSKINNY128_LANES);
+    forkskinny128_parallel_encrypt
+        (tk1, ks2, ks3, 0, 0, before, after, output_left, output_right,
+         input, count);
+    return 0;
+}
+
+int forkskinny_c_128_384_decrypt_reduced
+    (const uint8_t *tk1, const ForkSkinny128Key_t *ks2,
+     const ForkSkinny128Key_t *ks3, unsigned before, unsigned after,
+     uint8_t *output_left, uint8_t *output_right,
+     const uint8_t *input_right, size_t count)
+{
+    if (before > FORKSKINNY128_MAX_ROUNDS ||
+            after > (FORKSKINNY128_MAX_ROUNDS - before) / 2)
+        return -1;
+    FORKSKINNY_STATS_BATCH(FORKSKINNY_STATS_128_384, FORKSKINNY_STATS_DECRYPT,
+                           FORKSKINNY_STATS_REDUCED, output_left, output_right,
+                           count, FORKSKINNY128_LANES);
+    forkskinny128_parallel_decrypt
+        (tk1, ks2, ks3, 0, 0, before, after, output_left, output_right,
+         input_right, count);
+    return 0;
+}
+
+void forkskinny_c_128_256_encrypt_multikey
+    (const uint8_t *tk1, const ForkSkinny128Key_t *const *ks2,
+     uint8_t *output_left, uint8_t *output_right,
+     const uint8_t *input, size_t count)
+{
+    FORKSKINNY_STATS_BATCH(FORKSKINNY_STATS_128_256, FORKSKINNY_STATS_ENCRYPT,
+                           FORKSKINNY_STATS_MULTIKEY, output_left, output_right,
+                           count, FORKSKINNY128_LANES);
+    forkskinny128_parallel_encrypt
+        (tk1, 0, 0, ks2, 0, FORKSKINNY_128_256_ROUNDS_BEFORE,
+         FORKSKINNY_128_256_ROUNDS_AFTER, output_left, output_right,
+         input, count);
+}
+
+void forkskinny_c_128_256_decrypt_multikey
+    (const uint8_t *tk1, const ForkSkinny128Key_t *const *ks2,
+     uint8_t *output_left, uint8_t *output_right,
+     const uint8_t *input_right, size_t count)
+{
+    FORKSKINNY_STATS_BATCH(FORKSKINNY_STATS_128_256, FORKSKINNY_STATS_DECRYPT,
+                           FORKSKINNY_STATS_MULTIKEY, output_left, output_right,
+                           count, FORKSKINNY128_LANES);
+    forkskinny128_parallel_decrypt
+        (tk1, 0, 0, ks2, 0, FORKSKINNY_128_256_ROUNDS_BEFORE,
+         FORKSKINNY_128_256_ROUNDS_AFTER, output_left, output_right,
+         input_right, count);
+}
+
+void forkskinny_c_128_384_encrypt_multikey
+    (const uint8_t *tk1, const ForkSkinny128Key_t *const *ks2,
+     const ForkSkinny128Key_t *const *ks3,
+     uint8_t *output_left, uint8_t *output_right,
+     const uint8_t *input, size_t count)
+{
+    FORKSKINNY_STATS_BATCH(FORKSKINNY_STATS_128_384, FORKSKINNY_STATS_ENCRYPT,
+                           FORKSKINNY_STATS_MULTIKEY, output_left, output_right,
+                           count, FORKSKINNY128_LANES);
+    forkskinny128_parallel_encrypt
+        (tk1, 0, 0, ks2, ks3, FORKSKINNY_128_384_ROUNDS_BEFORE,
+         FORKSKINNY_128_384_ROUNDS_AFTER, output_left, output_right,
+         input, count);
+}
+
+void forkskinny_c_128_384_decrypt_multikey
+    (const uint8_t *tk1, const ForkSkinny128Key_t *const *ks2,
+     const ForkSkinny128Key_t *const *ks3,
+     uint8_t *output_left, uint8_t *output_right,
+     const uint8_t *input_right, size_t count)
+{
+    FORKSKINNY_STATS_BATCH(FORKSKINNY_STATS_128_384, FORKSKINNY_STATS_DECRYPT,
+                           FORKSKINNY_STATS_MULTIKEY, output_left, output_right,
+                           count, FORKSKINNY128_LANES);
+    forkskinny128_parallel_decrypt
+        (tk1, 0, 0, ks2, ks3, FORKSKINNY_128_384_ROUNDS_BEFORE,
+         FORKSKINNY_128_384_ROUNDS_AFTER, output_left, output_right,
+         input_right, count);
+}
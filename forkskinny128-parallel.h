@@ -0,0 +1,161 @@
+#ifndef FORKSKINNY_C_FORKSKINNY128_PARALLEL_H
+#define FORKSKINNY_C_FORKSKINNY128_PARALLEL_H
+
+#include "forkskinny128-cipher.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * The functions below process several independent blocks with one call.
+ * Every block has its own TK1 (e.g. a nonce and block counter) while TK2
+ * and TK3 are shared. Blocks are processed in groups that fill the SIMD
+ * registers of the platform, and TK1 is expanded inside the kernel, so no
+ * forkskinny_c_*_init_tk1 call is needed per block.
+ *
+ * The TK1 schedule repeats every 16 rounds, so the kernels only expand
+ * FORKSKINNY128_TK1_PERIOD rounds of each TK1.
+ *
+ * The *_multikey variants take a separate key for every block, so blocks
+ * under different keys (e.g. of many connections with few blocks each) can
+ * fill the SIMD registers together. The key schedules of a group are
+ * gathered into the vector lanes before its rounds are run.
+ *
+ * The *_reduced variants run a chosen number of rounds before the forking
+ * point and in each leg, for cryptanalysis of reduced-round versions (see
+ * forkskinny-reduced.h for batch experiments).
+ *
+ * Output buffers may be identical to the input buffer (in-place operation)
+ * but must not otherwise overlap it.
+ */
+
+#define FORKSKINNY128_TK1_PERIOD 16
+
+/**
+ * Computes the forward direction of Forkskinny-128-256 for a batch of blocks.
+ * tk1:           pointer to count*FORKSKINNY128_BLOCK_SIZE bytes; the TK1 of each block
+ * ks2:           key schedule for TK2 (see forkskinny_c_128_256_init_tk2)
+ * output_left:   if NULL, the left legs are not computed, else pointer to count*FORKSKINNY128_BLOCK_SIZE bytes; will contain the left output legs of the forkcipher
+ * output_right:  if NULL, the right legs are not computed, else pointer to count*FORKSKINNY128_BLOCK_SIZE bytes; will contain the right output legs of the forkcipher
+ * input:         pointer to count*FORKSKINNY128_BLOCK_SIZE bytes; inputs to the forkcipher
+ * count:         the number of blocks
+ */
+void forkskinny_c_128_256_encrypt_parallel(const uint8_t *tk1, const ForkSkinny128Key_t *ks2, uint8_t *output_left, uint8_t *output_right, const uint8_t *input, size_t count);
+
+/**
+ * Computes the inverse direction of Forkskinny-128-256 for a batch of blocks.
+ * tk1:           pointer to count*FORKSKINNY128_BLOCK_SIZE bytes; the TK1 of each block
+ * ks2:           key schedule for TK2 (see forkskinny_c_128_256_init_tk2)
+ * output_left:   if NULL, the left legs are not computed, else pointer to count*FORKSKINNY128_BLOCK_SIZE bytes; will contain the left output legs of the forkcipher (i.e. mode 'o')
+ * output_right:  if NULL, the rounds before the forking point are not computed, else pointer to count*FORKSKINNY128_BLOCK_SIZE bytes; will contain the inverted inputs of the forkcipher (i.e. mode 'i')
+ * input_right:   pointer to count*FORKSKINNY128_BLOCK_SIZE bytes; inputs to the inverse forkcipher
+ * count:         the number of blocks
+ */
+void forkskinny_c_128_256_decrypt_parallel(const uint8_t *tk1, const ForkSkinny128Key_t *ks2, uint8_t *output_left, uint8_t *output_right, const uint8_t *input_right, size_t count);
+
+/**
+ * Computes the forward direction of Forkskinny-128-384 for a batch of blocks.
+ * tk1:           pointer to count*FORKSKINNY128_BLOCK_SIZE bytes; the TK1 of each block
+ * ks2:           key schedule for TK2 (see forkskinny_c_128_384_init_tk2)
+ * ks3:           key schedule for TK3 (see forkskinny_c_128_384_init_tk3)
+ * output_left:   if NULL, the left legs are not computed, else pointer to count*FORKSKINNY128_BLOCK_SIZE bytes; will contain the left output legs of the forkcipher
+ * output_right:  if NULL, the right legs are not computed, else pointer to count*FORKSKINNY128_BLOCK_SIZE bytes; will contain the right output legs of the forkcipher
+ * input:         pointer to count*FORKSKINNY128_BLOCK_SIZE bytes; inputs to the forkcipher
+ * count:         the number of blocks
+ */
+void forkskinny_c_128_384_encrypt_parallel(const uint8_t *tk1, const ForkSkinny128Key_t *ks2, const ForkSkinny128Key_t *ks3, uint8_t *output_left, uint8_t *output_right, const uint8_t *input, size_t count);
+
+/**
+ * Computes the inverse direction of Forkskinny-128-384 for a batch of blocks.
+ * tk1:           pointer to count*FORKSKINNY128_BLOCK_SIZE bytes; the TK1 of each block
+ * ks2:           key schedule for TK2 (see forkskinny_c_128_384_init_tk2)
+ * ks3:           key schedule for TK3 (see forkskinny_c_128_384_init_tk3)
+ * output_left:   if NULL, the left legs are not computed, else pointer to count*FORKSKINNY128_BLOCK_SIZE bytes; will contain the left output legs of the forkcipher (i.e. mode 'o')
+ * output_right:  if NULL, the rounds before the forking point are not computed, else pointer to count*FORKSKINNY128_BLOCK_SIZE bytes; will contain the inverted inputs of the forkcipher (i.e. mode 'i')
+ * input_right:   pointer to count*FORKSKINNY128_BLOCK_SIZE bytes; inputs to the inverse forkcipher
+ * count:         the number of blocks
+ */
+void forkskinny_c_128_384_decrypt_parallel(const uint8_t *tk1, const ForkSkinny128Key_t *ks2, const ForkSkinny128Key_t *ks3, uint8_t *output_left, uint8_t *output_right, const uint8_t *input_right, size_t count);
+
+/**
+ * Computes the forward direction of Forkskinny-128-256 for a batch of blocks
+ * with a key per block.
+ * tk1:           pointer to count*FORKSKINNY128_BLOCK_SIZE bytes; the TK1 of each block
+ * ks2:           pointer to count key schedules for TK2; the key of each block (see forkskinny_c_128_256_init_tk2)
+ * Other parameters as for forkskinny_c_128_256_encrypt_parallel.
+ */
+void forkskinny_c_128_256_encrypt_multikey(const uint8_t *tk1, const ForkSkinny128Key_t *const *ks2, uint8_t *output_left, uint8_t *output_right, const uint8_t *input, size_t count);
+
+/**
+ * Computes the inverse direction of Forkskinny-128-256 for a batch of blocks
+ * with a key per block.
+ * tk1:           pointer to count*FORKSKINNY128_BLOCK_SIZE bytes; the TK1 of each block
+ * ks2:           pointer to count key schedules for TK2; the key of each block (see forkskinny_c_128_256_init_tk2)
+ * Other parameters as for forkskinny_c_128_256_decrypt_parallel.
+ */
+void forkskinny_c_128_256_decrypt_multikey(const uint8_t *tk1, const ForkSkinny128Key_t *const *ks2, uint8_t *output_left, uint8_t *output_right, const uint8_t *input_right, size_t count);
+
+/**
+ * Computes the forward direction of Forkskinny-128-384 for a batch of blocks
+ * with a key per block.
+ * tk1:           pointer to count*FORKSKINNY128_BLOCK_SIZE bytes; the TK1 of each block
+ * ks2:           pointer to count key schedules for TK2; the key of each block (see forkskinny_c_128_384_init_tk2)
+ * ks3:           pointer to count key schedules for TK3; the key of each block (see forkskinny_c_128_384_init_tk3)
+ * Other parameters as for forkskinny_c_128_384_encrypt_parallel.
+ */
+void forkskinny_c_128_384_encrypt_multikey(const uint8_t *tk1, const ForkSkinny128Key_t *const *ks2, const ForkSkinny128Key_t *const *ks3, uint8_t *output_left, uint8_t *output_right, const uint8_t *input, size_t count);
+
+/**
+ * Computes the inverse direction of Forkskinny-128-384 for a batch of blocks
+ * with a key per block.
+ * tk1:           pointer to count*FORKSKINNY128_BLOCK_SIZE bytes; the TK1 of each block
+ * ks2:           pointer to count key schedules for TK2; the key of each block (see forkskinny_c_128_384_init_tk2)
+ * ks3:           pointer to count key schedules for TK3; the key of each block (see forkskinny_c_128_384_init_tk3)
+ * Other parameters as for forkskinny_c_128_384_decrypt_parallel.
+ */
+void forkskinny_c_128_384_decrypt_multikey(const uint8_t *tk1, const ForkSkinny128Key_t *const *ks2, const ForkSkinny128Key_t *const *ks3, uint8_t *output_left, uint8_t *output_right, const uint8_t *input_right, size_t count);
+
+/**
+ * Computes the forward direction of Forkskinny-128-256 reduced to a chosen
+ * number of rounds, for a batch of blocks. The rounds keep their positions
+ * in the tweakey schedule: rounds [0, before) before the forking point,
+ * [before, before + after) for the right leg and [before + after,
+ * before + 2*after) for the left leg; the full cipher has before =
+ * FORKSKINNY_128_256_ROUNDS_BEFORE and after = FORKSKINNY_128_256_ROUNDS_AFTER.
+ * before:        number of rounds before the forking point
+ * after:         number of rounds of each leg
+ * Other parameters as for forkskinny_c_128_256_encrypt_parallel; the key schedule must cover before + 2*after rounds.
+ * returns:       0 on success, -1 if before + 2*after exceeds FORKSKINNY128_MAX_ROUNDS
+ */
+int forkskinny_c_128_256_encrypt_reduced(const uint8_t *tk1, const ForkSkinny128Key_t *ks2, unsigned before, unsigned after, uint8_t *output_left, uint8_t *output_right, const uint8_t *input, size_t count);
+
+/**
+ * Computes the inverse direction of Forkskinny-128-256 reduced to a chosen
+ * number of rounds (see forkskinny_c_128_256_encrypt_reduced), for a batch
+ * of blocks.
+ * Parameters and return value as for forkskinny_c_128_256_decrypt_parallel and forkskinny_c_128_256_encrypt_reduced.
+ */
+int forkskinny_c_128_256_decrypt_reduced(const uint8_t *tk1, const ForkSkinny128Key_t *ks2, unsigned before, unsigned after, uint8_t *output_left, uint8_t *output_right, const uint8_t *input_right, size_t count);
+
+/**
+ * Computes the forward direction of Forkskinny-128-384 reduced to a chosen
+ * number of rounds (see forkskinny_c_128_256_encrypt_reduced), for a batch
+ * of blocks.
+ * Parameters and return value as for forkskinny_c_128_384_encrypt_parallel and forkskinny_c_128_256_encrypt_reduced.
+ */
+int forkskinny_c_128_384_encrypt_reduced(const uint8_t *tk1, const ForkSkinny128Key_t *ks2, const ForkSkinny128Key_t *ks3, unsigned before, unsigned after, uint8_t *output_left, uint8_t *output_right, const uint8_t *input, size_t count);
+
+/**
+ * Computes the inverse direction of Forkskinny-128-384 reduced to a chosen
+ * number of rounds (see forkskinny_c_128_256_encrypt_reduced), for a batch
+ * of blocks.
+ * Parameters and return value as for forkskinny_c_128_384_decrypt_parallel and forkskinny_c_128_256_encrypt_reduced.
+ */
+int forkskinny_c_128_384_decrypt_reduced(const uint8_t *tk1, const ForkSkinny128Key_t *ks2, const ForkSkinny128Key_t *ks3, unsigned before, unsigned after, uint8_t *output_left, uint8_t *output_right, const uint8_t *input_right, size_t count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // FORKSKINNY_C_FORKSKINNY128_PARALLEL_H
@@ -68,6 +68,8 @@ void forkskinny_c_64_192_init_tk1(ForkSkinny64Key_t *ks, const uint8_t *key, uns
     ForkSkinny64Cells_t tk;
     unsigned index;
 
+    FORKSKINNY_STATS_INIT(FORKSKINNY_STATS_64_192, FORKSKINNY_STATS_TK1);
+
     /* Unpack the key and convert from little-endian to host-endian */
     #if SKINNY_64BIT && SKINNY_LITTLE_ENDIAN
       tk.llrow = READ_WORD64(key, 0);
@@ -97,6 +99,9 @@ void forkskinny_c_64_192_init_tk2_tk3
     ForkSkinny64Cells_t tk2, tk3;
     unsigned index;
 
+    FORKSKINNY_STATS_INIT(FORKSKINNY_STATS_64_192, FORKSKINNY_STATS_TK2);
+    FORKSKINNY_STATS_INIT(FORKSKINNY_STATS_64_192, FORKSKINNY_STATS_TK3);
+
     /* Unpack the key and convert from little-endian to host-endian */
     #if SKINNY_64BIT && SKINNY_LITTLE_ENDIAN
       tk2.llrow = READ_WORD64(key, 0);
@@ -306,6 +311,13 @@ void forkskinny_c_64_192_encrypt
 {
     ForkSkinny64Cells_t state;
 
+    /* Nothing to compute */
+    if (!output_left && !output_right)
+        return;
+
+    FORKSKINNY_STATS_BATCH(FORKSKINNY_STATS_64_192, FORKSKINNY_STATS_ENCRYPT,
+                           FORKSKINNY_STATS_SCALAR, output_left, output_right, 1, 1);
+
     /* Read the input buffer and convert little-endian to host-endian */
     #if SKINNY_64BIT && SKINNY_LITTLE_ENDIAN
       state.llrow = READ_WORD64(input_right, 0);
@@ -443,6 +455,13 @@ void forkskinny_c_64_192_decrypt
 {
     ForkSkinny64Cells_t state;
 
+    /* Nothing to compute */
+    if (!output_left && !output_right)
+        return;
+
+    FORKSKINNY_STATS_BATCH(FORKSKINNY_STATS_64_192, FORKSKINNY_STATS_DECRYPT,
+                           FORKSKINNY_STATS_SCALAR, output_left, output_right, 1, 1);
+
     /* Read the input buffer and convert little-endian to host-endian */
     #if SKINNY_64BIT && SKINNY_LITTLE_ENDIAN
         state.llrow = READ_WORD64(input_right, 0);
@@ -494,20 +513,22 @@ void forkskinny_c_64_192_decrypt
     }
 
 
-    /* Generate the right output block by going backward "before"
-     * rounds from the forking point */
-    state = forkskinny64_decrypt_rounds
-        (state, tks1, tks2, FORKSKINNY_64_192_ROUNDS_BEFORE, 0);
-    /* Convert host-endian back into little-endian in the output buffer */
-    #if SKINNY_64BIT && SKINNY_LITTLE_ENDIAN
-      WRITE_WORD64(output_right, 0, state.llrow);
-    #elif SKINNY_LITTLE_ENDIAN
-      WRITE_WORD32(output_right, 0, state.lrow[0]);
-      WRITE_WORD32(output_right, 4, state.lrow[1]);
-    #else
-      WRITE_WORD16(output_right, 0, state.row[0]);
-      WRITE_WORD16(output_right, 2, state.row[1]);
-      WRITE_WORD16(output_right, 4, state.row[2]);
-      WRITE_WORD16(output_right, 6, state.row[3]);
-    #endif
+    if (output_right) {
+        /* Generate the right output block by going backward "before"
+         * rounds from the forking point */
+        state = forkskinny64_decrypt_rounds
+            (state, tks1, tks2, FORKSKINNY_64_192_ROUNDS_BEFORE, 0);
+        /* Convert host-endian back into little-endian in the output buffer */
+        #if SKINNY_64BIT && SKINNY_LITTLE_ENDIAN
+          WRITE_WORD64(output_right, 0, state.llrow);
+        #elif SKINNY_LITTLE_ENDIAN
+          WRITE_WORD32(output_right, 0, state.lrow[0]);
+          WRITE_WORD32(output_right, 4, state.lrow[1]);
+        #else
+          WRITE_WORD16(output_right, 0, state.row[0]);
+          WRITE_WORD16(output_right, 2, state.row[1]);
+          WRITE_WORD16(output_right, 4, state.row[2]);
+          WRITE_WORD16(output_right, 6, state.row[3]);
+        #endif
+    }
 }
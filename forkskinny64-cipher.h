@@ -64,10 +64,11 @@ void forkskinny_c_64_192_init_tk2_tk3(ForkSkinny64Key_t *ks, const uint8_t *key,
 
 /**
  * Computes the forward direction of Forkskinny-64-192.
+ * Nothing is computed if both outputs are NULL.
  * tks1:           key schedule for TK1 (see forkskinny_c_64_192_init_tk1)
  * tks2:           key schedule for TK2 and TK3 (see forkskinny_c_64_192_init_tk2_tk3)
  * output_left:   if NULL, the left leg is not computed, else pointer to FORKSKINNY64_BLOCK_SIZE byte; will contain the left output leg of the forkcipher
- * output_right:  pointer to FORKSKINNY64_BLOCK_SIZE byte; will contain the right output leg of the forkcipher
+ * output_right:  if NULL, the right leg is not computed, else pointer to FORKSKINNY64_BLOCK_SIZE byte; will contain the right output leg of the forkcipher
  * input:         pointer to FORKSKINNY64_BLOCK_SIZE byte; input to the forkcipher
  */
 void forkskinny_c_64_192_encrypt(const ForkSkinny64Key_t *tks1, const ForkSkinny64Key_t *tks2,
@@ -75,10 +76,11 @@ void forkskinny_c_64_192_encrypt(const ForkSkinny64Key_t *tks1, const ForkSkinny
 
 /**
  * Computes the inverse direction of Forkskinny-64-192.
+ * Nothing is computed if both outputs are NULL.
  * tks1:           key schedule for TK1 (see forkskinny_c_64_192_init_tk1)
  * tks2:           key schedule for TK2 and TK3 (see forkskinny_c_64_192_init_tk2_tk3)
  * output_left:   if NULL, the left leg is not computed, else pointer to FORKSKINNY64_BLOCK_SIZE byte; will contain the left output leg of the forkcipher (i.e. mode 'o')
- * output_right:  pointer to FORKSKINNY64_BLOCK_SIZE byte; will contain the inverted input of the forkcipher (i.e. mode 'i')
+ * output_right:  if NULL, the rounds before the forking point are not computed, else pointer to FORKSKINNY64_BLOCK_SIZE byte; will contain the inverted input of the forkcipher (i.e. mode 'i')
  * input_right:   pointer to FORKSKINNY64_BLOCK_SIZE byte; input to the inverse forkcipher
  */
 void forkskinny_c_64_192_decrypt(const ForkSkinny64Key_t *tks1, const ForkSkinny64Key_t *tks2,
@@ -0,0 +1,376 @@
+#include "forkskinny64-parallel.h"
+#include "forkskinny-internal.h"
+
+/* Each lane of a vector holds the same 16-bit row of a different block.
+   Without vector support we fall back to a single lane per group. */
+#if SKINNY_VEC256_MATH
+#define FORKSKINNY64_LANES 16
+typedef uint16_t ForkSkinny64Lane_t SKINNY_VECTOR_ATTR(16, 32);
+#elif SKINNY_VEC128_MATH
+#define FORKSKINNY64_LANES 8
+typedef uint16_t ForkSkinny64Lane_t SKINNY_VECTOR_ATTR(8, 16);
+#else
+#define FORKSKINNY64_LANES 1
+typedef uint16_t ForkSkinny64Lane_t;
+#endif
+
+#if FORKSKINNY64_LANES > 1
+#define LANE(vec, lane) ((vec)[(lane)])
+#else
+#define LANE(vec, lane) (vec)
+#endif
+
+/**
+ * Rows of FORKSKINNY64_LANES states (or tweakeys), transposed so that
+ * every row holds one 16-bit row of each block.
+ */
+typedef struct
+{
+    ForkSkinny64Lane_t row[4];
+
+} ForkSkinny64Lanes_t;
+
+/**
+ * The first two rows of TK1 for FORKSKINNY64_TK1_PERIOD consecutive rounds.
+ */
+typedef struct
+{
+    ForkSkinny64Lane_t schedule[FORKSKINNY64_TK1_PERIOD][2];
+
+} ForkSkinny64LanesTK1_t;
+
+STATIC_INLINE ForkSkinny64Lane_t skinny64_lanes_rotate_right
+    (ForkSkinny64Lane_t x, unsigned count)
+{
+    return (x >> count) | (x << (16 - count));
+}
+
+STATIC_INLINE ForkSkinny64Lane_t skinny64_lanes_sbox(ForkSkinny64Lane_t x)
+{
+    /* Same bit-sliced S-box as the 32-bit version of skinny64_sbox() */
+    x = ~x;
+    x = (((x >> 3) & (x >> 2)) & 0x1111U) ^ x;
+    x = (((x << 1) & (x << 2)) & 0x8888U) ^ x;
+    x = (((x << 1) & (x << 2)) & 0x4444U) ^ x;
+    x = (((x >> 2) & (x << 1)) & 0x2222U) ^ x;
+    x = ~x;
+    return ((x >> 1) & 0x7777U) | ((x << 3) & 0x8888U);
+}
+
+STATIC_INLINE ForkSkinny64Lane_t skinny64_lanes_inv_sbox(ForkSkinny64Lane_t x)
+{
+    /* Same bit-sliced S-box as the 32-bit version of skinny64_inv_sbox() */
+    x = ~x;
+    x = (((x >> 3) & (x >> 2)) & 0x1111U) ^ x;
+    x = (((x << 1) & (x >> 2)) & 0x2222U) ^ x;
+    x = (((x << 1) & (x << 2)) & 0x4444U) ^ x;
+    x = (((x << 1) & (x << 2)) & 0x8888U) ^ x;
+    x = ~x;
+    return ((x << 1) & 0xEEEEU) | ((x >> 3) & 0x1111U);
+}
+
+STATIC_INLINE void skinny64_lanes_permute_tk(ForkSkinny64Lanes_t *tk)
+{
+    /* PT = [9, 15, 8, 13, 10, 14, 12, 11, 0, 1, 2, 3, 4, 5, 6, 7] */
+    ForkSkinny64Lane_t row2 = tk->row[2];
+    ForkSkinny64Lane_t row3 = tk->row[3];
+    tk->row[2] = tk->row[0];
+    tk->row[3] = tk->row[1];
+    row3 = (row3 << 8) | (row3 >> 8);
+    tk->row[0] = ((row2 << 4) & 0x00F0U) |
+                 ((row2 << 8) & 0xF000U) |
+                  (row3       & 0x0F0FU);
+    tk->row[1] = ((row2 >> 8) & 0x00F0U) |
+                  (row2       & 0x0F00U) |
+                 ((row3 >> 4) & 0x000FU) |
+                 ( row3       & 0xF000U);
+}
+
+/* Reads count blocks into the lanes; the unused lanes are set to zero */
+STATIC_INLINE void forkskinny64_lanes_load
+    (ForkSkinny64Lanes_t *lanes, const uint8_t *input, unsigned count)
+{
+    unsigned lane;
+    memset(lanes, 0, sizeof(ForkSkinny64Lanes_t));
+    for (lane = 0; lane < count; ++lane, input += FORKSKINNY64_BLOCK_SIZE) {
+        LANE(lanes->row[0], lane) = READ_WORD16(input, 0);
+        LANE(lanes->row[1], lane) = READ_WORD16(input, 2);
+        LANE(lanes->row[2], lane) = READ_WORD16(input, 4);
+        LANE(lanes->row[3], lane) = READ_WORD16(input, 6);
+    }
+}
+
+/* Writes the first count lanes back into little-endian blocks */
+STATIC_INLINE void forkskinny64_lanes_store
+    (uint8_t *output, const ForkSkinny64Lanes_t *lanes, unsigned count)
+{
+    unsigned lane;
+    for (lane = 0; lane < count; ++lane, output += FORKSKINNY64_BLOCK_SIZE) {
+        WRITE_WORD16(output, 0, LANE(lanes->row[0], lane));
+        WRITE_WORD16(output, 2, LANE(lanes->row[1], lane));
+        WRITE_WORD16(output, 4, LANE(lanes->row[2], lane));
+        WRITE_WORD16(output, 6, LANE(lanes->row[3], lane));
+    }
+}
+
+/* Expands the TK1 of every lane for one period of the TK1 schedule */
+STATIC_INLINE void forkskinny64_lanes_init_tk1
+    (ForkSkinny64LanesTK1_t *ks, const uint8_t *tk1, unsigned count)
+{
+    ForkSkinny64Lanes_t tk;
+    unsigned index;
+
+    forkskinny64_lanes_load(&tk, tk1, count);
+    for (index = 0; index < FORKSKINNY64_TK1_PERIOD; ++index) {
+        ks->schedule[index][0] = tk.row[0];
+        ks->schedule[index][1] = tk.row[1];
+        skinny64_lanes_permute_tk(&tk);
+    }
+}
+
+STATIC_INLINE void forkskinny64_lanes_add_branch_constant(ForkSkinny64Lanes_t *state)
+{
+    state->row[0] ^= 0x4912U; /* Branching constant */
+    state->row[1] ^= 0xda36U;
+    state->row[2] ^= 0x7f5bU;
+    state->row[3] ^= 0x81ecU;
+}
+
+STATIC_INLINE void forkskinny64_lanes_encrypt_rounds
+    (ForkSkinny64Lanes_t *state, const ForkSkinny64LanesTK1_t *ks1,
+     const ForkSkinny64Key_t *ks23, unsigned from, unsigned to)
+{
+    ForkSkinny64Lane_t row0, row1, row2, row3, temp;
+    unsigned index;
+
+    row0 = state->row[0];
+    row1 = state->row[1];
+    row2 = state->row[2];
+    row3 = state->row[3];
+    for (index = from; index < to; ++index) {
+        /* Apply the S-box to all cells in the state */
+        row0 = skinny64_lanes_sbox(row0);
+        row1 = skinny64_lanes_sbox(row1);
+        row2 = skinny64_lanes_sbox(row2);
+        row3 = skinny64_lanes_sbox(row3);
+
+        /* Apply the subkey for this round */
+        row0 ^= ks1->schedule[index % FORKSKINNY64_TK1_PERIOD][0] ^
+                ks23->schedule[index].row[0];
+        row1 ^= ks1->schedule[index % FORKSKINNY64_TK1_PERIOD][1] ^
+                ks23->schedule[index].row[1];
+        row2 ^= 0x20;
+
+        /* Shift the rows */
+        row1 = skinny64_lanes_rotate_right(row1, 4);
+        row2 = skinny64_lanes_rotate_right(row2, 8);
+        row3 = skinny64_lanes_rotate_right(row3, 12);
+
+        /* Mix the columns */
+        row1 ^= row2;
+        row2 ^= row0;
+        temp = row3 ^ row2;
+        row3 = row2;
+        row2 = row1;
+        row1 = row0;
+        row0 = temp;
+    }
+    state->row[0] = row0;
+    state->row[1] = row1;
+    state->row[2] = row2;
+    state->row[3] = row3;
+}
+
+STATIC_INLINE void forkskinny64_lanes_decrypt_rounds
+    (ForkSkinny64Lanes_t *state, const ForkSkinny64LanesTK1_t *ks1,
+     const ForkSkinny64Key_t *ks23, unsigned from, unsigned to)
+{
+    ForkSkinny64Lane_t row0, row1, row2, row3, temp;
+    unsigned index;
+
+    row0 = state->row[0];
+    row1 = state->row[1];
+    row2 = state->row[2];
+    row3 = state->row[3];
+    for (index = from; index > to; --index) {
+        /* Inverse mix of the columns */
+        temp = row3;
+        row3 = row0;
+        row0 = row1;
+        row1 = row2;
+        row3 ^= temp;
+        row2 = temp ^ row0;
+        row1 ^= row2;
+
+        /* Inverse shift of the rows */
+        row1 = skinny64_lanes_rotate_right(row1, 12);
+        row2 = skinny64_lanes_rotate_right(row2, 8);
+        row3 = skinny64_lanes_rotate_right(row3, 4);
+
+        /* Apply the subkey for this round */
+        row0 ^= ks1->schedule[(index - 1) % FORKSKINNY64_TK1_PERIOD][0] ^
+                ks23->schedule[index - 1].row[0];
+        row1 ^= ks1->schedule[(index - 1) % FORKSKINNY64_TK1_PERIOD][1] ^
+                ks23->schedule[index - 1].row[1];
+        row2 ^= 0x20;
+
+        /* Apply the inverse of the S-box to all cells in the state */
+        row0 = skinny64_lanes_inv_sbox(row0);
+        row1 = skinny64_lanes_inv_sbox(row1);
+        row2 = skinny64_lanes_inv_sbox(row2);
+        row3 = skinny64_lanes_inv_sbox(row3);
+    }
+    state->row[0] = row0;
+    state->row[1] = row1;
+    state->row[2] = row2;
+    state->row[3] = row3;
+}
+
+STATIC_INLINE void forkskinny64_parallel_encrypt
+    (const uint8_t *tk1, const ForkSkinny64Key_t *tks2, unsigned before,
+     unsigned after, uint8_t *output_left, uint8_t *output_right,
+     const uint8_t *input, size_t count)
+{
+    ForkSkinny64LanesTK1_t ks1;
+    ForkSkinny64Lanes_t state, fstate;
+    unsigned lanes;
+    size_t offset;
+
+    while (count > 0) {
+        lanes = count < FORKSKINNY64_LANES ? (unsigned)count : FORKSKINNY64_LANES;
+        forkskinny64_lanes_init_tk1(&ks1, tk1, lanes);
+        forkskinny64_lanes_load(&state, input, lanes);
+
+        /* Run all of the rounds before the forking point */
+        forkskinny64_lanes_encrypt_rounds
+            (&state, &ks1, tks2, 0, before);
+
+        offset = lanes * FORKSKINNY64_BLOCK_SIZE;
+        if (output_right) {
+            /* Generate the right output blocks */
+            fstate = state;
+            forkskinny64_lanes_encrypt_rounds
+                (&fstate, &ks1, tks2, before, before + after);
+            forkskinny64_lanes_store(output_right, &fstate, lanes);
+            output_right += offset;
+        }
+        if (output_left) {
+            /* Generate the left output blocks */
+            forkskinny64_lanes_add_branch_constant(&state);
+            forkskinny64_lanes_encrypt_rounds
+                (&state, &ks1, tks2, before + after, before + after * 2);
+            forkskinny64_lanes_store(output_left, &state, lanes);
+            output_left += offset;
+        }
+        tk1 += offset;
+        input += offset;
+        count -= lanes;
+    }
+}
+
+STATIC_INLINE void forkskinny64_parallel_decrypt
+    (const uint8_t *tk1, const ForkSkinny64Key_t *tks2, unsigned before,
+     unsigned after, uint8_t *output_left, uint8_t *output_right,
+     const uint8_t *input_right, size_t count)
+{
+    ForkSkinny64LanesTK1_t ks1;
+    ForkSkinny64Lanes_t state, fstate;
+    unsigned lanes;
+    size_t offset;
+
+    while (count > 0) {
+        lanes = count < FORKSKINNY64_LANES ? (unsigned)count : FORKSKINNY64_LANES;
+        forkskinny64_lanes_init_tk1(&ks1, tk1, lanes);
+        forkskinny64_lanes_load(&state, input_right, lanes);
+
+        /* Perform the "after" rounds on the input to get back
+         * to the forking point in the cipher */
+        forkskinny64_lanes_decrypt_rounds
+            (&state, &ks1, tks2, before + after, before);
+
+        offset = lanes * FORKSKINNY64_BLOCK_SIZE;
+        if (output_left) {
+            /* Generate the left output blocks after another "after" rounds */
+            fstate = state;
+            forkskinny64_lanes_add_branch_constant(&fstate);
+            forkskinny64_lanes_encrypt_rounds
+                (&fstate, &ks1, tks2, before + after, before + after * 2);
+            forkskinny64_lanes_store(output_left, &fstate, lanes);
+            output_left += offset;
+        }
+        if (output_right) {
+            /* Generate the right output blocks by going backward "before"
+             * rounds from the forking point */
+            forkskinny64_lanes_decrypt_rounds
+                (&state, &ks1, tks2, before, 0);
+            forkskinny64_lanes_store(output_right, &state, lanes);
+            output_right += offset;
+        }
+        tk1 += offset;
+        input_right += offset;
+        count -= lanes;
+    }
+}
+
+void forkskinny_c_64_192_encrypt_parallel
+    (const uint8_t *tk1, const ForkSkinny64Key_t *tks2,
+     uint8_t *output_left, uint8_t *output_right,
+     const uint8_t *input, size_t count)
+{
+    FORKSKINNY_STATS_BATCH(FORKSKINNY_STATS_64_192, FORKSKINNY_STATS_ENCRYPT,
+                           FORKSKINNY_STATS_PARALLEL, output_left, output_right,
+                           count, FORKSKINNY64_LANES);
+    forkskinny64_parallel_encrypt
+        (tk1, tks2, FORKSKINNY_64_192_ROUNDS_BEFORE,
+         FORKSKINNY_64_192_ROUNDS_AFTER, output_left, output_right,
+         input, count);
+}
+
+void forkskinny_c_64_192_decrypt_parallel
+    (const uint8_t *tk1, const ForkSkinny64Key_t *tks2,
+     uint8_t *output_left, uint8_t *output_right,
+     const uint8_t *input_right, size_t count)
+{
+    FORKSKINNY_STATS_BATCH(FORKSKINNY_STATS_64_192, FORKSKINNY_STATS_DECRYPT,
+                           FORKSKINNY_STATS_PARALLEL, output_left, output_right,
+                           count, FORKSKINNY64_LANES);
+    forkskinny64_parallel_decrypt
+        (tk1, tks2, FORKSKINNY_64_192_ROUNDS_BEFORE,
+         FORKSKINNY_64_192_ROUNDS_AFTER, output_left, output_right,
+         input_right, count);
+}
+
+int forkskinny_c_64_192_encrypt_reduced
+    (const uint8_t *tk1, const ForkSkinny64Key_t *tks2,
+     unsigned before, unsigned after,
+     uint8_t *output_left, uint8_t *output_right,
+     const uint8_t *input, size_t count)
+{
+    if (before > FORKSKINNY64_MAX_ROUNDS ||
+            after > (FORKSKINNY64_MAX_ROUNDS - before) / 2)
+        return -1;
+    FORKSKINNY_STATS_BATCH(FORKSKINNY_STATS_64_192, FORKSKINNY_STATS_ENCRYPT,
+                           FORKSKINNY_STATS_REDUCED, output_left, output_right,
+                           count, FORKSKINNY64_LANES);
+    forkskinny64_parallel_encrypt
+        (tk1, tks2, before, after, output_left, output_right, input, count);
+    return 0;
+}
+
+int forkskinny_c_64_192_decrypt_reduced
+    (const uint8_t *tk1, const ForkSkinny64Key_t *tks2,
+     unsigned before, unsigned after,
+     uint8_t *output_left, uint8_t *output_right,
+     const uint8_t *input_right, size_t count)
+{
+    if (before > FORKSKINNY64_MAX_ROUNDS ||
+            after > (FORKSKINNY64_MAX_ROUNDS - before) / 2)
+        return -1;
+    FORKSKINNY_STATS_BATCH(FORKSKINNY_STATS_64_192, FORKSKINNY_STATS_DECRYPT,
+                           FORKSKINNY_STATS_REDUCED, output_left, output_right,
+                           count, FORKSKINNY64_LANES);
+    forkskinny64_parallel_decrypt
+        (tk1, tks2, before, after, output_left, output_right,
+         input_right, count);
+    return 0;
+}
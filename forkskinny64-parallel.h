@@ -0,0 +1,66 @@
+#ifndef FORKSKINNY_C_FORKSKINNY64_PARALLEL_H
+#define FORKSKINNY_C_FORKSKINNY64_PARALLEL_H
+
+#include "forkskinny64-cipher.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * The functions below process several independent blocks with one call,
+ * every block with its own TK1 and a shared TK2/TK3 schedule, and their
+ * *_reduced variants. See forkskinny128-parallel.h for the details.
+ */
+
+#define FORKSKINNY64_TK1_PERIOD 16
+
+/**
+ * Computes the forward direction of Forkskinny-64-192 for a batch of blocks.
+ * tk1:           pointer to count*FORKSKINNY64_BLOCK_SIZE bytes; the TK1 of each block
+ * tks2:          key schedule for TK2 and TK3 (see forkskinny_c_64_192_init_tk2_tk3)
+ * output_left:   if NULL, the left legs are not computed, else pointer to count*FORKSKINNY64_BLOCK_SIZE bytes; will contain the left output legs of the forkcipher
+ * output_right:  if NULL, the right legs are not computed, else pointer to count*FORKSKINNY64_BLOCK_SIZE bytes; will contain the right output legs of the forkcipher
+ * input:         pointer to count*FORKSKINNY64_BLOCK_SIZE bytes; inputs to the forkcipher
+ * count:         the number of blocks
+ */
+void forkskinny_c_64_192_encrypt_parallel(const uint8_t *tk1, const ForkSkinny64Key_t *tks2,
+  uint8_t *output_left, uint8_t *output_right, const uint8_t *input, size_t count);
+
+/**
+ * Computes the inverse direction of Forkskinny-64-192 for a batch of blocks.
+ * tk1:           pointer to count*FORKSKINNY64_BLOCK_SIZE bytes; the TK1 of each block
+ * tks2:          key schedule for TK2 and TK3 (see forkskinny_c_64_192_init_tk2_tk3)
+ * output_left:   if NULL, the left legs are not computed, else pointer to count*FORKSKINNY64_BLOCK_SIZE bytes; will contain the left output legs of the forkcipher (i.e. mode 'o')
+ * output_right:  if NULL, the rounds before the forking point are not computed, else pointer to count*FORKSKINNY64_BLOCK_SIZE bytes; will contain the inverted inputs of the forkcipher (i.e. mode 'i')
+ * input_right:   pointer to count*FORKSKINNY64_BLOCK_SIZE bytes; inputs to the inverse forkcipher
+ * count:         the number of blocks
+ */
+void forkskinny_c_64_192_decrypt_parallel(const uint8_t *tk1, const ForkSkinny64Key_t *tks2,
+  uint8_t *output_left, uint8_t *output_right, const uint8_t *input_right, size_t count);
+
+/**
+ * Computes the forward direction of Forkskinny-64-192 reduced to a chosen
+ * number of rounds, for a batch of blocks (see
+ * forkskinny_c_128_256_encrypt_reduced in forkskinny128-parallel.h).
+ * before:        number of rounds before the forking point
+ * after:         number of rounds of each leg
+ * Other parameters as for forkskinny_c_64_192_encrypt_parallel; the key schedule must cover before + 2*after rounds.
+ * returns:       0 on success, -1 if before + 2*after exceeds FORKSKINNY64_MAX_ROUNDS
+ */
+int forkskinny_c_64_192_encrypt_reduced(const uint8_t *tk1, const ForkSkinny64Key_t *tks2, unsigned before, unsigned after,
+  uint8_t *output_left, uint8_t *output_right, const uint8_t *input, size_t count);
+
+/**
+ * Computes the inverse direction of Forkskinny-64-192 reduced to a chosen
+ * number of rounds, for a batch of blocks.
+ * Parameters and return value as for forkskinny_c_64_192_decrypt_parallel and forkskinny_c_64_192_encrypt_reduced.
+ */
+int forkskinny_c_64_192_decrypt_reduced(const uint8_t *tk1, const ForkSkinny64Key_t *tks2, unsigned before, unsigned after,
+  uint8_t *output_left, uint8_t *output_right, const uint8_t *input_right, size_t count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // FORKSKINNY_C_FORKSKINNY64_PARALLEL_H
@@ -0,0 +1,700 @@
+/*
+ * Per-call latency and hardware counter profiles of the public functions.
+ *
+ *   profile.x [-o text|csv] [-n calls] [-w warmup] [-l len] [-b blocks]
+ *             [-c] [-H] [-m match]
+ *
+ * Every public key schedule, forkcipher and mode function is called on
+ * its own many times (default 10000, after 100 warm-up calls), and each
+ * call is measured separately: its latency, and with perf_event_open the
+ * cycles, instructions, cache misses and branch misses it spent in user
+ * space. For each function the percentiles p50, p99 and p99.9 and the
+ * maximum of every measurement are reported, so the tail that averages
+ * hide, e.g. from cold key schedules or frequency transitions, is visible.
+ *
+ * The modes process messages of len bytes (default 1024, a multiple of
+ * 16) and the parallel kernels batches of the given number of blocks
+ * (default 64). With -c the caches are flushed before every call by
+ * writing a large buffer, to profile cold calls. With -H a histogram of
+ * the latencies in powers of two follows each function. -m keeps only the
+ * functions whose name contains the given string (and "(empty)").
+ *
+ * The first row, "(empty)", calls a function that does nothing: it shows
+ * what the measurement itself adds to every call. Counters that cannot be
+ * opened (e.g. without a PMU in a virtual machine, or with
+ * kernel.perf_event_paranoid above 2) are left empty.
+ */
+
+#define _GNU_SOURCE
+#include "forkskinny64-parallel.h"
+#include "forkskinny128-parallel.h"
+#include "forkae-paef.h"
+#include "forkae-saef.h"
+#include "forkae-ctr.h"
+#include "forkae-sector.h"
+#include "forkae-pmac.h"
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#define PROFILE_DEFAULT_CALLS 10000
+#define PROFILE_DEFAULT_WARMUP 100
+#define PROFILE_DEFAULT_LENGTH 1024
+#define PROFILE_DEFAULT_BLOCKS 64
+#define PROFILE_MAX_LENGTH (1 << 24)
+#define PROFILE_MAX_BLOCKS 4096
+
+/* Size of the buffer written to flush the caches */
+#define PROFILE_FLUSH_SIZE (64 << 20)
+
+/* Measurements of a call: latency, then the hardware counters */
+#define PROFILE_NS              0
+#define PROFILE_CYCLES          1
+#define PROFILE_INSTRUCTIONS    2
+#define PROFILE_CACHE_MISSES    3
+#define PROFILE_BRANCH_MISSES   4
+#define PROFILE_METRICS         5
+
+static const char *const profile_metrics[PROFILE_METRICS] = {
+    "ns", "cycles", "instructions", "cache_misses", "branch_misses"
+};
+
+static const uint64_t profile_events[PROFILE_METRICS] = {
+    0,
+    PERF_COUNT_HW_CPU_CYCLES,
+    PERF_COUNT_HW_INSTRUCTIONS,
+    PERF_COUNT_HW_CACHE_MISSES,
+    PERF_COUNT_HW_BRANCH_MISSES
+};
+
+/* Hardware counters, opened as one group so they count the same calls */
+typedef struct
+{
+    int leader;
+    int fds[PROFILE_METRICS];
+    unsigned count;
+
+    /* Position of each metric in a read of the group, or -1 */
+    int slot[PROFILE_METRICS];
+
+} ProfileCounters_t;
+
+/* Keys, inputs and outputs of the functions */
+static ForkSkinny64Key_t profile_tks1_64;
+static ForkSkinny64Key_t profile_tks2_64;
+static ForkSkinny128Key_t profile_ks1_128;
+static ForkSkinny128Key_t profile_ks2_128_256;
+static ForkSkinny128Key_t profile_ks2_128_384;
+static ForkSkinny128Key_t profile_ks3_128_384;
+static ForkAE64192Key_t profile_key_64_192;
+static ForkAE128256Key_t profile_key_128_256;
+static ForkAE128384Key_t profile_key_128_384;
+static uint8_t profile_k[FORKAE_128_384_KEY_SIZE];
+static uint8_t profile_nonce[16];
+static uint8_t profile_tag[16];
+static uint8_t *profile_tk1;
+static uint8_t *profile_input;
+static uint8_t *profile_left;
+static uint8_t *profile_right;
+static uint8_t *profile_ciphertext[4];
+static size_t profile_length;
+static size_t profile_blocks;
+
+static void profile_empty(void)
+{
+}
+
+static void profile_init_tk1_64_192(void)
+{
+    forkskinny_c_64_192_init_tk1(&profile_tks1_64, profile_nonce, FORKSKINNY64_MAX_ROUNDS);
+}
+
+static void profile_init_tk2_tk3_64_192(void)
+{
+    forkskinny_c_64_192_init_tk2_tk3(&profile_tks2_64, profile_k, FORKSKINNY64_MAX_ROUNDS);
+}
+
+static void profile_encrypt_64_192(void)
+{
+    forkskinny_c_64_192_encrypt(&profile_tks1_64, &profile_tks2_64, profile_left, profile_right, profile_input);
+}
+
+static void profile_decrypt_64_192(void)
+{
+    forkskinny_c_64_192_decrypt(&profile_tks1_64, &profile_tks2_64, profile_left, profile_right, profile_input);
+}
+
+static void profile_encrypt_parallel_64_192(void)
+{
+    forkskinny_c_64_192_encrypt_parallel(profile_tk1, &profile_tks2_64, profile_left, profile_right, profile_input, profile_blocks);
+}
+
+static void profile_decrypt_parallel_64_192(void)
+{
+    forkskinny_c_64_192_decrypt_parallel(profile_tk1, &profile_tks2_64, profile_left, profile_right, profile_input, profile_blocks);
+}
+
+static void profile_init_tk1_128_256(void)
+{
+    forkskinny_c_128_256_init_tk1(&profile_ks1_128, profile_nonce,
+        FORKSKINNY_128_256_ROUNDS_BEFORE + 2 * FORKSKINNY_128_256_ROUNDS_AFTER);
+}
+
+static void profile_init_tk2_128_256(void)
+{
+    forkskinny_c_128_256_init_tk2(&profile_ks2_128_256, profile_k,
+        FORKSKINNY_128_256_ROUNDS_BEFORE + 2 * FORKSKINNY_128_256_ROUNDS_AFTER);
+}
+
+static void profile_encrypt_128_256(void)
+{
+    forkskinny_c_128_256_encrypt(&profile_ks1_128, &profile_ks2_128_256, profile_left, profile_right, profile_input);
+}
+
+static void profile_decrypt_128_256(void)
+{
+    forkskinny_c_128_256_decrypt(&profile_ks1_128, &profile_ks2_128_256, profile_left, profile_right, profile_input);
+}
+
+static void profile_encrypt_parallel_128_256(void)
+{
+    forkskinny_c_128_256_encrypt_parallel(profile_tk1, &profile_ks2_128_256, profile_left, profile_right, profile_input, profile_blocks);
+}
+
+static void profile_decrypt_parallel_128_256(void)
+{
+    forkskinny_c_128_256_decrypt_parallel(profile_tk1, &profile_ks2_128_256, profile_left, profile_right, profile_input, profile_blocks);
+}
+
+static void profile_init_tk1_128_384(void)
+{
+    forkskinny_c_128_384_init_tk1(&profile_ks1_128, profile_nonce, FORKSKINNY128_MAX_ROUNDS);
+}
+
+static void profile_init_tk2_128_384(void)
+{
+    forkskinny_c_128_384_init_tk2(&profile_ks2_128_384, profile_k, FORKSKINNY128_MAX_ROUNDS);
+}
+
+static void profile_init_tk3_128_384(void)
+{
+    forkskinny_c_128_384_init_tk3(&profile_ks3_128_384, profile_k + 16, FORKSKINNY128_MAX_ROUNDS);
+}
+
+static void profile_encrypt_128_384(void)
+{
+    forkskinny_c_128_384_encrypt(&profile_ks1_128, &profile_ks2_128_384, &profile_ks3_128_384, profile_left, profile_right, profile_input);
+}
+
+static void profile_decrypt_128_384(void)
+{
+    forkskinny_c_128_384_decrypt(&profile_ks1_128, &profile_ks2_128_384, &profile_ks3_128_384, profile_left, profile_right, profile_input);
+}
+
+static void profile_encrypt_parallel_128_384(void)
+{
+    forkskinny_c_128_384_encrypt_parallel(profile_tk1, &profile_ks2_128_384, &profile_ks3_128_384, profile_left, profile_right, profile_input, profile_blocks);
+}
+
+static void profile_decrypt_parallel_128_384(void)
+{
+    forkskinny_c_128_384_decrypt_parallel(profile_tk1, &profile_ks2_128_384, &profile_ks3_128_384, profile_left, profile_right, profile_input, profile_blocks);
+}
+
+static void profile_init_key_64_192(void)
+{
+    forkae_c_64_192_init_key(&profile_key_64_192, profile_k);
+}
+
+static void profile_init_key_128_256(void)
+{
+    forkae_c_128_256_init_key(&profile_key_128_256, profile_k);
+}
+
+static void profile_init_key_128_384(void)
+{
+    forkae_c_128_384_init_key(&profile_key_128_384, profile_k);
+}
+
+/* The AEAD modes decrypt the ciphertext of the message prepared by
+   profile_setup in profile_ciphertext[0..3] */
+static void profile_paef_64_192_encrypt(void)
+{
+    size_t clen;
+    forkae_c_paef_64_192_encrypt(&profile_key_64_192, profile_left, &clen, profile_input, profile_length, 0, 0, profile_nonce);
+}
+
+static void profile_paef_64_192_decrypt(void)
+{
+    size_t mlen;
+    forkae_c_paef_64_192_decrypt(&profile_key_64_192, profile_left, &mlen, profile_ciphertext[0], profile_length + FORKAE_PAEF_64_192_TAG_SIZE, 0, 0, profile_nonce);
+}
+
+static void profile_paef_128_384_encrypt(void)
+{
+    size_t clen;
+    forkae_c_paef_128_384_encrypt(&profile_key_128_384, profile_left, &clen, profile_input, profile_length, 0, 0, profile_nonce);
+}
+
+static void profile_paef_128_384_decrypt(void)
+{
+    size_t mlen;
+    forkae_c_paef_128_384_decrypt(&profile_key_128_384, profile_left, &mlen, profile_ciphertext[1], profile_length + FORKAE_PAEF_128_384_TAG_SIZE, 0, 0, profile_nonce);
+}
+
+static void profile_saef_128_256_encrypt(void)
+{
+    size_t clen;
+    forkae_c_saef_128_256_encrypt(&profile_key_128_256, profile_left, &clen, profile_input, profile_length, 0, 0, profile_nonce);
+}
+
+static void profile_saef_128_256_decrypt(void)
+{
+    size_t mlen;
+    forkae_c_saef_128_256_decrypt(&profile_key_128_256, profile_left, &mlen, profile_ciphertext[2], profile_length + FORKAE_SAEF_128_TAG_SIZE, 0, 0, profile_nonce);
+}
+
+static void profile_saef_128_384_encrypt(void)
+{
+    size_t clen;
+    forkae_c_saef_128_384_encrypt(&profile_key_128_384, profile_left, &clen, profile_input, profile_length, 0, 0, profile_nonce);
+}
+
+static void profile_saef_128_384_decrypt(void)
+{
+    size_t mlen;
+    forkae_c_saef_128_384_decrypt(&profile_key_128_384, profile_left, &mlen, profile_ciphertext[3], profile_length + FORKAE_SAEF_128_TAG_SIZE, 0, 0, profile_nonce);
+}
+
+static void profile_ctr_128_256_xor(void)
+{
+    forkae_c_ctr_128_256_xor(&profile_key_128_256, profile_nonce, 0, profile_left, profile_input, profile_length);
+}
+
+static void profile_ctr_128_384_xor(void)
+{
+    forkae_c_ctr_128_384_xor(&profile_key_128_384, profile_nonce, 0, profile_left, profile_input, profile_length);
+}
+
+static void profile_sector_128_256_encrypt(void)
+{
+    forkae_c_sector_128_256_encrypt(&profile_key_128_256, 1, profile_left, profile_input, profile_length);
+}
+
+static void profile_sector_128_256_decrypt(void)
+{
+    forkae_c_sector_128_256_decrypt(&profile_key_128_256, 1, profile_left, profile_input, profile_length);
+}
+
+static void profile_sector_128_384_encrypt(void)
+{
+    forkae_c_sector_128_384_encrypt(&profile_key_128_384, 1, profile_left, profile_input, profile_length);
+}
+
+static void profile_sector_128_384_decrypt(void)
+{
+    forkae_c_sector_128_384_decrypt(&profile_key_128_384, 1, profile_left, profile_input, profile_length);
+}
+
+static void profile_pmac_128_384(void)
+{
+    forkae_c_pmac_128_384(&profile_key_128_384, profile_tag, profile_input, profile_length);
+}
+
+/* The profiled functions; bytes is 1 for the functions on a message of
+   profile_length bytes, 2 for the parallel kernels, 0 otherwise */
+static const struct
+{
+    const char *name;
+    void (*call)(void);
+    size_t block_size;
+    int bytes;
+    size_t max_length;
+}
+profile_functions[] = {
+    {"(empty)", profile_empty, 0, 0, 0},
+    {"forkskinny_c_64_192_init_tk1", profile_init_tk1_64_192, 0, 0, 0},
+    {"forkskinny_c_64_192_init_tk2_tk3", profile_init_tk2_tk3_64_192, 0, 0, 0},
+    {"forkskinny_c_64_192_encrypt", profile_encrypt_64_192, FORKSKINNY64_BLOCK_SIZE, 0, 0},
+    {"forkskinny_c_64_192_decrypt", profile_decrypt_64_192, FORKSKINNY64_BLOCK_SIZE, 0, 0},
+    {"forkskinny_c_64_192_encrypt_parallel", profile_encrypt_parallel_64_192, FORKSKINNY64_BLOCK_SIZE, 2, 0},
+    {"forkskinny_c_64_192_decrypt_parallel", profile_decrypt_parallel_64_192, FORKSKINNY64_BLOCK_SIZE, 2, 0},
+    {"forkskinny_c_128_256_init_tk1", profile_init_tk1_128_256, 0, 0, 0},
+    {"forkskinny_c_128_256_init_tk2", profile_init_tk2_128_256, 0, 0, 0},
+    {"forkskinny_c_128_256_encrypt", profile_encrypt_128_256, FORKSKINNY128_BLOCK_SIZE, 0, 0},
+    {"forkskinny_c_128_256_decrypt", profile_decrypt_128_256, FORKSKINNY128_BLOCK_SIZE, 0, 0},
+    {"forkskinny_c_128_256_encrypt_parallel", profile_encrypt_parallel_128_256, FORKSKINNY128_BLOCK_SIZE, 2, 0},
+    {"forkskinny_c_128_256_decrypt_parallel", profile_decrypt_parallel_128_256, FORKSKINNY128_BLOCK_SIZE, 2, 0},
+    {"forkskinny_c_128_384_init_tk1", profile_init_tk1_128_384, 0, 0, 0},
+    {"forkskinny_c_128_384_init_tk2", profile_init_tk2_128_384, 0, 0, 0},
+    {"forkskinny_c_128_384_init_tk3", profile_init_tk3_128_384, 0, 0, 0},
+    {"forkskinny_c_128_384_encrypt", profile_encrypt_128_384, FORKSKINNY128_BLOCK_SIZE, 0, 0},
+    {"forkskinny_c_128_384_decrypt", profile_decrypt_128_384, FORKSKINNY128_BLOCK_SIZE, 0, 0},
+    {"forkskinny_c_128_384_encrypt_parallel", profile_encrypt_parallel_128_384, FORKSKINNY128_BLOCK_SIZE, 2, 0},
+    {"forkskinny_c_128_384_decrypt_parallel", profile_decrypt_parallel_128_384, FORKSKINNY128_BLOCK_SIZE, 2, 0},
+    {"forkae_c_64_192_init_key", profile_init_key_64_192, 0, 0, 0},
+    {"forkae_c_128_256_init_key", profile_init_key_128_256, 0, 0, 0},
+    {"forkae_c_128_384_init_key", profile_init_key_128_384, 0, 0, 0},
+    {"forkae_c_paef_64_192_encrypt", profile_paef_64_192_encrypt, 0, 1,
+     FORKAE_PAEF_64_192_MAX_BLOCKS * FORKSKINNY64_BLOCK_SIZE},
+    {"forkae_c_paef_64_192_decrypt", profile_paef_64_192_decrypt, 0, 1,
+     FORKAE_PAEF_64_192_MAX_BLOCKS * FORKSKINNY64_BLOCK_SIZE},
+    {"forkae_c_paef_128_384_encrypt", profile_paef_128_384_encrypt, 0, 1, PROFILE_MAX_LENGTH},
+    {"forkae_c_paef_128_384_decrypt", profile_paef_128_384_decrypt, 0, 1, PROFILE_MAX_LENGTH},
+    {"forkae_c_saef_128_256_encrypt", profile_saef_128_256_encrypt, 0, 1, PROFILE_MAX_LENGTH},
+    {"forkae_c_saef_128_256_decrypt", profile_saef_128_256_decrypt, 0, 1, PROFILE_MAX_LENGTH},
+    {"forkae_c_saef_128_384_encrypt", profile_saef_128_384_encrypt, 0, 1, PROFILE_MAX_LENGTH},
+    {"forkae_c_saef_128_384_decrypt", profile_saef_128_384_decrypt, 0, 1, PROFILE_MAX_LENGTH},
+    {"forkae_c_ctr_128_256_xor", profile_ctr_128_256_xor, 0, 1, PROFILE_MAX_LENGTH},
+    {"forkae_c_ctr_128_384_xor", profile_ctr_128_384_xor, 0, 1, PROFILE_MAX_LENGTH},
+    {"forkae_c_sector_128_256_encrypt", profile_sector_128_256_encrypt, 0, 1, PROFILE_MAX_LENGTH},
+    {"forkae_c_sector_128_256_decrypt", profile_sector_128_256_decrypt, 0, 1, PROFILE_MAX_LENGTH},
+    {"forkae_c_sector_128_384_encrypt", profile_sector_128_384_encrypt, 0, 1, PROFILE_MAX_LENGTH},
+    {"forkae_c_sector_128_384_decrypt", profile_sector_128_384_decrypt, 0, 1, PROFILE_MAX_LENGTH},
+    {"forkae_c_pmac_128_384", profile_pmac_128_384, 0, 1, PROFILE_MAX_LENGTH},
+};
+
+static uint8_t *profile_alloc(size_t len)
+{
+    uint8_t *data = (uint8_t *)malloc(len);
+    size_t posn;
+    if (!data) {
+        fprintf(stderr, "profile: out of memory\n");
+        exit(1);
+    }
+    for (posn = 0; posn < len; ++posn)
+        data[posn] = (uint8_t)(posn * 17 + 3);
+    return data;
+}
+
+static void profile_setup(void)
+{
+    size_t size = profile_length;
+    size_t clen;
+    unsigned posn;
+
+    if (size < PROFILE_MAX_BLOCKS * FORKSKINNY128_BLOCK_SIZE)
+        size = PROFILE_MAX_BLOCKS * FORKSKINNY128_BLOCK_SIZE;
+    size += FORKSKINNY128_BLOCK_SIZE;
+    for (posn = 0; posn < sizeof(profile_k); ++posn)
+        profile_k[posn] = (uint8_t)(posn * 29 + 1);
+    for (posn = 0; posn < sizeof(profile_nonce); ++posn)
+        profile_nonce[posn] = (uint8_t)(posn * 13 + 7);
+    profile_tk1 = profile_alloc(size);
+    profile_input = profile_alloc(size);
+    profile_left = profile_alloc(size);
+    profile_right = profile_alloc(size);
+    for (posn = 0; posn < 4; ++posn)
+        profile_ciphertext[posn] = profile_alloc(size);
+
+    profile_init_tk1_64_192();
+    profile_init_tk2_tk3_64_192();
+    profile_init_tk1_128_384();
+    profile_init_tk2_128_256();
+    profile_init_tk2_128_384();
+    profile_init_tk3_128_384();
+    profile_init_key_64_192();
+    profile_init_key_128_256();
+    profile_init_key_128_384();
+
+    if (profile_length <= FORKAE_PAEF_64_192_MAX_BLOCKS * FORKSKINNY64_BLOCK_SIZE)
+        forkae_c_paef_64_192_encrypt(&profile_key_64_192, profile_ciphertext[0], &clen, profile_input, profile_length, 0, 0, profile_nonce);
+    forkae_c_paef_128_384_encrypt(&profile_key_128_384, profile_ciphertext[1], &clen, profile_input, profile_length, 0, 0, profile_nonce);
+    forkae_c_saef_128_256_encrypt(&profile_key_128_256, profile_ciphertext[2], &clen, profile_input, profile_length, 0, 0, profile_nonce);
+    forkae_c_saef_128_384_encrypt(&profile_key_128_384, profile_ciphertext[3], &clen, profile_input, profile_length, 0, 0, profile_nonce);
+}
+
+static int profile_open(uint64_t config, int group)
+{
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.config = config;
+    attr.disabled = group < 0;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_GROUP;
+    return (int)syscall(__NR_perf_event_open, &attr, 0, -1, group, 0);
+}
+
+/* Opens the counters that are available; the first becomes the leader */
+static void profile_counters_open(ProfileCounters_t *counters)
+{
+    unsigned metric;
+    int fd, error = 0;
+
+    counters->leader = -1;
+    counters->count = 0;
+    for (metric = 0; metric < PROFILE_METRICS; ++metric) {
+        counters->slot[metric] = -1;
+        if (metric == PROFILE_NS)
+            continue;
+        fd = profile_open(profile_events[metric], counters->leader);
+        if (fd < 0) {
+            error = errno;
+            continue;
+        }
+        if (counters->leader < 0)
+            counters->leader = fd;
+        counters->fds[counters->count] = fd;
+        counters->slot[metric] = (int)(counters->count++);
+    }
+    if (error)
+        fprintf(stderr, "profile: %s hardware counters are not available: %s\n",
+                counters->count ? "some" : "the", strerror(error));
+    if (counters->leader >= 0)
+        ioctl(counters->leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+}
+
+/* Reads the counters of the group: their number, then the values */
+static void profile_counters_read(const ProfileCounters_t *counters, uint64_t *values)
+{
+    if (counters->leader < 0)
+        return;
+    if (read(counters->leader, values, (1 + counters->count) * sizeof(uint64_t)) < 0)
+        values[0] = 0;
+}
+
+static uint64_t profile_now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000U + (uint64_t)ts.tv_nsec;
+}
+
+static int profile_compare(const void *a, const void *b)
+{
+    uint64_t x = *(const uint64_t *)a;
+    uint64_t y = *(const uint64_t *)b;
+    return (x > y) - (x < y);
+}
+
+/* Nearest-rank percentile of sorted values */
+static uint64_t profile_percentile(const uint64_t *values, size_t count, double p)
+{
+    size_t rank = (size_t)(p * (double)count + 0.999999);
+    if (rank < 1)
+        rank = 1;
+    if (rank > count)
+        rank = count;
+    return values[rank - 1];
+}
+
+typedef struct
+{
+    int csv;
+    size_t calls;
+    size_t warmup;
+    int cold;
+    int histogram;
+    const char *match;
+
+} ProfileOptions_t;
+
+static void profile_header(const ProfileOptions_t *options)
+{
+    unsigned metric;
+    if (options->csv) {
+        printf("function,bytes,calls");
+        for (metric = 0; metric < PROFILE_METRICS; ++metric)
+            printf(",%s_p50,%s_p99,%s_p999,%s_max", profile_metrics[metric],
+                   profile_metrics[metric], profile_metrics[metric],
+                   profile_metrics[metric]);
+        printf("\n");
+    } else {
+        printf("%-16s %12s %12s %12s %12s\n", "", "p50", "p99", "p99.9", "max");
+    }
+}
+
+/* Returns the power of two below a value */
+static unsigned profile_bucket(uint64_t value)
+{
+    unsigned bucket = 0;
+    while (value > 1) {
+        value >>= 1;
+        ++bucket;
+    }
+    return bucket;
+}
+
+/* Prints the number of sorted values in each power-of-two range */
+static void profile_histogram(const uint64_t *values, size_t count)
+{
+    size_t posn = 0, start, width;
+    unsigned bucket;
+    while (posn < count) {
+        bucket = profile_bucket(values[posn]);
+        start = posn;
+        while (posn < count && profile_bucket(values[posn]) == bucket)
+            ++posn;
+        printf("    %12llu .. %12llu ns %9lu ",
+               bucket ? 1ULL << bucket : 0ULL, (2ULL << bucket) - 1,
+               (unsigned long)(posn - start));
+        for (width = (posn - start) * 50 / count; width > 0; --width)
+            putchar('#');
+        putchar('\n');
+    }
+}
+
+static void profile_function(unsigned index, const ProfileCounters_t *counters,
+                             const ProfileOptions_t *options, uint64_t **samples,
+                             uint8_t *flush)
+{
+    void (*call)(void) = profile_functions[index].call;
+    uint64_t before[1 + PROFILE_METRICS];
+    uint64_t after[1 + PROFILE_METRICS];
+    uint64_t start, end, p50, p99, p999;
+    size_t bytes, posn;
+    unsigned metric;
+    int slot;
+
+    if (index != 0 && options->match &&
+            !strstr(profile_functions[index].name, options->match))
+        return;
+    if (profile_functions[index].bytes == 1) {
+        if (profile_length > profile_functions[index].max_length)
+            return;
+        bytes = profile_length;
+    } else if (profile_functions[index].bytes == 2) {
+        bytes = profile_blocks * profile_functions[index].block_size;
+    } else {
+        bytes = profile_functions[index].block_size;
+    }
+
+    for (posn = 0; posn < options->warmup; ++posn)
+        call();
+    for (posn = 0; posn < options->calls; ++posn) {
+        if (options->cold)
+            memset(flush, (int)posn, PROFILE_FLUSH_SIZE);
+        profile_counters_read(counters, before);
+        start = profile_now();
+        call();
+        end = profile_now();
+        profile_counters_read(counters, after);
+        samples[PROFILE_NS][posn] = end - start;
+        for (metric = 1; metric < PROFILE_METRICS; ++metric) {
+            slot = counters->slot[metric];
+            if (slot >= 0)
+                samples[metric][posn] = after[1 + slot] - before[1 + slot];
+        }
+    }
+
+    if (options->csv)
+        printf("%s,%lu,%lu", profile_functions[index].name,
+               (unsigned long)bytes, (unsigned long)options->calls);
+    else
+        printf("%s (%lu bytes)\n", profile_functions[index].name,
+               (unsigned long)bytes);
+    for (metric = 0; metric < PROFILE_METRICS; ++metric) {
+        uint64_t *values = samples[metric];
+        if (metric != PROFILE_NS && counters->slot[metric] < 0) {
+            if (options->csv)
+                printf(",,,,");
+            continue;
+        }
+        qsort(values, options->calls, sizeof(uint64_t), profile_compare);
+        p50 = profile_percentile(values, options->calls, 0.5);
+        p99 = profile_percentile(values, options->calls, 0.99);
+        p999 = profile_percentile(values, options->calls, 0.999);
+        if (options->csv)
+            printf(",%llu,%llu,%llu,%llu", (unsigned long long)p50,
+                   (unsigned long long)p99, (unsigned long long)p999,
+                   (unsigned long long)values[options->calls - 1]);
+        else
+            printf("  %-14s %12llu %12llu %12llu %12llu\n",
+                   profile_metrics[metric], (unsigned long long)p50,
+                   (unsigned long long)p99, (unsigned long long)p999,
+                   (unsigned long long)values[options->calls - 1]);
+        if (metric == PROFILE_NS && options->histogram && !options->csv)
+            profile_histogram(values, options->calls);
+    }
+    if (options->csv)
+        printf("\n");
+    fflush(stdout);
+}
+
+static void profile_usage(void)
+{
+    fprintf(stderr, "usage: profile.x [-o text|csv] [-n calls] [-w warmup] "
+                    "[-l len] [-b blocks] [-c] [-H] [-m match]\n");
+    exit(2);
+}
+
+int main(int argc, char *argv[])
+{
+    ProfileOptions_t options;
+    ProfileCounters_t counters;
+    uint64_t *samples[PROFILE_METRICS];
+    uint8_t *flush = 0;
+    unsigned index, metric;
+    long value;
+    int opt;
+
+    options.csv = 0;
+    options.calls = PROFILE_DEFAULT_CALLS;
+    options.warmup = PROFILE_DEFAULT_WARMUP;
+    options.cold = 0;
+    options.histogram = 0;
+    options.match = 0;
+    profile_length = PROFILE_DEFAULT_LENGTH;
+    profile_blocks = PROFILE_DEFAULT_BLOCKS;
+    while ((opt = getopt(argc, argv, "o:n:w:l:b:cHm:")) != -1) {
+        switch (opt) {
+        case 'o':
+            if (strcmp(optarg, "csv") == 0)
+                options.csv = 1;
+            else if (strcmp(optarg, "text") != 0)
+                profile_usage();
+            break;
+        case 'n':
+            value = atol(optarg);
+            if (value < 1)
+                profile_usage();
+            options.calls = (size_t)value;
+            break;
+        case 'w':
+            value = atol(optarg);
+            if (value < 0)
+                profile_usage();
+            options.warmup = (size_t)value;
+            break;
+        case 'l':
+            value = atol(optarg);
+            if (value < 0 || value > PROFILE_MAX_LENGTH || value % 16 != 0)
+                profile_usage();
+            profile_length = (size_t)value;
+            break;
+        case 'b':
+            value = atol(optarg);
+            if (value < 1 || value > PROFILE_MAX_BLOCKS)
+                profile_usage();
+            profile_blocks = (size_t)value;
+            break;
+        case 'c': options.cold = 1; break;
+        case 'H': options.histogram = 1; break;
+        case 'm': options.match = optarg; break;
+        default: profile_usage();
+        }
+    }
+    if (optind != argc)
+        profile_usage();
+
+    profile_setup();
+    for (metric = 0; metric < PROFILE_METRICS; ++metric)
+        samples[metric] = (uint64_t *)profile_alloc(options.calls * sizeof(uint64_t));
+    if (options.cold)
+        flush = profile_alloc(PROFILE_FLUSH_SIZE);
+    profile_counters_open(&counters);
+
+    profile_header(&options);
+    for (index = 0; index < sizeof(profile_functions) / sizeof(profile_functions[0]); ++index)
+        profile_function(index, &counters, &options, samples, flush);
+    return 0;
+}
@@ -0,0 +1,561 @@
+/*
+ * Replays a trace of messages through the ForkAE modes and forkciphers.
+ *
+ *   replay.x [-o text|csv] [-a mode]... [-s] [-r passes] [trace]
+ *   replay.x -G count [-S seed]
+ *
+ * A trace has one message per line: its length in bytes, the id of its
+ * key (any 32-bit number) and its direction, "e" to encrypt or "d" to
+ * decrypt, separated by spaces; empty lines and lines starting with '#'
+ * are skipped. The trace is read from the named file or stdin.
+ *
+ * Every message of the trace is processed with its own nonce under its
+ * key, once per pass (default 1), and timed on its own; the time of a
+ * message includes the expansion of its key when that is needed. By
+ * default the schedules of every key are kept once computed, so a key is
+ * expanded on its first message only; with -s there is a single key
+ * context that is re-expanded whenever the key id changes from one
+ * message to the next. A message to decrypt is first encrypted, untimed.
+ *
+ * For each mode (-a, repeatable; default all) the throughput and the
+ * percentiles of the latency per message are reported. The forkskinny-*
+ * modes run the parallel kernel on the message padded to whole blocks,
+ * computing one leg, as a bare primitive without authentication.
+ * Messages too long for a mode are skipped and counted.
+ *
+ * -G writes a synthetic trace of count messages to stdout instead: 60%
+ * 40-byte control messages, 10% 576 bytes, 20% 1500 bytes and 10% 9000
+ * bytes jumbo frames, under 16 keys, with 70% of them encrypted.
+ */
+
+#define _GNU_SOURCE
+#include "forkskinny64-parallel.h"
+#include "forkskinny128-parallel.h"
+#include "forkae-paef.h"
+#include "forkae-saef.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#define REPLAY_MAX_LENGTH (1 << 24)
+/* Padding and tag of the longest ciphertext of a message */
+#define REPLAY_OVERHEAD 32
+
+/* One message of the trace; key is the index of its distinct key id */
+typedef struct
+{
+    uint32_t length;
+    uint32_t key;
+    int decrypt;
+
+} ReplayMessage_t;
+
+/* The functions of a mode on a key of key_size bytes */
+typedef struct
+{
+    const char *name;
+    size_t key_size;
+    size_t max_length;
+    void (*init)(void *key, const uint8_t *k);
+    void (*encrypt)(const void *key, uint8_t *c, size_t *clen, const uint8_t *m, size_t mlen, const uint8_t *nonce);
+    int (*decrypt)(const void *key, uint8_t *m, size_t *mlen, const uint8_t *c, size_t clen, const uint8_t *nonce);
+
+} ReplayMode_t;
+
+/* TK1 of the blocks of the forkciphers: the block index */
+static uint8_t *replay_tk1;
+
+static void replay_init_64_192(void *key, const uint8_t *k)
+{
+    forkae_c_64_192_init_key((ForkAE64192Key_t *)key, k);
+}
+
+static void replay_init_128_256(void *key, const uint8_t *k)
+{
+    forkae_c_128_256_init_key((ForkAE128256Key_t *)key, k);
+}
+
+static void replay_init_128_384(void *key, const uint8_t *k)
+{
+    forkae_c_128_384_init_key((ForkAE128384Key_t *)key, k);
+}
+
+static void replay_paef_64_192_encrypt(const void *key, uint8_t *c, size_t *clen, const uint8_t *m, size_t mlen, const uint8_t *nonce)
+{
+    forkae_c_paef_64_192_encrypt((const ForkAE64192Key_t *)key, c, clen, m, mlen, 0, 0, nonce);
+}
+
+static int replay_paef_64_192_decrypt(const void *key, uint8_t *m, size_t *mlen, const uint8_t *c, size_t clen, const uint8_t *nonce)
+{
+    return forkae_c_paef_64_192_decrypt((const ForkAE64192Key_t *)key, m, mlen, c, clen, 0, 0, nonce);
+}
+
+static void replay_paef_128_384_encrypt(const void *key, uint8_t *c, size_t *clen, const uint8_t *m, size_t mlen, const uint8_t *nonce)
+{
+    forkae_c_paef_128_384_encrypt((const ForkAE128384Key_t *)key, c, clen, m, mlen, 0, 0, nonce);
+}
+
+static int replay_paef_128_384_decrypt(const void *key, uint8_t *m, size_t *mlen, const uint8_t *c, size_t clen, const uint8_t *nonce)
+{
+    return forkae_c_paef_128_384_decrypt((const ForkAE128384Key_t *)key, m, mlen, c, clen, 0, 0, nonce);
+}
+
+static void replay_saef_128_256_encrypt(const void *key, uint8_t *c, size_t *clen, const uint8_t *m, size_t mlen, const uint8_t *nonce)
+{
+    forkae_c_saef_128_256_encrypt((const ForkAE128256Key_t *)key, c, clen, m, mlen, 0, 0, nonce);
+}
+
+static int replay_saef_128_256_decrypt(const void *key, uint8_t *m, size_t *mlen, const uint8_t *c, size_t clen, const uint8_t *nonce)
+{
+    return forkae_c_saef_128_256_decrypt((const ForkAE128256Key_t *)key, m, mlen, c, clen, 0, 0, nonce);
+}
+
+static void replay_saef_128_384_encrypt(const void *key, uint8_t *c, size_t *clen, const uint8_t *m, size_t mlen, const uint8_t *nonce)
+{
+    forkae_c_saef_128_384_encrypt((const ForkAE128384Key_t *)key, c, clen, m, mlen, 0, 0, nonce);
+}
+
+static int replay_saef_128_384_decrypt(const void *key, uint8_t *m, size_t *mlen, const uint8_t *c, size_t clen, const uint8_t *nonce)
+{
+    return forkae_c_saef_128_384_decrypt((const ForkAE128384Key_t *)key, m, mlen, c, clen, 0, 0, nonce);
+}
+
+static void replay_forkskinny_64_192_encrypt(const void *key, uint8_t *c, size_t *clen, const uint8_t *m, size_t mlen, const uint8_t *nonce)
+{
+    size_t count = (mlen + FORKSKINNY64_BLOCK_SIZE - 1) / FORKSKINNY64_BLOCK_SIZE;
+    (void)nonce;
+    forkskinny_c_64_192_encrypt_parallel(replay_tk1, &((const ForkAE64192Key_t *)key)->tks23, 0, c, m, count);
+    *clen = count * FORKSKINNY64_BLOCK_SIZE;
+}
+
+static int replay_forkskinny_64_192_decrypt(const void *key, uint8_t *m, size_t *mlen, const uint8_t *c, size_t clen, const uint8_t *nonce)
+{
+    size_t count = clen / FORKSKINNY64_BLOCK_SIZE;
+    (void)nonce;
+    forkskinny_c_64_192_decrypt_parallel(replay_tk1, &((const ForkAE64192Key_t *)key)->tks23, 0, m, c, count);
+    *mlen = clen;
+    return 0;
+}
+
+static void replay_forkskinny_128_256_encrypt(const void *key, uint8_t *c, size_t *clen, const uint8_t *m, size_t mlen, const uint8_t *nonce)
+{
+    size_t count = (mlen + FORKSKINNY128_BLOCK_SIZE - 1) / FORKSKINNY128_BLOCK_SIZE;
+    (void)nonce;
+    forkskinny_c_128_256_encrypt_parallel(replay_tk1, &((const ForkAE128256Key_t *)key)->tks2, 0, c, m, count);
+    *clen = count * FORKSKINNY128_BLOCK_SIZE;
+}
+
+static int replay_forkskinny_128_256_decrypt(const void *key, uint8_t *m, size_t *mlen, const uint8_t *c, size_t clen, const uint8_t *nonce)
+{
+    size_t count = clen / FORKSKINNY128_BLOCK_SIZE;
+    (void)nonce;
+    forkskinny_c_128_256_decrypt_parallel(replay_tk1, &((const ForkAE128256Key_t *)key)->tks2, 0, m, c, count);
+    *mlen = clen;
+    return 0;
+}
+
+static void replay_forkskinny_128_384_encrypt(const void *key, uint8_t *c, size_t *clen, const uint8_t *m, size_t mlen, const uint8_t *nonce)
+{
+    const ForkAE128384Key_t *k = (const ForkAE128384Key_t *)key;
+    size_t count = (mlen + FORKSKINNY128_BLOCK_SIZE - 1) / FORKSKINNY128_BLOCK_SIZE;
+    (void)nonce;
+    forkskinny_c_128_384_encrypt_parallel(replay_tk1, &k->tks2, &k->tks3, 0, c, m, count);
+    *clen = count * FORKSKINNY128_BLOCK_SIZE;
+}
+
+static int replay_forkskinny_128_384_decrypt(const void *key, uint8_t *m, size_t *mlen, const uint8_t *c, size_t clen, const uint8_t *nonce)
+{
+    const ForkAE128384Key_t *k = (const ForkAE128384Key_t *)key;
+    size_t count = clen / FORKSKINNY128_BLOCK_SIZE;
+    (void)nonce;
+    forkskinny_c_128_384_decrypt_parallel(replay_tk1, &k->tks2, &k->tks3, 0, m, c, count);
+    *mlen = clen;
+    return 0;
+}
+
+static const ReplayMode_t replay_modes[] = {
+    {"paef-forkskinny-64-192", sizeof(ForkAE64192Key_t),
+     FORKAE_PAEF_64_192_MAX_BLOCKS * FORKSKINNY64_BLOCK_SIZE,
+     replay_init_64_192, replay_paef_64_192_encrypt, replay_paef_64_192_decrypt},
+    {"paef-forkskinny-128-384", sizeof(ForkAE128384Key_t), REPLAY_MAX_LENGTH,
+     replay_init_128_384, replay_paef_128_384_encrypt, replay_paef_128_384_decrypt},
+    {"saef-forkskinny-128-256", sizeof(ForkAE128256Key_t), REPLAY_MAX_LENGTH,
+     replay_init_128_256, replay_saef_128_256_encrypt, replay_saef_128_256_decrypt},
+    {"saef-forkskinny-128-384", sizeof(ForkAE128384Key_t), REPLAY_MAX_LENGTH,
+     replay_init_128_384, replay_saef_128_384_encrypt, replay_saef_128_384_decrypt},
+    {"forkskinny-64-192", sizeof(ForkAE64192Key_t), REPLAY_MAX_LENGTH,
+     replay_init_64_192, replay_forkskinny_64_192_encrypt, replay_forkskinny_64_192_decrypt},
+    {"forkskinny-128-256", sizeof(ForkAE128256Key_t), REPLAY_MAX_LENGTH,
+     replay_init_128_256, replay_forkskinny_128_256_encrypt, replay_forkskinny_128_256_decrypt},
+    {"forkskinny-128-384", sizeof(ForkAE128384Key_t), REPLAY_MAX_LENGTH,
+     replay_init_128_384, replay_forkskinny_128_384_encrypt, replay_forkskinny_128_384_decrypt},
+};
+
+#define REPLAY_MODES (sizeof(replay_modes) / sizeof(replay_modes[0]))
+
+static void replay_fail(const char *message)
+{
+    fprintf(stderr, "replay: %s\n", message);
+    exit(1);
+}
+
+static void *replay_alloc(size_t len)
+{
+    void *data = calloc(1, len ? len : 1);
+    if (!data)
+        replay_fail("out of memory");
+    return data;
+}
+
+static uint64_t replay_now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000U + (uint64_t)ts.tv_nsec;
+}
+
+static int replay_compare(const void *a, const void *b)
+{
+    uint64_t x = *(const uint64_t *)a;
+    uint64_t y = *(const uint64_t *)b;
+    return (x > y) - (x < y);
+}
+
+static int replay_compare_id(const void *a, const void *b)
+{
+    uint32_t x = *(const uint32_t *)a;
+    uint32_t y = *(const uint32_t *)b;
+    return (x > y) - (x < y);
+}
+
+/* Nearest-rank percentile of sorted values */
+static uint64_t replay_percentile(const uint64_t *values, size_t count, double p)
+{
+    size_t rank = (size_t)(p * (double)count + 0.999999);
+    if (rank < 1)
+        rank = 1;
+    if (rank > count)
+        rank = count;
+    return values[rank - 1];
+}
+
+/* The trace, with the key ids mapped to 0 .. keys - 1 */
+typedef struct
+{
+    ReplayMessage_t *messages;
+    size_t count;
+    uint32_t *ids;
+    size_t keys;
+    size_t max_length;
+
+} ReplayTrace_t;
+
+static void replay_read(ReplayTrace_t *trace, FILE *file)
+{
+    char line[256];
+    char direction[16];
+    unsigned long length, id;
+    size_t capacity = 0, line_number = 0, posn, low, high, mid;
+    char *text;
+
+    memset(trace, 0, sizeof(*trace));
+    while (fgets(line, sizeof(line), file)) {
+        ++line_number;
+        for (text = line; *text == ' ' || *text == '\t'; ++text)
+            ;
+        if (*text == '#' || *text == '\n' || *text == '\r' || *text == '\0')
+            continue;
+        if (sscanf(text, "%lu %lu %15s", &length, &id, direction) != 3 ||
+                length > REPLAY_MAX_LENGTH || (uint64_t)id > 0xFFFFFFFFU ||
+                (direction[0] != 'e' && direction[0] != 'd')) {
+            fprintf(stderr, "replay: trace line %lu: expected "
+                            "\"length key e|d\"\n", (unsigned long)line_number);
+            exit(1);
+        }
+        if (trace->count == capacity) {
+            capacity = capacity ? 2 * capacity : 1024;
+            trace->messages = (ReplayMessage_t *)realloc
+                (trace->messages, capacity * sizeof(ReplayMessage_t));
+            trace->ids = (uint32_t *)realloc(trace->ids, capacity * sizeof(uint32_t));
+            if (!trace->messages || !trace->ids)
+                replay_fail("out of memory");
+        }
+        trace->messages[trace->count].length = (uint32_t)length;
+        trace->messages[trace->count].key = (uint32_t)id;
+        trace->messages[trace->count].decrypt = direction[0] == 'd';
+        trace->ids[trace->count] = (uint32_t)id;
+        if (length > trace->max_length)
+            trace->max_length = length;
+        ++(trace->count);
+    }
+    if (trace->count == 0)
+        replay_fail("the trace is empty");
+
+    /* Distinct key ids, sorted; messages refer to their index */
+    qsort(trace->ids, trace->count, sizeof(uint32_t), replay_compare_id);
+    for (posn = 0; posn < trace->count; ++posn) {
+        if (trace->keys == 0 || trace->ids[trace->keys - 1] != trace->ids[posn])
+            trace->ids[trace->keys++] = trace->ids[posn];
+    }
+    for (posn = 0; posn < trace->count; ++posn) {
+        low = 0;
+        high = trace->keys;
+        while (high - low > 1) {
+            mid = (low + high) / 2;
+            if (trace->ids[mid] <= trace->messages[posn].key)
+                low = mid;
+            else
+                high = mid;
+        }
+        trace->messages[posn].key = (uint32_t)low;
+    }
+}
+
+/* Derives the key bytes of a key id */
+static void replay_key(uint8_t *k, uint32_t id)
+{
+    unsigned posn;
+    for (posn = 0; posn < FORKAE_128_384_KEY_SIZE; ++posn)
+        k[posn] = (uint8_t)((id >> (8 * (posn % 4))) ^ (posn * 29 + 1));
+}
+
+typedef struct
+{
+    int csv;
+    unsigned passes;
+    int single;
+
+} ReplayOptions_t;
+
+static void replay_mode(const ReplayMode_t *mode, const ReplayTrace_t *trace,
+                        const ReplayOptions_t *options, uint64_t *latencies)
+{
+    uint8_t *keys, *key, *other;
+    uint8_t *valid;
+    uint8_t *message, *ciphertext, *output;
+    uint8_t k[FORKAE_128_384_KEY_SIZE];
+    uint8_t nonce[16];
+    uint64_t start, total = 0, bytes = 0, sequence = 0;
+    size_t count = 0, skipped = 0, inits = 0, failures = 0;
+    size_t clen, mlen, posn, current = (size_t)-1;
+    unsigned pass, byte;
+
+    keys = (uint8_t *)replay_alloc((options->single ? 1 : trace->keys) * mode->key_size);
+    other = (uint8_t *)replay_alloc(mode->key_size);
+    valid = (uint8_t *)replay_alloc(trace->keys);
+    message = (uint8_t *)replay_alloc(trace->max_length + REPLAY_OVERHEAD);
+    ciphertext = (uint8_t *)replay_alloc(trace->max_length + REPLAY_OVERHEAD);
+    output = (uint8_t *)replay_alloc(trace->max_length + REPLAY_OVERHEAD);
+    for (posn = 0; posn < trace->max_length; ++posn)
+        message[posn] = (uint8_t)(posn * 17 + 3);
+
+    for (pass = 0; pass < options->passes; ++pass) {
+        for (posn = 0; posn < trace->count; ++posn) {
+            const ReplayMessage_t *m = &trace->messages[posn];
+            if (m->length > mode->max_length) {
+                ++skipped;
+                continue;
+            }
+            memset(nonce, 0, sizeof(nonce));
+            for (byte = 0; byte < 8; ++byte)
+                nonce[byte] = (uint8_t)(sequence >> (8 * byte));
+            ++sequence;
+
+            if (m->decrypt) {
+                /* Untimed: the ciphertext to decrypt, under a key that is
+                   expanded outside of the key contexts */
+                replay_key(k, trace->ids[m->key]);
+                mode->init(other, k);
+                mode->encrypt(other, ciphertext, &clen, message, m->length, nonce);
+            }
+
+            start = replay_now();
+            if (options->single) {
+                key = keys;
+                if (current != m->key) {
+                    replay_key(k, trace->ids[m->key]);
+                    mode->init(key, k);
+                    current = m->key;
+                    ++inits;
+                }
+            } else {
+                key = keys + m->key * mode->key_size;
+                if (!valid[m->key]) {
+                    replay_key(k, trace->ids[m->key]);
+                    mode->init(key, k);
+                    valid[m->key] = 1;
+                    ++inits;
+                }
+            }
+            if (m->decrypt) {
+                if (mode->decrypt(key, output, &mlen, ciphertext, clen, nonce))
+                    ++failures;
+            } else {
+                mode->encrypt(key, output, &clen, message, m->length, nonce);
+            }
+            latencies[count] = replay_now() - start;
+            total += latencies[count++];
+            bytes += m->length;
+        }
+    }
+    if (failures)
+        replay_fail("a message did not decrypt");
+
+    if (options->csv) {
+        printf("%s,%lu,%lu,%llu,%lu,%.2f,%.0f", mode->name,
+               (unsigned long)count, (unsigned long)skipped,
+               (unsigned long long)bytes, (unsigned long)inits,
+               total ? (double)bytes * 1e3 / (double)total : 0.0,
+               total ? (double)count * 1e9 / (double)total : 0.0);
+    } else {
+        printf("%-24s %9lu %7lu %12llu %7lu %9.2f %10.0f", mode->name,
+               (unsigned long)count, (unsigned long)skipped,
+               (unsigned long long)bytes, (unsigned long)inits,
+               total ? (double)bytes * 1e3 / (double)total : 0.0,
+               total ? (double)count * 1e9 / (double)total : 0.0);
+    }
+    if (count) {
+        qsort(latencies, count, sizeof(uint64_t), replay_compare);
+        printf(options->csv ? ",%llu,%llu,%llu,%llu,%llu\n" : " %9llu %9llu %9llu %9llu %9llu\n",
+               (unsigned long long)replay_percentile(latencies, count, 0.5),
+               (unsigned long long)replay_percentile(latencies, count, 0.9),
+               (unsigned long long)replay_percentile(latencies, count, 0.99),
+               (unsigned long long)replay_percentile(latencies, count, 0.999),
+               (unsigned long long)latencies[count - 1]);
+    } else {
+        printf(options->csv ? ",,,,,\n" : "\n");
+    }
+    fflush(stdout);
+
+    free(keys);
+    free(other);
+    free(valid);
+    free(message);
+    free(ciphertext);
+    free(output);
+}
+
+/* Writes a synthetic trace of the traffic mix described above */
+static void replay_generate(unsigned long count, uint64_t seed)
+{
+    uint64_t x = seed * 0x9E3779B97F4A7C15ULL + 1;
+    unsigned long posn;
+    unsigned r, length;
+
+    printf("# length key direction\n");
+    for (posn = 0; posn < count; ++posn) {
+        x ^= x << 13;
+        x ^= x >> 7;
+        x ^= x << 17;
+        r = (unsigned)((x >> 32) % 100);
+        if (r < 60)
+            length = 40;
+        else if (r < 70)
+            length = 576;
+        else if (r < 90)
+            length = 1500;
+        else
+            length = 9000;
+        printf("%u %u %c\n", length, (unsigned)((x >> 8) & 15),
+               ((x >> 16) % 10) < 7 ? 'e' : 'd');
+    }
+}
+
+static void replay_usage(void)
+{
+    unsigned index;
+    fprintf(stderr, "usage: replay.x [-o text|csv] [-a mode]... [-s] "
+                    "[-r passes] [trace]\n"
+                    "       replay.x -G count [-S seed]\n"
+                    "modes:");
+    for (index = 0; index < REPLAY_MODES; ++index)
+        fprintf(stderr, " %s", replay_modes[index].name);
+    fprintf(stderr, "\n");
+    exit(2);
+}
+
+int main(int argc, char *argv[])
+{
+    ReplayOptions_t options;
+    ReplayTrace_t trace;
+    int selected[REPLAY_MODES];
+    int any = 0, opt;
+    unsigned long generate = 0;
+    uint64_t seed = 1;
+    uint64_t *latencies;
+    unsigned index;
+    size_t posn;
+    FILE *file = stdin;
+
+    options.csv = 0;
+    options.passes = 1;
+    options.single = 0;
+    memset(selected, 0, sizeof(selected));
+    while ((opt = getopt(argc, argv, "o:a:sr:G:S:")) != -1) {
+        switch (opt) {
+        case 'o':
+            if (strcmp(optarg, "csv") == 0)
+                options.csv = 1;
+            else if (strcmp(optarg, "text") != 0)
+                replay_usage();
+            break;
+        case 'a':
+            for (index = 0; index < REPLAY_MODES; ++index) {
+                if (strcmp(optarg, replay_modes[index].name) == 0)
+                    break;
+            }
+            if (index == REPLAY_MODES)
+                replay_usage();
+            selected[index] = any = 1;
+            break;
+        case 's': options.single = 1; break;
+        case 'r': options.passes = (unsigned)atoi(optarg); break;
+        case 'G': generate = strtoul(optarg, 0, 10); break;
+        case 'S': seed = strtoull(optarg, 0, 10); break;
+        default: replay_usage();
+        }
+    }
+    if (generate) {
+        replay_generate(generate, seed);
+        return 0;
+    }
+    if (argc - optind > 1 || options.passes < 1)
+        replay_usage();
+    if (optind < argc && strcmp(argv[optind], "-") != 0) {
+        file = fopen(argv[optind], "r");
+        if (!file) {
+            perror(argv[optind]);
+            return 1;
+        }
+    }
+    replay_read(&trace, file);
+    if (file != stdin)
+        fclose(file);
+
+    replay_tk1 = (uint8_t *)replay_alloc(trace.max_length + REPLAY_OVERHEAD);
+    for (posn = 0; posn + 4 <= trace.max_length + REPLAY_OVERHEAD; posn += 4) {
+        replay_tk1[posn] = (uint8_t)(posn >> 2);
+        replay_tk1[posn + 1] = (uint8_t)(posn >> 10);
+        replay_tk1[posn + 2] = (uint8_t)(posn >> 18);
+    }
+    latencies = (uint64_t *)replay_alloc(trace.count * options.passes * sizeof(uint64_t));
+
+    if (options.csv)
+        printf("mode,messages,skipped,bytes,key_inits,mb_per_s,messages_per_s,"
+               "ns_p50,ns_p90,ns_p99,ns_p999,ns_max\n");
+    else
+        printf("%lu messages, %lu keys, %s key context%s\n"
+               "%-24s %9s %7s %12s %7s %9s %10s %9s %9s %9s %9s %9s\n",
+               (unsigned long)trace.count, (unsigned long)trace.keys,
+               options.single ? "one" : "a",
+               options.single ? "" : " per key",
+               "mode", "messages", "skipped", "bytes", "inits", "MB/s",
+               "msgs/s", "p50 ns", "p90 ns", "p99 ns", "p99.9 ns", "max ns");
+    for (index = 0; index < REPLAY_MODES; ++index) {
+        if (!any || selected[index])
+            replay_mode(&replay_modes[index], &trace, &options, latencies);
+    }
+    return 0;
+}